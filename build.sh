@@ -10,11 +10,13 @@ workspace_dir="$(dirname "$script_dir")"
 board="nucleo_h755zi_q/stm32h755xx/m7"
 board_label="H7 (nucleo_h755zi_q/stm32h755xx/m7)"
 ota_build=1
+sim_build=0
 
 usage() {
-    echo "Usage: ./build.sh [--h7|--H7] [--ota|--OTA] [--no-ota|--NO-OTA]"
+    echo "Usage: ./build.sh [--h7|--H7] [--ota|--OTA] [--no-ota|--NO-OTA] [--sim]"
     echo "Defaults to the H7 OTA build."
     echo "Use --no-ota only for a plain non-MCUboot development build."
+    echo "Use --sim to build for native_sim against the peripheral emulators."
 }
 
 print_flash_guidance() {
@@ -37,6 +39,9 @@ while [[ $# -gt 0 ]]; do
         --no-ota|--NO-OTA)
             ota_build=0
             ;;
+        --sim|--SIM)
+            sim_build=1
+            ;;
         --f7|--F7)
             echo "F7 support has been sunset. Use the H7 target: ${board}" >&2
             exit 1
@@ -65,7 +70,13 @@ elif ! command -v west >/dev/null 2>&1; then
 fi
 
 cd "$script_dir" || exit 1
-if [[ "$ota_build" -eq 1 ]]; then
+if [[ "$sim_build" -eq 1 ]]; then
+    build_dir="build-sim"
+    echo "Building K2-Zephyr for native_sim (peripheral emulators)..."
+    west build -p -b native_sim/native/64 -d "$build_dir" "$script_dir"
+    echo "Simulator build complete."
+    echo "Run with: ${build_dir}/zephyr/zephyr.exe --stop_at=30"
+elif [[ "$ota_build" -eq 1 ]]; then
     build_dir="build-h755-ota"
     echo "Building K2-Zephyr OTA image for ${board_label}..."
     west build --sysbuild -p -b "$board" -d "$build_dir" "$script_dir" -- "-DEXTRA_CONF_FILE=ota.conf"
@@ -0,0 +1,34 @@
+/*
+ * Generation-counted config store — see config_gen.h
+ *
+ * atomic_get() is a full barrier, so the copy cannot move outside the
+ * two loads around it.  The writers are the UDP dispatcher, a
+ * cooperative thread that finishes a SET without yielding, so the retry
+ * only ever runs on SMP.
+ */
+
+#include <string.h>
+
+#include "config_gen.h"
+
+uint32_t config_gen_read(const atomic_t *seq, void *out, const void *src, size_t len)
+{
+    atomic_val_t s;
+
+    do {
+        s = atomic_get(seq);
+        memcpy(out, src, len);
+    } while ((s & 1) || atomic_get(seq) != s);
+
+    return (uint32_t)s;
+}
+
+bool config_gen_sync(const atomic_t *seq, uint32_t *gen, void *out,
+                     const void *src, size_t len)
+{
+    if ((uint32_t)atomic_get(seq) == *gen) {
+        return false;
+    }
+    *gen = config_gen_read(seq, out, src, len);
+    return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/atomic.h>
+
+/*
+ * Generation-counted config store, as used by pid_config.c and
+ * axis_config.c.
+ *
+ * A writer makes the sequence counter odd, writes the whole config, and
+ * makes it even again, so every even value names one complete version.
+ * Readers copy without a lock and retry if a write was in progress or
+ * landed during the copy.  Writers serialise among themselves on the
+ * store's own mutex.  A reader's generation starts at any odd value (the
+ * stores' *_GEN_NONE), which is never published, to get the first copy.
+ *
+ * Depends only on the atomic API, so tools/config_sync_bench.c runs this
+ * code on the host against a thin atomic shim.
+ */
+
+static inline void config_gen_write_begin(atomic_t *seq)
+{
+    atomic_inc(seq);
+}
+
+static inline void config_gen_write_end(atomic_t *seq)
+{
+    atomic_inc(seq);
+}
+
+/* Copy `len` bytes of `src` consistently into `out`; returns their generation */
+uint32_t config_gen_read(const atomic_t *seq, void *out, const void *src, size_t len);
+
+/*
+ * Copy as config_gen_read() if the generation moved from *gen, and
+ * update *gen.  Returns false without touching `out` otherwise, which
+ * costs one atomic load.
+ */
+bool config_gen_sync(const atomic_t *seq, uint32_t *gen, void *out,
+                     const void *src, size_t len);
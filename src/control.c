@@ -7,8 +7,13 @@
 #include "pid/pid_config.h"
 #include "imu/axis_config.h"
 #include "imu/vn100s.h"
+#include "depth/depth_sensor.h"
+#include "nav/velocity_estimator.h"
+#include "nav/lever_arm.h"
 #include "vesc/thruster_mapping.h"
 #include "vesc/vesc_uart_zephyr.h"
+#include "net/control_stream.h"
+#include "net/heartbeat.h"
 
 LOG_MODULE_REGISTER(rov_control, LOG_LEVEL_INF);
 
@@ -22,12 +27,12 @@ static const struct pwm_dt_spec manipulator_pwm = PWM_DT_SPEC_GET(DT_NODELABEL(r
  * --------------------------------------------------------------------------- */
 #define CONTROL_PERIOD_MS   20       /* 50 Hz control loop */
 #define CONTROL_DT          0.02f    /* seconds */
-#define COMMS_TIMEOUT_MS    2000     /* 2 s without UDP → kill thrusters */
 #define MAX_RATE_DPS        45.0f    /* max joystick rate command (deg/s) */
 #define MAX_SPEED_MPS       1.0f     /* max speed setpoint for surge/sway (m/s) */
 #define MAX_DEPTH_RATE_MPS  0.5f     /* max depth rate from joystick (m/s) */
 #define PID_OUTPUT_LIMIT    1.0f     /* PID output range ±1.0 (maps to ±50% via mixing) */
-#define SPEED_DECAY         0.995f   /* leaky integrator factor for accel→speed */
+#define DEPTH_STALE_MS      200      /* depth older than this → heave passthrough */
+#define ALPHA_FILTER_TAU    0.05f    /* angular-acceleration low-pass (s) */
 #define LOG_INTERVAL        50       /* log every 50 iterations = 1 s */
 
 #define MANIP_MIN_PULSE_US      1000U
@@ -42,7 +47,7 @@ static const struct pwm_dt_spec manipulator_pwm = PWM_DT_SPEC_GET(DT_NODELABEL(r
 K_THREAD_STACK_DEFINE(rov_control_stack, 4096);
 static struct k_thread rov_control_thread_data;
 
-K_MSGQ_DEFINE(rov_command_queue, sizeof(rov_command_t), 10, 4);
+K_MSGQ_DEFINE(rov_command_queue, sizeof(rov_command_t), 10, 8);
 
 /* ---------------------------------------------------------------------------
  * Pilot setpoints (raw joystick, written by UDP rx, read by control loop)
@@ -63,6 +68,17 @@ K_MUTEX_DEFINE(pilot_mutex);
 /* Timestamp of most recent command arrival (ms) */
 static int64_t last_cmd_time;
 
+/* Link-loss failsafe; starts stopped until the first command arrives */
+static struct failsafe fs = { .stage = FAILSAFE_STOPPED };
+
+static const char *const fs_stage_names[] = {
+    [FAILSAFE_NONE]     = "none",
+    [FAILSAFE_HOLD]     = "hold setpoint",
+    [FAILSAFE_ATTITUDE] = "hold attitude",
+    [FAILSAFE_RAMP]     = "ramp down",
+    [FAILSAFE_STOPPED]  = "thrusters stopped",
+};
+
 /* ---------------------------------------------------------------------------
  * PID controllers — one per DOF
  * --------------------------------------------------------------------------- */
@@ -71,10 +87,15 @@ static pid_controller_t pid[PID_AXIS_COUNT];
 /* Angle setpoints for roll / pitch / yaw (degrees, integrated from stick) */
 static float angle_setpoint[3];          /* [0]=roll [1]=pitch [2]=yaw */
 
-/* Estimated speed for surge / sway (m/s, integrated from accelerometer) */
+/* Estimated speed for surge / sway (m/s, accelerometer + thrust model) */
+static vel_est_t vel_est[2];
 static float est_speed[2];               /* [0]=surge(x) [1]=sway(y) */
+static float prev_speed_cmd[2];          /* last surge/sway DOF output sent */
+
+/* IMU lever-arm compensation (offset from axis config) */
+static lever_arm_t lever_arm;
 
-/* Depth setpoint (m, integrated from stick) — sensor stub for now */
+/* Depth setpoint (m, integrated from stick) */
 static float depth_setpoint;
 
 /* Control telemetry snapshot — written by control loop, read by sender thread */
@@ -127,76 +148,100 @@ static float manipulator_pulse_to_deg(uint16_t pulse_us)
            (MANIP_MAX_DEG / ((float)MANIP_MAX_PULSE_US - (float)MANIP_NEUTRAL_PULSE_US));
 }
 
-/* Read depth sensor — stub: returns 0 until real sensor is integrated */
-static float depth_sensor_read(void)
+/* Read the latest depth sample (non-blocking).  Returns false if the
+ * sensor has not published recently; *depth keeps the last good value. */
+static bool depth_sensor_read(float *depth)
 {
-    return 0.0f;
+    static bool was_valid;
+    depth_sample_t s;
+
+    bool valid = depth_sensor_get(&s) &&
+                 (k_uptime_get() - s.timestamp_ms) <= DEPTH_STALE_MS;
+    if (valid) {
+        *depth = s.depth_m;
+    }
+
+    if (valid != was_valid) {
+        was_valid = valid;
+        if (valid) {
+            LOG_INF("Depth sensor online");
+        } else {
+            LOG_WRN("Depth sensor stale — heave in passthrough");
+        }
+    }
+    return valid;
 }
 
 /* ---------------------------------------------------------------------------
- * Sync PID gains from the UDP-configurable store
+ * Sync PID gains and axis config from the UDP-configurable stores
+ *
+ * Both stores publish a generation; in the steady state each sync is one
+ * atomic load, and the copy plus derived values (PID gains, lever arm)
+ * are only redone after topside changed something.
  * --------------------------------------------------------------------------- */
+static uint32_t pid_gains_gen = PID_CONFIG_GEN_NONE;
+static uint32_t axis_cfg_gen  = AXIS_CONFIG_GEN_NONE;
+static axis_config_t axis_cfg;
+
 static void sync_pid_gains(void)
 {
+    pid_gains_t g[PID_AXIS_COUNT];
+
+    if (!pid_config_sync(&pid_gains_gen, g)) {
+        return;
+    }
     for (int i = 0; i < PID_AXIS_COUNT; i++) {
-        pid_gains_t g = pid_config_get_gains((enum pid_axis)i);
-        pid_set_gains(&pid[i], g.kp, g.ki, g.kd);
+        pid_set_gains(&pid[i], g[i].kp, g[i].ki, g[i].kd);
+    }
+}
+
+static void sync_axis_config(void)
+{
+    if (axis_config_sync(&axis_cfg_gen, &axis_cfg)) {
+        lever_arm_set_offset(&lever_arm, &axis_cfg.offset);
     }
 }
 
 /* ---------------------------------------------------------------------------
  * Core stabilisation step — called every CONTROL_DT
  *
- * Produces 6 float outputs in [-1, +1] for the mixing matrix.
+ * Produces 6 float outputs in [-1, +1] for the mixing matrix, and the
+ * per-axis setpoint and error for telemetry alongside each PID call.
  * --------------------------------------------------------------------------- */
-static void stabilise(float out[6])
+static void stabilise(float out[6], float sp_snap[6], float err_snap[6])
 {
-    /* Per-axis snapshots for telemetry (populated alongside each PID call) */
-    float sp_snap[6] = {0};
-    float err_snap[6] = {0};
-
     /* ---- Read sensors ---- */
-    float raw_yaw, raw_pitch, raw_roll;
-    vn100s_get_ypr(&raw_yaw, &raw_pitch, &raw_roll);
+    sync_axis_config();
+
+    float raw_ypr[3];
+    vn100s_get_ypr(&raw_ypr[0], &raw_ypr[1], &raw_ypr[2]);
 
     /* Apply axis remapping (configured from topside) so PID sees the
      * correct orientation even if the IMU is mounted non-standard. */
-    float yaw_meas, pitch_meas, roll_meas;
-    axis_config_remap_ypr(raw_yaw, raw_pitch, raw_roll,
-                          &yaw_meas, &pitch_meas, &roll_meas);
-
-    float raw_ax, raw_ay, raw_az;
-    vn100s_get_accel(&raw_ax, &raw_ay, &raw_az);
-
-    /* Apply accelerometer axis remapping */
-    float ax, ay, az;
-    axis_config_remap_accel(raw_ax, raw_ay, raw_az, &ax, &ay, &az);
-
-    /* Compensate for centripetal acceleration due to IMU offset from
-     * center of mass.  When the ROV rotates, an off-center IMU sees
-     * centripetal accel a_c = omega^2 * r.  We subtract it so the
-     * PID's speed estimate reflects true translational motion. */
-    imu_offset_t off = axis_config_get_offset();
-    if (off.x != 0.0f || off.y != 0.0f || off.z != 0.0f) {
-        float yr_rad, pr_rad, rr_rad;
-        vn100s_get_rates(&yr_rad, &pr_rad, &rr_rad);
-        /* Convert deg/s to rad/s */
-        const float DEG2RAD = 0.017453293f;
-        yr_rad *= DEG2RAD;
-        pr_rad *= DEG2RAD;
-        rr_rad *= DEG2RAD;
-        /* Offset in metres (stored as mm) */
-        float rx = off.x * 0.001f;
-        float ry = off.y * 0.001f;
-        float rz = off.z * 0.001f;
-        /* Centripetal: a_centripetal = omega x (omega x r)
-         * Simplified per-axis dominant terms: */
-        ax -= (pr_rad * pr_rad + yr_rad * yr_rad) * rx;
-        ay -= (rr_rad * rr_rad + yr_rad * yr_rad) * ry;
-        az -= (rr_rad * rr_rad + pr_rad * pr_rad) * rz;
-    }
+    float ypr_meas[3];
+    axis_config_attitude(&axis_cfg, raw_ypr, ypr_meas);
+    float yaw_meas = ypr_meas[0], pitch_meas = ypr_meas[1], roll_meas = ypr_meas[2];
+
+    float raw_accel[3];
+    vn100s_get_accel(&raw_accel[0], &raw_accel[1], &raw_accel[2]);
+
+    /* Apply accelerometer axis remapping and mounting rotation */
+    float accel[3];
+    axis_config_vector(&axis_cfg, raw_accel, accel);
 
-    float depth_meas = depth_sensor_read();
+    /* Gyro rates as sensor x/y/z, into the body frame like accel */
+    float raw_rates[3], rates[3];
+    vn100s_get_rates(&raw_rates[2], &raw_rates[1], &raw_rates[0]);
+    axis_config_vector(&axis_cfg, raw_rates, rates);
+
+    /* Remove the centripetal and tangential acceleration an off-centre
+     * IMU sees when the ROV rotates, so the speed estimate reflects true
+     * translational motion of the centre of mass.  The offset itself is
+     * applied in sync_axis_config() when it changes. */
+    lever_arm_compensate(&lever_arm, rates, CONTROL_DT, accel);
+
+    static float depth_meas;
+    bool depth_valid = depth_sensor_read(&depth_meas);
 
     /* ---- Grab pilot stick snapshot ---- */
     int8_t p_surge, p_sway, p_heave, p_roll, p_pitch, p_yaw;
@@ -287,17 +332,18 @@ static void stabilise(float out[6])
     }
 
     /* ================================================================
-     *  SURGE / SWAY  —  speed-tracking PID (accelerometer integration)
+     *  SURGE / SWAY  —  speed-tracking PID
      *
-     *  Leaky-integrate accel → estimated speed
+     *  Fuse accel + last thrust command → estimated speed
      *  Stick → speed setpoint
      *  PID(speed_error) → output
      *  Bypass if gains == 0: passthrough raw stick
      * ================================================================ */
 
-    /* Update estimated speeds (leaky integrator to limit drift) */
-    est_speed[0] = est_speed[0] * SPEED_DECAY + ax * CONTROL_DT;
-    est_speed[1] = est_speed[1] * SPEED_DECAY + ay * CONTROL_DT;
+    /* Update estimated speeds.  The estimator runs in passthrough too, so
+     * the PID starts from a valid speed when it is enabled. */
+    est_speed[0] = vel_est_step(&vel_est[0], accel[0], prev_speed_cmd[0], CONTROL_DT);
+    est_speed[1] = vel_est_step(&vel_est[1], accel[1], prev_speed_cmd[1], CONTROL_DT);
 
     /* Surge */
     if (ovr_mask & (1 << PID_SURGE)) {
@@ -306,7 +352,6 @@ static void stabilise(float out[6])
         sp_snap[0] = sp;  err_snap[0] = sp - est_speed[0];
     } else if (pid_is_disabled(&pid[PID_SURGE])) {
         out[0] = stick_normalize(p_surge);
-        est_speed[0] = 0.0f;
         pid_reset(&pid[PID_SURGE]);
         sp_snap[0] = out[0];  err_snap[0] = 0.0f;
     } else {
@@ -322,7 +367,6 @@ static void stabilise(float out[6])
         sp_snap[1] = sp;  err_snap[1] = sp - est_speed[1];
     } else if (pid_is_disabled(&pid[PID_SWAY])) {
         out[1] = stick_normalize(p_sway);
-        est_speed[1] = 0.0f;
         pid_reset(&pid[PID_SWAY]);
         sp_snap[1] = out[1];  err_snap[1] = 0.0f;
     } else {
@@ -332,19 +376,19 @@ static void stabilise(float out[6])
     }
 
     /* ================================================================
-     *  HEAVE  —  depth-tracking PID (stub sensor for now)
+     *  HEAVE  —  depth-tracking PID
      *
      *  Stick → depth rate → integrate → depth setpoint
      *  PID(depth_error) → output
-     *  Bypass if gains == 0: passthrough raw stick
+     *  Bypass if gains == 0 or no fresh depth: passthrough raw stick
      * ================================================================ */
 
     /* Heave — negate measurement: positive depth = deeper, thruster positive = up */
-    if (ovr_mask & (1 << PID_HEAVE)) {
+    if ((ovr_mask & (1 << PID_HEAVE)) && depth_valid) {
         depth_setpoint = ovr_sp[PID_HEAVE];
         out[2] = pid_compute(&pid[PID_HEAVE], depth_setpoint, -depth_meas, CONTROL_DT);
         sp_snap[2] = depth_setpoint;  err_snap[2] = depth_setpoint - (-depth_meas);
-    } else if (pid_is_disabled(&pid[PID_HEAVE])) {
+    } else if (pid_is_disabled(&pid[PID_HEAVE]) || !depth_valid) {
         out[2] = stick_normalize(p_heave);
         depth_setpoint = -depth_meas;
         pid_reset(&pid[PID_HEAVE]);
@@ -354,13 +398,56 @@ static void stabilise(float out[6])
         out[2] = pid_compute(&pid[PID_HEAVE], depth_setpoint, -depth_meas, CONTROL_DT);
         sp_snap[2] = depth_setpoint;  err_snap[2] = depth_setpoint - (-depth_meas);
     }
+}
+
+/* ---------------------------------------------------------------------------
+ * Link supervision and staged failsafe (stage logic in failsafe.c)
+ * --------------------------------------------------------------------------- */
+static void failsafe_step(int64_t now)
+{
+    bool ok = failsafe_link_ok(now, last_cmd_time, heartbeat_age_ms(),
+                               heartbeat_timeout_ms());
+    enum failsafe_stage prev = failsafe_update(&fs, ok, now);
+
+    if (fs.stage == prev) {
+        return;
+    }
 
-    /* Publish telemetry snapshot */
     k_mutex_lock(&ctrl_telem_mutex, K_FOREVER);
-    memcpy(ctrl_telem.setpoint, sp_snap, sizeof(sp_snap));
-    memcpy(ctrl_telem.output, out, sizeof(ctrl_telem.output));
-    memcpy(ctrl_telem.error, err_snap, sizeof(err_snap));
+    ctrl_telem.failsafe_stage    = (uint8_t)fs.stage;
+    ctrl_telem.failsafe_since_us = fs.since_ms * 1000;
     k_mutex_unlock(&ctrl_telem_mutex);
+
+    if (prev < FAILSAFE_ATTITUDE && fs.stage >= FAILSAFE_ATTITUDE) {
+        /* Zero rates and translation; the angle setpoints stay put, so
+         * the PIDs hold the attitude the ROV had when the sticks froze. */
+        k_mutex_lock(&pilot_mutex, K_FOREVER);
+        pilot.surge = pilot.sway = pilot.heave = 0;
+        pilot.roll = pilot.pitch = pilot.yaw = 0;
+        pilot.manipulator = 0;
+        k_mutex_unlock(&pilot_mutex);
+        control_clear_override();
+    }
+
+    if (fs.stage == FAILSAFE_NONE) {
+        LOG_INF("Link restored");
+    } else {
+        LOG_WRN("Link lost — failsafe: %s", fs_stage_names[fs.stage]);
+    }
+}
+
+static void pilot_apply(const rov_command_t *command)
+{
+    k_mutex_lock(&pilot_mutex, K_FOREVER);
+    pilot.surge       = command->surge;
+    pilot.sway        = command->sway;
+    pilot.heave       = command->heave;
+    pilot.roll        = command->roll;
+    pilot.pitch       = command->pitch;
+    pilot.yaw         = command->yaw;
+    pilot.light       = command->light;
+    pilot.manipulator = command->manipulator;
+    k_mutex_unlock(&pilot_mutex);
 }
 
 /* ---------------------------------------------------------------------------
@@ -417,6 +504,8 @@ static void rov_control_thread(void *arg1, void *arg2, void *arg3)
     ARG_UNUSED(arg3);
 
     rov_command_t command;
+    rov_command_t echo;
+    bool echo_pending = false;
     int64_t next_send_time = k_uptime_get();
     int log_counter = 0;
 
@@ -424,42 +513,62 @@ static void rov_control_thread(void *arg1, void *arg2, void *arg3)
 
     while (1) {
         /* --- Dequeue new pilot commands (non-blocking) --- */
+        bool cmd_new = false;
         while (k_msgq_get(&rov_command_queue, &command, K_NO_WAIT) == 0) {
-            k_mutex_lock(&pilot_mutex, K_FOREVER);
-            pilot.surge       = command.surge;
-            pilot.sway        = command.sway;
-            pilot.heave       = command.heave;
-            pilot.roll        = command.roll;
-            pilot.pitch       = command.pitch;
-            pilot.yaw         = command.yaw;
-            pilot.light       = command.light;
-            pilot.manipulator = command.manipulator;
-            k_mutex_unlock(&pilot_mutex);
-
             last_cmd_time = k_uptime_get();
+            cmd_new = true;
         }
 
-        /* --- Comms timeout check --- */
+        /* --- Link supervision --- */
         int64_t now = k_uptime_get();
-        static bool timed_out;
-        if ((now - last_cmd_time) > COMMS_TIMEOUT_MS) {
+        failsafe_step(now);
+
+        /* The newest command steers only with the link up.  In a failsafe
+         * stage the sticks stay where the stage put them, even while
+         * commands keep arriving with the heartbeat lost. */
+        if (cmd_new && failsafe_pilot_live(&fs)) {
+            pilot_apply(&command);
+            echo = command;
+            echo_pending = true;
+        }
+
+        if (fs.stage == FAILSAFE_STOPPED) {
             static const float zeros[6] = {0};
             thruster_output_t output;
             thruster_calculate_6dof(zeros, &output);
             thruster_send_outputs(&output);
             rov_set_manipulator(0);
-            if (!timed_out) {
-                timed_out = true;
-                LOG_WRN("Comms timeout — thrusters killed");
+            /* The estimator is not stepped while killed; the ROV coasts
+             * to rest, so restart it from zero with no thrust. */
+            for (int i = 0; i < 2; i++) {
+                vel_est_reset(&vel_est[i]);
+                est_speed[i] = 0.0f;
+                prev_speed_cmd[i] = 0.0f;
             }
         } else {
-            if (timed_out) {
-                timed_out = false;
-                LOG_INF("Comms restored");
-            }
             /* --- Run stabilisation and send to thrusters --- */
             float dof_out[6];
-            stabilise(dof_out);
+            float sp_snap[6] = {0};
+            float err_snap[6] = {0};
+            stabilise(dof_out, sp_snap, err_snap);
+
+            float scale = failsafe_output_scale(&fs, now);
+            for (int i = 0; i < 6; i++) {
+                dof_out[i] *= scale;
+            }
+
+            /* Publish what the thrusters get, failsafe ramp included */
+            k_mutex_lock(&ctrl_telem_mutex, K_FOREVER);
+            memcpy(ctrl_telem.setpoint, sp_snap, sizeof(sp_snap));
+            memcpy(ctrl_telem.output, dof_out, sizeof(ctrl_telem.output));
+            memcpy(ctrl_telem.error, err_snap, sizeof(err_snap));
+            control_stream_push(&ctrl_telem);
+            k_mutex_unlock(&ctrl_telem_mutex);
+
+            /* The estimator's thrust feed-forward models what the
+             * thrusters receive, failsafe ramp included */
+            prev_speed_cmd[0] = dof_out[0];
+            prev_speed_cmd[1] = dof_out[1];
 
             /* --- Periodic PID debug logging (every 500 ms) --- */
             if (++log_counter >= LOG_INTERVAL) {
@@ -500,6 +609,17 @@ static void rov_control_thread(void *arg1, void *arg2, void *arg3)
             thruster_calculate_6dof(dof_out, &output);
             thruster_send_outputs(&output);
 
+            /* Echo the newest command now that its outputs are applied */
+            if (echo_pending) {
+                echo_pending = false;
+                k_mutex_lock(&ctrl_telem_mutex, K_FOREVER);
+                ctrl_telem.cmd_sequence   = echo.sequence;
+                ctrl_telem.cmd_topside_us = echo.topside_us;
+                ctrl_telem.cmd_rx_us      = echo.rx_us;
+                ctrl_telem.cmd_apply_us   = control_uptime_us();
+                k_mutex_unlock(&ctrl_telem_mutex);
+            }
+
             /* Peripherals */
             k_mutex_lock(&pilot_mutex, K_FOREVER);
             /* Always update the light so brightness 0 turns the LEDs off. */
@@ -545,9 +665,13 @@ void rov_control_init(void)
         }
     }
 
+    failsafe_init(&fs, CONFIG_K2_FAILSAFE_HOLD_MS, CONFIG_K2_FAILSAFE_ATTITUDE_MS,
+                  CONFIG_K2_FAILSAFE_RAMP_MS);
+
     k_mutex_lock(&ctrl_telem_mutex, K_FOREVER);
     ctrl_telem.manipulator_deg = 0.0f;
     ctrl_telem.manipulator_pulse_us = MANIP_NEUTRAL_PULSE_US;
+    ctrl_telem.failsafe_stage = FAILSAFE_STOPPED;
     k_mutex_unlock(&ctrl_telem_mutex);
 
     /* Initialize all PID controllers (gains start at 0 → bypass mode) */
@@ -557,7 +681,13 @@ void rov_control_init(void)
 
     /* Zero state */
     for (int i = 0; i < 3; i++) angle_setpoint[i] = 0.0f;
-    for (int i = 0; i < 2; i++) est_speed[i] = 0.0f;
+    const vel_est_params_t vel_params = VEL_EST_DEFAULT_PARAMS;
+    for (int i = 0; i < 2; i++) {
+        vel_est_init(&vel_est[i], &vel_params);
+        est_speed[i] = 0.0f;
+        prev_speed_cmd[i] = 0.0f;
+    }
+    lever_arm_init(&lever_arm, ALPHA_FILTER_TAU);
     depth_setpoint = 0.0f;
     last_cmd_time = 0;
 
@@ -579,6 +709,15 @@ void rov_control_start(void)
     }
 }
 
+enum failsafe_stage control_get_failsafe(int64_t *since_us)
+{
+    k_mutex_lock(&ctrl_telem_mutex, K_FOREVER);
+    enum failsafe_stage stage = (enum failsafe_stage)ctrl_telem.failsafe_stage;
+    *since_us = ctrl_telem.failsafe_since_us;
+    k_mutex_unlock(&ctrl_telem_mutex);
+    return stage;
+}
+
 void control_get_telemetry(control_telemetry_t *out)
 {
     k_mutex_lock(&ctrl_telem_mutex, K_FOREVER);
@@ -603,11 +742,18 @@ void control_clear_override(void)
     LOG_INF("Setpoint override cleared");
 }
 
-void rov_send_command(uint32_t sequence, uint64_t payload)
+int64_t control_uptime_us(void)
+{
+    return (int64_t)k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+void rov_send_command(uint32_t sequence, uint64_t payload, uint64_t topside_us)
 {
     rov_command_t command;
 
     command.sequence    = sequence;
+    command.topside_us  = topside_us;
+    command.rx_us       = control_uptime_us();
     command.surge       = (int8_t)((payload >> 0)  & 0xFF) - 128;
     command.sway        = (int8_t)((payload >> 8)  & 0xFF) - 128;
     command.heave       = (int8_t)((payload >> 16) & 0xFF) - 128;
@@ -623,7 +769,25 @@ void rov_send_command(uint32_t sequence, uint64_t payload)
         LOG_INF("First command received from topside (seq #%u)", sequence);
     }
 
-    if (k_msgq_put(&rov_command_queue, &command, K_NO_WAIT) != 0) {
-        LOG_WRN("ROV command queue full! Command #%u dropped", sequence);
+    /*
+     * The loop acts on the newest command only, so on overflow the oldest
+     * queued one makes room.  Above ~10 commands per cycle this runs on
+     * every frame; drops are summed into one line a second rather than
+     * logged per frame.
+     */
+    static uint32_t overflows;
+    static int64_t overflow_report_ms;
+
+    while (k_msgq_put(&rov_command_queue, &command, K_NO_WAIT) != 0) {
+        rov_command_t stale;
+
+        (void)k_msgq_get(&rov_command_queue, &stale, K_NO_WAIT);
+        overflows++;
+    }
+    if (overflows && k_uptime_get() >= overflow_report_ms) {
+        LOG_WRN("ROV command queue full: %u older commands dropped (last #%u kept)",
+                overflows, sequence);
+        overflows = 0;
+        overflow_report_ms = k_uptime_get() + 1000;
     }
 }
@@ -3,6 +3,8 @@
 #include <zephyr/kernel.h>
 #include <stdint.h>
 
+#include "failsafe.h"
+
 /* Message structure for communication between threads */
 typedef struct {
     uint32_t sequence;
@@ -14,6 +16,8 @@ typedef struct {
     int8_t yaw;          /* Yaw rotation (-128 to +127) */
     uint8_t light;       /* Light brightness (0-255) */
     int8_t manipulator;  /* Manipulator setpoint (-128 to +127) */
+    uint64_t topside_us; /* Topside send timestamp (v2 frames), 0 if unknown */
+    int64_t rx_us;       /* MCU uptime (us) when the frame was received */
 } rov_command_t;
 
 /* Snapshot of control loop state for topside telemetry.
@@ -24,16 +28,31 @@ typedef struct {
     float error[6];     /* setpoint - measurement (0 when passthrough) */
     float manipulator_deg;
     uint16_t manipulator_pulse_us;
+    /* Echo of the last command whose outputs reached the thrusters */
+    uint32_t cmd_sequence;
+    uint64_t cmd_topside_us;   /* its topside timestamp, 0 for v1 frames */
+    int64_t  cmd_rx_us;        /* MCU uptime (us) when it was received */
+    int64_t  cmd_apply_us;     /* MCU uptime (us) when its outputs were sent */
+    uint8_t  failsafe_stage;   /* enum failsafe_stage */
+    int64_t  failsafe_since_us; /* MCU uptime (us) when it was entered */
 } control_telemetry_t;
 
 /* Public functions */
 void rov_control_init(void);
 void rov_control_start(void);
-void rov_send_command(uint32_t sequence, uint64_t payload);
+/* Queue a pilot command for the control loop.  topside_us is the v2
+ * frame's send timestamp (0 for v1) and is echoed in control telemetry. */
+void rov_send_command(uint32_t sequence, uint64_t payload, uint64_t topside_us);
 
 /* Copy the latest control telemetry snapshot (thread-safe) */
 void control_get_telemetry(control_telemetry_t *out);
 
+/* Current failsafe stage and the MCU uptime (us) it was entered at */
+enum failsafe_stage control_get_failsafe(int64_t *since_us);
+
+/* MCU uptime in microseconds (timebase of the command echo fields) */
+int64_t control_uptime_us(void);
+
 /* Manual setpoint override from topside (for testing/debugging).
  * axis_mask: bitmask of axes to override (bit 0=surge … bit 5=yaw).
  * setpoints: target value per axis (only bits set in mask are used).
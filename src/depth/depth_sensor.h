@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* One compensated depth reading */
+typedef struct {
+    float    depth_m;        /* metres below the surface reference, positive down */
+    float    pressure_mbar;  /* absolute pressure */
+    float    temp_c;         /* sensor temperature */
+    int64_t  timestamp_ms;   /* k_uptime_get() when the pressure conversion finished */
+    uint32_t count;          /* number of samples published since boot */
+} depth_sample_t;
+
+#ifdef CONFIG_K2_DEPTH
+/*
+ * Copy the latest published sample.  Lock-free and wait-free for the
+ * writer; never touches the I2C bus, so it is safe from the control loop.
+ * Returns false if no valid sample has been published yet.
+ */
+bool depth_sensor_get(depth_sample_t *out);
+#else
+static inline bool depth_sensor_get(depth_sample_t *out)
+{
+    (void)out;
+    return false;
+}
+#endif
+
+#ifdef CONFIG_K2_EMUL
+/* native_sim emulator controls (ms5837_emul.c) */
+
+/* Set the simulated depth (m) and water temperature (degC) */
+void ms5837_emul_set_depth(float depth_m, float temp_c);
+
+/* Make the emulated part NACK every transfer while true */
+void ms5837_emul_set_nack(bool nack);
+#endif
@@ -0,0 +1,333 @@
+/*
+ * MS5837-30BA depth sensor driver.
+ *
+ * The part needs a separate ADC conversion for pressure (D1) and
+ * temperature (D2), each taking up to 18 ms at the highest oversampling
+ * ratio.  All bus traffic and conversion waits happen in this module's
+ * own thread; the control loop only ever reads the latest published
+ * sample through depth_sensor_get(), which never blocks.
+ *
+ * Schedule: one pressure conversion per CONFIG_K2_DEPTH_PERIOD_MS and a
+ * temperature conversion every DEPTH_TEMP_EVERY_N pressure samples
+ * (water temperature changes on a scale of minutes, not milliseconds).
+ *
+ * Depth is relative to the pressure averaged over the first
+ * DEPTH_TARE_SAMPLES readings after init, so the ROV must be powered up
+ * at the surface.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/barrier.h>
+#include <string.h>
+
+#include "depth_sensor.h"
+
+LOG_MODULE_REGISTER(ms5837, LOG_LEVEL_INF);
+
+#define DEPTH_NODE DT_ALIAS(depth_sensor)
+
+BUILD_ASSERT(DT_NODE_HAS_STATUS(DEPTH_NODE, okay),
+             "depth-sensor node not okay in DT");
+
+static const struct i2c_dt_spec depth_i2c = I2C_DT_SPEC_GET(DEPTH_NODE);
+
+#define MS5837_OSR          DT_PROP(DEPTH_NODE, oversampling)
+#define MS5837_DENSITY      DT_PROP(DEPTH_NODE, fluid_density)
+
+/* Commands */
+#define MS5837_CMD_RESET    0x1E
+#define MS5837_CMD_ADC_READ 0x00
+#define MS5837_CMD_PROM     0xA0   /* + 2 * word index */
+#define MS5837_CMD_CONV_D1  0x40   /* + 2 * osr index */
+#define MS5837_CMD_CONV_D2  0x50   /* + 2 * osr index */
+
+#define MS5837_PROM_WORDS   7
+#define GRAVITY_MPS2        9.80665f
+
+#define DEPTH_TEMP_EVERY_N  10
+#define DEPTH_TARE_SAMPLES  16
+#define DEPTH_MAX_ERRORS    5
+#define DEPTH_INIT_RETRY_MS 10000
+#define DEPTH_STACK_SIZE    1024
+#define DEPTH_PRIORITY      7
+
+/* Worst-case conversion time (us) per OSR index 256..8192 */
+static const uint16_t conv_time_us[] = { 600, 1170, 2280, 4540, 9040, 18080 };
+
+static uint16_t prom[MS5837_PROM_WORDS];
+static uint8_t osr_idx;
+
+/* ---------------------------------------------------------------------------
+ * Latest-value cell
+ *
+ * Two slots and a publish counter.  The writer fills the slot that is not
+ * currently published, then bumps the counter.  A reader copies the slot
+ * selected by the counter and retries if the counter moved at all during
+ * the copy: the publish after next rewrites the reader's slot before it
+ * bumps the counter, so a single step is already enough to tear the copy.
+ * Publishes come at the conversion rate, so a retry is rare and the loop
+ * ends whatever the reader's priority.
+ * --------------------------------------------------------------------------- */
+static depth_sample_t cell_slot[2];
+static atomic_t cell_gen = ATOMIC_INIT(0);
+
+static void cell_publish(const depth_sample_t *s)
+{
+    atomic_val_t next = atomic_get(&cell_gen) + 1;
+
+    cell_slot[next & 1] = *s;
+    barrier_dmem_fence_full();
+    atomic_set(&cell_gen, next);
+}
+
+bool depth_sensor_get(depth_sample_t *out)
+{
+    atomic_val_t gen, after;
+
+    do {
+        gen = atomic_get(&cell_gen);
+        *out = cell_slot[gen & 1];
+        barrier_dmem_fence_full();
+        after = atomic_get(&cell_gen);
+    } while (after != gen);
+
+    return gen != 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * Bus helpers
+ * --------------------------------------------------------------------------- */
+static int ms5837_cmd(uint8_t cmd)
+{
+    return i2c_write_dt(&depth_i2c, &cmd, 1);
+}
+
+static int ms5837_read_prom(void)
+{
+    for (int i = 0; i < MS5837_PROM_WORDS; i++) {
+        uint8_t cmd = MS5837_CMD_PROM + 2 * i;
+        uint8_t buf[2];
+
+        int err = i2c_write_read_dt(&depth_i2c, &cmd, 1, buf, sizeof(buf));
+        if (err) {
+            return err;
+        }
+        prom[i] = ((uint16_t)buf[0] << 8) | buf[1];
+    }
+    return 0;
+}
+
+/* CRC4 from the MS5837 datasheet; stored in bits 15:12 of PROM word 0 */
+static uint8_t ms5837_crc4(const uint16_t words[MS5837_PROM_WORDS])
+{
+    uint16_t n_prom[8];
+    uint16_t n_rem = 0;
+
+    memcpy(n_prom, words, MS5837_PROM_WORDS * sizeof(uint16_t));
+    n_prom[0] &= 0x0FFF;
+    n_prom[7] = 0;
+
+    for (int cnt = 0; cnt < 16; cnt++) {
+        if (cnt & 1) {
+            n_rem ^= n_prom[cnt >> 1] & 0x00FF;
+        } else {
+            n_rem ^= n_prom[cnt >> 1] >> 8;
+        }
+        for (int bit = 8; bit > 0; bit--) {
+            if (n_rem & 0x8000) {
+                n_rem = (n_rem << 1) ^ 0x3000;
+            } else {
+                n_rem <<= 1;
+            }
+        }
+    }
+    return (n_rem >> 12) & 0x000F;
+}
+
+/* Start a conversion, sleep through it, then read the 24-bit result */
+static int ms5837_convert(uint8_t base_cmd, uint32_t *out)
+{
+    int err = ms5837_cmd(base_cmd + 2 * osr_idx);
+    if (err) {
+        return err;
+    }
+
+    k_usleep(conv_time_us[osr_idx] + 200);
+
+    uint8_t cmd = MS5837_CMD_ADC_READ;
+    uint8_t buf[3];
+    err = i2c_write_read_dt(&depth_i2c, &cmd, 1, buf, sizeof(buf));
+    if (err) {
+        return err;
+    }
+
+    *out = ((uint32_t)buf[0] << 16) | ((uint32_t)buf[1] << 8) | buf[2];
+
+    /* A read before the conversion finished returns 0 */
+    return (*out == 0) ? -EIO : 0;
+}
+
+/*
+ * First- and second-order compensation (MS5837-30BA datasheet).
+ * Outputs pressure in mbar and temperature in degC.
+ */
+static void ms5837_compensate(uint32_t d1, uint32_t d2,
+                              float *pressure_mbar, float *temp_c)
+{
+    int64_t dt   = (int64_t)d2 - ((int64_t)prom[5] << 8);
+    int64_t temp = 2000 + ((dt * prom[6]) >> 23);
+    int64_t off  = ((int64_t)prom[2] << 16) + (((int64_t)prom[4] * dt) >> 7);
+    int64_t sens = ((int64_t)prom[1] << 15) + (((int64_t)prom[3] * dt) >> 8);
+
+    int64_t ti, offi, sensi;
+    if (temp < 2000) {
+        int64_t t2 = (temp - 2000) * (temp - 2000);
+        ti    = (3 * dt * dt) >> 33;
+        offi  = (3 * t2) >> 1;
+        sensi = (5 * t2) >> 3;
+        if (temp < -1500) {
+            int64_t t3 = (temp + 1500) * (temp + 1500);
+            offi  += 7 * t3;
+            sensi += 4 * t3;
+        }
+    } else {
+        ti    = (2 * dt * dt) >> 37;
+        offi  = ((temp - 2000) * (temp - 2000)) >> 4;
+        sensi = 0;
+    }
+
+    off  -= offi;
+    sens -= sensi;
+    temp -= ti;
+
+    int64_t p = ((((int64_t)d1 * sens) >> 21) - off) >> 13;   /* 0.1 mbar */
+
+    *pressure_mbar = (float)p / 10.0f;
+    *temp_c        = (float)temp / 100.0f;
+}
+
+static int ms5837_init(void)
+{
+    if (!i2c_is_ready_dt(&depth_i2c)) {
+        LOG_ERR("Depth sensor I2C bus not ready");
+        return -ENODEV;
+    }
+
+    int err = ms5837_cmd(MS5837_CMD_RESET);
+    if (err) {
+        LOG_ERR("MS5837 reset failed: %d", err);
+        return err;
+    }
+    k_msleep(10);
+
+    err = ms5837_read_prom();
+    if (err) {
+        LOG_ERR("MS5837 PROM read failed: %d", err);
+        return err;
+    }
+
+    uint8_t crc = ms5837_crc4(prom);
+    if (crc != (prom[0] >> 12)) {
+        LOG_ERR("MS5837 PROM CRC mismatch (calc 0x%X, stored 0x%X)",
+                crc, prom[0] >> 12);
+        return -EIO;
+    }
+
+    LOG_INF("MS5837 ready (OSR %d, density %d kg/m3)",
+            MS5837_OSR, MS5837_DENSITY);
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * Thread
+ * --------------------------------------------------------------------------- */
+static void depth_task(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while ((256 << osr_idx) < MS5837_OSR) {
+        osr_idx++;
+    }
+
+    const float mbar_per_m = (float)MS5837_DENSITY * GRAVITY_MPS2 / 100.0f;
+
+    bool initialized = false;
+    int errors = 0;
+    int temp_countdown = 0;
+    uint32_t d2 = 0;
+    float surface_sum = 0.0f;
+    int tare_count = 0;
+    float surface_mbar = 0.0f;
+    uint32_t published = 0;
+    int64_t next_time = k_uptime_get();
+
+    while (1) {
+        if (!initialized) {
+            if (ms5837_init() != 0) {
+                LOG_ERR("MS5837 init failed; retrying in %d s",
+                        DEPTH_INIT_RETRY_MS / 1000);
+                k_msleep(DEPTH_INIT_RETRY_MS);
+                continue;
+            }
+            initialized = true;
+            errors = 0;
+            temp_countdown = 0;
+            next_time = k_uptime_get();
+        }
+
+        int err = 0;
+        if (temp_countdown == 0) {
+            err = ms5837_convert(MS5837_CMD_CONV_D2, &d2);
+            temp_countdown = DEPTH_TEMP_EVERY_N;
+        }
+
+        uint32_t d1 = 0;
+        if (!err) {
+            err = ms5837_convert(MS5837_CMD_CONV_D1, &d1);
+        }
+
+        if (err) {
+            temp_countdown = 0;
+            if (++errors >= DEPTH_MAX_ERRORS) {
+                LOG_WRN("MS5837: %d consecutive errors (%d); reinitializing",
+                        errors, err);
+                initialized = false;
+            }
+        } else {
+            errors = 0;
+            temp_countdown--;
+
+            depth_sample_t s;
+            ms5837_compensate(d1, d2, &s.pressure_mbar, &s.temp_c);
+            s.timestamp_ms = k_uptime_get();
+
+            if (tare_count < DEPTH_TARE_SAMPLES) {
+                surface_sum += s.pressure_mbar;
+                if (++tare_count == DEPTH_TARE_SAMPLES) {
+                    surface_mbar = surface_sum / DEPTH_TARE_SAMPLES;
+                    LOG_INF("Depth surface reference %d mbar", (int)surface_mbar);
+                }
+            } else {
+                s.depth_m = (s.pressure_mbar - surface_mbar) / mbar_per_m;
+                s.count = ++published;
+                cell_publish(&s);
+            }
+        }
+
+        next_time += CONFIG_K2_DEPTH_PERIOD_MS;
+        int64_t now = k_uptime_get();
+        if (next_time < now) {
+            next_time = now;   /* conversions overran the period; don't burst */
+        }
+        k_sleep(K_TIMEOUT_ABS_MS(next_time));
+    }
+}
+
+K_THREAD_DEFINE(depth_tid, DEPTH_STACK_SIZE, depth_task, NULL, NULL, NULL,
+                DEPTH_PRIORITY, 0, 0);
@@ -0,0 +1,191 @@
+/*
+ * MS5837-30BA I2C emulator for native_sim.
+ *
+ * Speaks the same command set as the real part (reset, PROM read,
+ * D1/D2 conversion, ADC read) on the zephyr,i2c-emul-controller bus so
+ * ms5837.c runs unmodified off-target.  The PROM holds the example
+ * coefficients from the datasheet with a valid CRC4; raw ADC values are
+ * derived from the depth/temperature set with ms5837_emul_set_depth()
+ * using the first-order equations, which is accurate to a few mbar.
+ *
+ * Like the hardware, an ADC read before the conversion time has elapsed
+ * returns 0, so the driver's timing is exercised as well.
+ */
+
+#define DT_DRV_COMPAT meas_ms5837_30ba
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <string.h>
+
+#include "depth_sensor.h"
+
+#define CMD_RESET    0x1E
+#define CMD_ADC_READ 0x00
+#define CMD_PROM     0xA0
+#define CMD_CONV_D1  0x40
+#define CMD_CONV_D2  0x50
+
+#define SURFACE_MBAR 1013.25f
+#define GRAVITY_MPS2 9.80665f
+
+/* Datasheet example coefficients C1..C6; word 0 gets the CRC at init */
+static uint16_t prom[8] = { 0x0000, 34982, 36352, 20328, 22354, 26646, 26146, 0 };
+
+static const uint16_t conv_time_us[] = { 600, 1170, 2280, 4540, 9040, 18080 };
+
+static struct {
+    float depth_m;
+    float temp_c;
+    bool nack;
+
+    uint8_t prom_addr;       /* PROM word selected by the last write */
+    bool prom_pending;
+    bool adc_pending;        /* ADC read command seen, read phase next */
+
+    uint32_t adc_result;     /* result of the last conversion, 0 once read */
+    int64_t adc_ready_us;
+    bool conv_is_d1;
+} emul_state = {
+    .temp_c = 20.0f,
+};
+
+static int64_t now_us(void)
+{
+    return (int64_t)k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+/* Invert the first-order compensation for the configured depth/temp */
+static uint32_t raw_for(bool d1)
+{
+    int64_t temp = (int64_t)(emul_state.temp_c * 100.0f);
+    int64_t dt = ((temp - 2000) * (1 << 23)) / prom[6];
+
+    if (!d1) {
+        return (uint32_t)(dt + ((int64_t)prom[5] << 8));
+    }
+
+    float mbar_per_m = (float)DT_INST_PROP(0, fluid_density) * GRAVITY_MPS2 / 100.0f;
+    int64_t p = (int64_t)((SURFACE_MBAR + emul_state.depth_m * mbar_per_m) * 10.0f);
+    int64_t off  = ((int64_t)prom[2] << 16) + (((int64_t)prom[4] * dt) >> 7);
+    int64_t sens = ((int64_t)prom[1] << 15) + (((int64_t)prom[3] * dt) >> 8);
+
+    return (uint32_t)((((p << 13) + off) << 21) / sens);
+}
+
+static void handle_cmd(uint8_t cmd)
+{
+    emul_state.prom_pending = false;
+    emul_state.adc_pending = false;
+
+    if (cmd == CMD_RESET) {
+        emul_state.adc_result = 0;
+    } else if (cmd == CMD_ADC_READ) {
+        emul_state.adc_pending = true;
+    } else if ((cmd & 0xF0) == CMD_PROM) {
+        emul_state.prom_addr = (cmd >> 1) & 0x07;
+        emul_state.prom_pending = true;
+    } else if ((cmd & 0xF0) == CMD_CONV_D1 || (cmd & 0xF0) == CMD_CONV_D2) {
+        uint8_t osr = (cmd & 0x0F) >> 1;
+
+        emul_state.conv_is_d1 = (cmd & 0xF0) == CMD_CONV_D1;
+        emul_state.adc_result = raw_for(emul_state.conv_is_d1);
+        emul_state.adc_ready_us = now_us() +
+                                  conv_time_us[MIN(osr, ARRAY_SIZE(conv_time_us) - 1)];
+    }
+}
+
+static void handle_read(uint8_t *buf, uint32_t len)
+{
+    memset(buf, 0, len);
+
+    if (emul_state.prom_pending && len >= 2) {
+        buf[0] = prom[emul_state.prom_addr] >> 8;
+        buf[1] = prom[emul_state.prom_addr] & 0xFF;
+    } else if (emul_state.adc_pending && len >= 3) {
+        uint32_t v = (now_us() >= emul_state.adc_ready_us) ? emul_state.adc_result : 0;
+
+        buf[0] = (v >> 16) & 0xFF;
+        buf[1] = (v >> 8) & 0xFF;
+        buf[2] = v & 0xFF;
+        emul_state.adc_result = 0;
+    }
+
+    emul_state.prom_pending = false;
+    emul_state.adc_pending = false;
+}
+
+static int ms5837_emul_transfer(const struct emul *target, struct i2c_msg *msgs,
+                                int num_msgs, int addr)
+{
+    ARG_UNUSED(target);
+    ARG_UNUSED(addr);
+
+    if (emul_state.nack) {
+        return -EIO;
+    }
+
+    for (int i = 0; i < num_msgs; i++) {
+        if (msgs[i].flags & I2C_MSG_READ) {
+            handle_read(msgs[i].buf, msgs[i].len);
+        } else if (msgs[i].len > 0) {
+            handle_cmd(msgs[i].buf[0]);
+        }
+    }
+    return 0;
+}
+
+/* Same algorithm as the driver; stored in bits 15:12 of word 0 */
+static uint8_t prom_crc4(void)
+{
+    uint16_t n_prom[8];
+    uint16_t n_rem = 0;
+
+    memcpy(n_prom, prom, sizeof(n_prom));
+    n_prom[0] &= 0x0FFF;
+    n_prom[7] = 0;
+
+    for (int cnt = 0; cnt < 16; cnt++) {
+        n_rem ^= (cnt & 1) ? (n_prom[cnt >> 1] & 0x00FF) : (n_prom[cnt >> 1] >> 8);
+        for (int bit = 8; bit > 0; bit--) {
+            n_rem = (n_rem & 0x8000) ? ((n_rem << 1) ^ 0x3000) : (n_rem << 1);
+        }
+    }
+    return (n_rem >> 12) & 0x000F;
+}
+
+static int ms5837_emul_init(const struct emul *target, const struct device *parent)
+{
+    ARG_UNUSED(target);
+    ARG_UNUSED(parent);
+
+    prom[0] = (prom[0] & 0x0FFF) | ((uint16_t)prom_crc4() << 12);
+    return 0;
+}
+
+void ms5837_emul_set_depth(float depth_m, float temp_c)
+{
+    emul_state.depth_m = depth_m;
+    emul_state.temp_c = temp_c;
+}
+
+void ms5837_emul_set_nack(bool nack)
+{
+    emul_state.nack = nack;
+}
+
+static const struct i2c_emul_api ms5837_emul_api = {
+    .transfer = ms5837_emul_transfer,
+};
+
+/* ms5837.c talks to the bus directly rather than through a Zephyr device,
+ * but the emulator framework needs one bound to the node. */
+#define MS5837_EMUL(n)                                                         \
+    DEVICE_DT_INST_DEFINE(n, NULL, NULL, NULL, NULL, POST_KERNEL,              \
+                          CONFIG_KERNEL_INIT_PRIORITY_DEVICE, NULL);           \
+    EMUL_DT_INST_DEFINE(n, ms5837_emul_init, NULL, NULL, &ms5837_emul_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(MS5837_EMUL)
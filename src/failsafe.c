@@ -0,0 +1,59 @@
+#include "failsafe.h"
+
+void failsafe_init(struct failsafe *fs, int32_t hold_ms, int32_t attitude_ms,
+                   int32_t ramp_ms)
+{
+    fs->stage = FAILSAFE_STOPPED;
+    fs->since_ms = 0;
+    fs->stage_ms[FAILSAFE_NONE]     = 0;
+    fs->stage_ms[FAILSAFE_HOLD]     = hold_ms;
+    fs->stage_ms[FAILSAFE_ATTITUDE] = attitude_ms;
+    fs->stage_ms[FAILSAFE_RAMP]     = ramp_ms;
+}
+
+bool failsafe_link_ok(int64_t now_ms, int64_t last_cmd_ms, int32_t hb_age_ms,
+                      uint32_t hb_timeout_ms)
+{
+    if (last_cmd_ms == 0 || (now_ms - last_cmd_ms) > FAILSAFE_COMMS_TIMEOUT_MS) {
+        return false;
+    }
+    return hb_age_ms < 0 || (uint32_t)hb_age_ms <= hb_timeout_ms;
+}
+
+enum failsafe_stage failsafe_update(struct failsafe *fs, bool link_ok, int64_t now_ms)
+{
+    enum failsafe_stage prev = fs->stage;
+
+    if (link_ok) {
+        if (fs->stage != FAILSAFE_NONE) {
+            fs->stage = FAILSAFE_NONE;
+            fs->since_ms = now_ms;
+        }
+        return prev;
+    }
+
+    if (fs->stage == FAILSAFE_NONE) {
+        fs->stage = FAILSAFE_HOLD;
+        fs->since_ms = now_ms;
+    }
+    while (fs->stage != FAILSAFE_STOPPED &&
+           now_ms - fs->since_ms >= fs->stage_ms[fs->stage]) {
+        fs->since_ms += fs->stage_ms[fs->stage];
+        fs->stage++;
+    }
+    return prev;
+}
+
+float failsafe_output_scale(const struct failsafe *fs, int64_t now_ms)
+{
+    if (fs->stage != FAILSAFE_RAMP) {
+        return 1.0f;
+    }
+
+    float t = (float)(now_ms - fs->since_ms) / (float)fs->stage_ms[FAILSAFE_RAMP];
+
+    if (t < 0.0f) {
+        return 1.0f;
+    }
+    return (t > 1.0f) ? 0.0f : 1.0f - t;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Staged link-loss failsafe, as run by the control loop.
+ *
+ * The link is up while commands arrive within FAILSAFE_COMMS_TIMEOUT_MS
+ * and, once topside has started sending heartbeats, while heartbeats
+ * arrive within their (much shorter) timeout.  On loss the stage steps
+ * HOLD → ATTITUDE → RAMP → STOPPED on the configured durations instead
+ * of cutting the thrusters in one cycle; any stage returns straight to
+ * normal control when the link comes back.
+ *
+ * Pilot commands steer only in FAILSAFE_NONE.  A command that arrives
+ * while a stage is active (heartbeat lost, commands still flowing) keeps
+ * the link's command timer alive but must not reach the sticks.
+ *
+ * No Zephyr dependencies, so tools/failsafe_test.c runs it on the host.
+ */
+
+#define FAILSAFE_COMMS_TIMEOUT_MS  2000   /* 2 s without a command → failsafe */
+
+/* Link-loss response, in the order the stages are entered.  The loop
+ * starts in FAILSAFE_STOPPED and leaves it on the first command. */
+enum failsafe_stage {
+    FAILSAFE_NONE = 0,      /* link up, normal control */
+    FAILSAFE_HOLD,          /* keep flying the last pilot setpoint */
+    FAILSAFE_ATTITUDE,      /* hold attitude and depth, sticks zeroed */
+    FAILSAFE_RAMP,          /* as above, outputs ramped down to zero */
+    FAILSAFE_STOPPED,       /* thrusters off */
+};
+
+struct failsafe {
+    enum failsafe_stage stage;
+    int64_t since_ms;                       /* uptime the stage was entered */
+    int32_t stage_ms[FAILSAFE_STOPPED];     /* how long HOLD..RAMP last */
+};
+
+/* Start stopped, with the durations of the HOLD, ATTITUDE and RAMP stages */
+void failsafe_init(struct failsafe *fs, int32_t hold_ms, int32_t attitude_ms,
+                   int32_t ramp_ms);
+
+/*
+ * Link state from the last command time (0 = none yet) and the heartbeat
+ * age (negative = topside never sent one).
+ */
+bool failsafe_link_ok(int64_t now_ms, int64_t last_cmd_ms, int32_t hb_age_ms,
+                      uint32_t hb_timeout_ms);
+
+/*
+ * Advance to now_ms.  Returns the stage before the call, so the caller
+ * can act on transitions.  Stage boundaries are kept exact, and a 0 ms
+ * stage is skipped.
+ */
+enum failsafe_stage failsafe_update(struct failsafe *fs, bool link_ok, int64_t now_ms);
+
+/* Output scale for the current stage: 1 until the ramp, then down to 0 */
+float failsafe_output_scale(const struct failsafe *fs, int64_t now_ms);
+
+/* Whether a newly received command may set the sticks */
+static inline bool failsafe_pilot_live(const struct failsafe *fs)
+{
+    return fs->stage == FAILSAFE_NONE;
+}
@@ -1,13 +1,16 @@
 /*
  * Axis Config — UDP service for receiving IMU axis remapping and offset
  *
- * Listens on UDP port 5004 for configuration packets from topside.
+ * Handles configuration packets from topside on UDP port 5004 (delivered
+ * by the UDP dispatcher).
  * Supports remapping of:
  *   - Yaw/Pitch/Roll axes (for angular PID)
  *   - Accelerometer X/Y/Z axes (for translational PID)
  *   - IMU offset from center of mass (for centripetal compensation)
+ *   - Mounting rotation (v2 packets), for an IMU that is not mounted
+ *     square to the hull
  *
- * Packet layout (30 bytes):
+ * Packet layout, v1 (30 bytes):
  *   | type (1B)
  *   | yaw_src (1B) | yaw_sign (1B) | pitch_src (1B) | pitch_sign (1B)
  *   | roll_src (1B) | roll_sign (1B)
@@ -17,6 +20,18 @@
  *   | offset_x (4B float) | offset_y (4B float) | offset_z (4B float)
  *   | crc32 (4B)
  *
+ * v2 (50 bytes) inserts before the CRC:
+ *   | rot_format (1B) | pad (3B) | rot[4] (4 x 4B float)
+ * rot_format: 0 = none, 1 = Euler yaw/pitch/roll in degrees (ZYX, rot[3]
+ * unused), 2 = quaternion w/x/y/z; the sensor's orientation in the body
+ * frame.  The version is told by length and the reply uses the request's
+ * version.  A v1 SET leaves the mounting rotation as it was, so an older
+ * console cannot silently undo it.
+ *
+ * The rotation is turned into a 3x3 matrix once, when it is set.  The
+ * control loop applies it to accelerations and rates, and composes it
+ * with the sensor's attitude to get the hull's.
+ *
  * Type values:
  *   0x01 = SET    — update config, reply with active values
  *   0x02 = REQUEST — reply with current config
@@ -30,10 +45,13 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/socket.h>
+#include <math.h>
 #include <string.h>
 
 #include "axis_config.h"
+#include "../config_gen.h"
 #include "../net/net.h"
+#include "../net/udp_dispatch.h"
 
 LOG_MODULE_REGISTER(axis_config, LOG_LEVEL_INF);
 
@@ -43,6 +61,10 @@ LOG_MODULE_REGISTER(axis_config, LOG_LEVEL_INF);
 static const char *ypr_names[] = {"yaw", "pitch", "roll"};
 static const char *accel_names[] = {"x", "y", "z"};
 
+#define DEG2RAD (3.14159265f / 180.0f)
+#define RAD2DEG (180.0f / 3.14159265f)
+
+/* v1 fields, shared by both packet versions */
 typedef struct {
     uint8_t  type;
     /* YPR remap */
@@ -64,61 +86,166 @@ typedef struct {
     float    offset_x;
     float    offset_y;
     float    offset_z;
-    /* Integrity */
+} __attribute__((packed)) axis_fields_t;
+
+typedef struct {
+    axis_fields_t f;
     uint32_t crc32;
 } __attribute__((packed)) axis_packet_t;
 
-/* Default: identity mapping, no inversion */
-static axis_map_t ypr_map[3] = {
-    { .src = AXIS_SRC_YAW,   .sign = 1 },
-    { .src = AXIS_SRC_PITCH, .sign = 1 },
-    { .src = AXIS_SRC_ROLL,  .sign = 1 },
-};
+typedef struct {
+    axis_fields_t f;
+    /* Mounting rotation */
+    uint8_t  rot_format;
+    uint8_t  _pad2[3];
+    float    rot[4];
+    /* Integrity */
+    uint32_t crc32;
+} __attribute__((packed)) axis_packet_v2_t;
 
-static axis_map_t accel_map[3] = {
-    { .src = ACCEL_SRC_X, .sign = 1 },
-    { .src = ACCEL_SRC_Y, .sign = 1 },
-    { .src = ACCEL_SRC_Z, .sign = 1 },
+/*
+ * Active configuration.  Written only by the UDP dispatcher under
+ * axis_map_mutex, with config_seq odd while the write is in progress;
+ * read lock-free by the control loop through axis_config_sync().
+ * Default: identity mapping, no inversion, no offset.
+ */
+static axis_config_t current = {
+    .ypr = {
+        { .src = AXIS_SRC_YAW,   .sign = 1 },
+        { .src = AXIS_SRC_PITCH, .sign = 1 },
+        { .src = AXIS_SRC_ROLL,  .sign = 1 },
+    },
+    .accel = {
+        { .src = ACCEL_SRC_X, .sign = 1 },
+        { .src = ACCEL_SRC_Y, .sign = 1 },
+        { .src = ACCEL_SRC_Z, .sign = 1 },
+    },
+    .mount = { {1, 0, 0}, {0, 1, 0}, {0, 0, 1} },
+    .vec   = { {1, 0, 0}, {0, 1, 0}, {0, 0, 1} },
 };
-
-static imu_offset_t current_offset = { .x = 0.0f, .y = 0.0f, .z = 0.0f };
+static atomic_t config_seq;
 
 K_MUTEX_DEFINE(axis_map_mutex);
 
-K_THREAD_STACK_DEFINE(axis_config_stack, 2048);
-static struct k_thread axis_config_thread_data;
+bool axis_config_sync(uint32_t *gen, axis_config_t *out)
+{
+    return config_gen_sync(&config_seq, gen, out, &current, sizeof(current));
+}
 
-void axis_config_remap_ypr(float raw_yaw, float raw_pitch, float raw_roll,
-                           float *out_yaw, float *out_pitch, float *out_roll)
+static void mat_mul(const float a[3][3], const float b[3][3], float out[3][3])
 {
-    float raw[3] = { raw_yaw, raw_pitch, raw_roll };
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            out[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j];
+        }
+    }
+}
 
-    k_mutex_lock(&axis_map_mutex, K_FOREVER);
-    *out_yaw   = raw[ypr_map[0].src] * ypr_map[0].sign;
-    *out_pitch = raw[ypr_map[1].src] * ypr_map[1].sign;
-    *out_roll  = raw[ypr_map[2].src] * ypr_map[2].sign;
-    k_mutex_unlock(&axis_map_mutex);
+/* ZYX Euler angles (radians) → rotation matrix, R = Rz(yaw)·Ry(pitch)·Rx(roll) */
+static void euler_to_mat(float yaw, float pitch, float roll, float m[3][3])
+{
+    float cy = cosf(yaw),   sy = sinf(yaw);
+    float cp = cosf(pitch), sp = sinf(pitch);
+    float cr = cosf(roll),  sr = sinf(roll);
+
+    m[0][0] = cy * cp;  m[0][1] = cy * sp * sr - sy * cr;  m[0][2] = cy * sp * cr + sy * sr;
+    m[1][0] = sy * cp;  m[1][1] = sy * sp * sr + cy * cr;  m[1][2] = sy * sp * cr - cy * sr;
+    m[2][0] = -sp;      m[2][1] = cp * sr;                 m[2][2] = cp * cr;
 }
 
-void axis_config_remap_accel(float raw_ax, float raw_ay, float raw_az,
-                             float *out_ax, float *out_ay, float *out_az)
+/* Unit quaternion (w, x, y, z) → rotation matrix; false if not normalisable */
+static bool quat_to_mat(const float q[4], float m[3][3])
 {
-    float raw[3] = { raw_ax, raw_ay, raw_az };
+    float n = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    if (!(n > 1e-6f) || !isfinite(n)) {
+        return false;
+    }
 
-    k_mutex_lock(&axis_map_mutex, K_FOREVER);
-    *out_ax = raw[accel_map[0].src] * accel_map[0].sign;
-    *out_ay = raw[accel_map[1].src] * accel_map[1].sign;
-    *out_az = raw[accel_map[2].src] * accel_map[2].sign;
-    k_mutex_unlock(&axis_map_mutex);
+    float w = q[0] / n, x = q[1] / n, y = q[2] / n, z = q[3] / n;
+
+    m[0][0] = 1 - 2 * (y * y + z * z);  m[0][1] = 2 * (x * y - w * z);      m[0][2] = 2 * (x * z + w * y);
+    m[1][0] = 2 * (x * y + w * z);      m[1][1] = 1 - 2 * (x * x + z * z);  m[1][2] = 2 * (y * z - w * x);
+    m[2][0] = 2 * (x * z - w * y);      m[2][1] = 2 * (y * z + w * x);      m[2][2] = 1 - 2 * (x * x + y * y);
+    return true;
 }
 
-imu_offset_t axis_config_get_offset(void)
+/* Permutation with signs as a matrix: row i picks map[i].src */
+static void map_to_mat(const axis_map_t map[3], float m[3][3])
 {
-    imu_offset_t off;
-    k_mutex_lock(&axis_map_mutex, K_FOREVER);
-    off = current_offset;
-    k_mutex_unlock(&axis_map_mutex);
-    return off;
+    memset(m, 0, sizeof(float[3][3]));
+    for (int i = 0; i < 3; i++) {
+        m[i][map[i].src] = map[i].sign;
+    }
+}
+
+/*
+ * Fill in cfg->mount and cfg->vec from cfg->rot_format/rot and the accel
+ * map.  Returns -EINVAL for an unknown format or a degenerate rotation.
+ */
+static int build_rotation(axis_config_t *cfg)
+{
+    static const float identity[3][3] = { {1, 0, 0}, {0, 1, 0}, {0, 0, 1} };
+
+    for (int i = 0; i < 4; i++) {
+        if (!isfinite(cfg->rot[i])) {
+            return -EINVAL;
+        }
+    }
+
+    switch (cfg->rot_format) {
+    case AXIS_ROT_NONE:
+        memcpy(cfg->mount, identity, sizeof(identity));
+        break;
+    case AXIS_ROT_EULER:
+        euler_to_mat(cfg->rot[0] * DEG2RAD, cfg->rot[1] * DEG2RAD,
+                     cfg->rot[2] * DEG2RAD, cfg->mount);
+        break;
+    case AXIS_ROT_QUATERNION:
+        if (!quat_to_mat(cfg->rot, cfg->mount)) {
+            return -EINVAL;
+        }
+        break;
+    default:
+        return -EINVAL;
+    }
+
+    float perm[3][3];
+    map_to_mat(cfg->accel, perm);
+    mat_mul(cfg->mount, perm, cfg->vec);
+
+    /* Compared as numbers: a zero rotation may carry -0.0 terms */
+    cfg->rotated = false;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            cfg->rotated |= (cfg->mount[i][j] != identity[i][j]);
+        }
+    }
+    return 0;
+}
+
+void axis_config_attitude(const axis_config_t *cfg, const float raw_ypr[3],
+                          float out_ypr[3])
+{
+    axis_config_remap(cfg->ypr, raw_ypr, out_ypr);
+    if (!cfg->rotated) {
+        return;
+    }
+
+    /* Sensor attitude R_ns, then the hull's: v_n = R_ns·v_s = R_nb·mount·v_s */
+    float r_ns[3][3], r_nb[3][3];
+    euler_to_mat(out_ypr[0] * DEG2RAD, out_ypr[1] * DEG2RAD, out_ypr[2] * DEG2RAD, r_ns);
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            /* R_ns · mountᵀ */
+            r_nb[i][j] = r_ns[i][0] * cfg->mount[j][0] + r_ns[i][1] * cfg->mount[j][1] +
+                         r_ns[i][2] * cfg->mount[j][2];
+        }
+    }
+
+    out_ypr[0] = atan2f(r_nb[1][0], r_nb[0][0]) * RAD2DEG;
+    out_ypr[1] = -asinf(CLAMP(r_nb[2][0], -1.0f, 1.0f)) * RAD2DEG;
+    out_ypr[2] = atan2f(r_nb[2][1], r_nb[2][2]) * RAD2DEG;
 }
 
 static bool valid_src(uint8_t s)
@@ -131,37 +258,55 @@ static int8_t decode_sign(uint8_t s)
     return s ? -1 : 1;
 }
 
-static void apply_packet(const axis_packet_t *pkt)
+/* v2 rotation is NULL for a v1 SET, which keeps the current one */
+static int apply_packet(const axis_fields_t *pkt, const axis_packet_v2_t *v2)
 {
     if (!valid_src(pkt->yaw_src) || !valid_src(pkt->pitch_src) ||
         !valid_src(pkt->roll_src) || !valid_src(pkt->ax_src) ||
         !valid_src(pkt->ay_src) || !valid_src(pkt->az_src)) {
         LOG_WRN("Axis config: invalid source index, dropping");
-        return;
+        return -EINVAL;
     }
 
-    k_mutex_lock(&axis_map_mutex, K_FOREVER);
-
-    ypr_map[0].src  = pkt->yaw_src;
-    ypr_map[0].sign = decode_sign(pkt->yaw_sign);
-    ypr_map[1].src  = pkt->pitch_src;
-    ypr_map[1].sign = decode_sign(pkt->pitch_sign);
-    ypr_map[2].src  = pkt->roll_src;
-    ypr_map[2].sign = decode_sign(pkt->roll_sign);
-
-    accel_map[0].src  = pkt->ax_src;
-    accel_map[0].sign = decode_sign(pkt->ax_sign);
-    accel_map[1].src  = pkt->ay_src;
-    accel_map[1].sign = decode_sign(pkt->ay_sign);
-    accel_map[2].src  = pkt->az_src;
-    accel_map[2].sign = decode_sign(pkt->az_sign);
+    axis_config_t cfg = {
+        .ypr = {
+            { .src = pkt->yaw_src,   .sign = decode_sign(pkt->yaw_sign) },
+            { .src = pkt->pitch_src, .sign = decode_sign(pkt->pitch_sign) },
+            { .src = pkt->roll_src,  .sign = decode_sign(pkt->roll_sign) },
+        },
+        .accel = {
+            { .src = pkt->ax_src, .sign = decode_sign(pkt->ax_sign) },
+            { .src = pkt->ay_src, .sign = decode_sign(pkt->ay_sign) },
+            { .src = pkt->az_src, .sign = decode_sign(pkt->az_sign) },
+        },
+        .offset = { .x = pkt->offset_x, .y = pkt->offset_y, .z = pkt->offset_z },
+    };
 
-    current_offset.x = pkt->offset_x;
-    current_offset.y = pkt->offset_y;
-    current_offset.z = pkt->offset_z;
+    k_mutex_lock(&axis_map_mutex, K_FOREVER);
+    if (v2) {
+        cfg.rot_format = v2->rot_format;
+        memcpy(cfg.rot, v2->rot, sizeof(cfg.rot));
+    } else {
+        cfg.rot_format = current.rot_format;
+        memcpy(cfg.rot, current.rot, sizeof(cfg.rot));
+    }
 
+    /* Precompute outside the published copy; the control loop only ever
+     * sees finished matrices */
+    int err = build_rotation(&cfg);
+    if (err == 0) {
+        config_gen_write_begin(&config_seq);
+        current = cfg;
+        config_gen_write_end(&config_seq);
+    }
     k_mutex_unlock(&axis_map_mutex);
 
+    if (err < 0) {
+        LOG_WRN("Axis config: invalid mounting rotation (format %u), dropping",
+                cfg.rot_format);
+        return err;
+    }
+
     LOG_INF("Axis YPR: yaw=%s%s pitch=%s%s roll=%s%s",
             pkt->yaw_sign ? "-" : "+", ypr_names[pkt->yaw_src],
             pkt->pitch_sign ? "-" : "+", ypr_names[pkt->pitch_src],
@@ -172,129 +317,97 @@ static void apply_packet(const axis_packet_t *pkt)
             pkt->az_sign ? "-" : "+", accel_names[pkt->az_src]);
     LOG_INF("IMU offset: x=%d y=%d z=%d mm",
             (int)pkt->offset_x, (int)pkt->offset_y, (int)pkt->offset_z);
+    if (cfg.rotated) {
+        /* Rotation as Euler angles x100 for the log, whatever format it came in */
+        float m00 = cfg.mount[0][0], m10 = cfg.mount[1][0], m20 = cfg.mount[2][0];
+        LOG_INF("IMU mounting: yaw=%d pitch=%d roll=%d (deg x100)",
+                (int)(atan2f(m10, m00) * RAD2DEG * 100),
+                (int)(-asinf(CLAMP(m20, -1.0f, 1.0f)) * RAD2DEG * 100),
+                (int)(atan2f(cfg.mount[2][1], cfg.mount[2][2]) * RAD2DEG * 100));
+    }
+    return 0;
 }
 
-static void send_config_reply(int sock, struct sockaddr_in *dest)
+static void send_config_reply(int sock, const struct sockaddr_in *dest, bool v2)
 {
-    axis_packet_t reply;
+    axis_packet_v2_t reply;
     memset(&reply, 0, sizeof(reply));
-    reply.type = AXIS_PKT_SET;
+    reply.f.type = AXIS_PKT_SET;
 
     k_mutex_lock(&axis_map_mutex, K_FOREVER);
-
-    reply.yaw_src    = ypr_map[0].src;
-    reply.yaw_sign   = (ypr_map[0].sign < 0) ? 1 : 0;
-    reply.pitch_src  = ypr_map[1].src;
-    reply.pitch_sign = (ypr_map[1].sign < 0) ? 1 : 0;
-    reply.roll_src   = ypr_map[2].src;
-    reply.roll_sign  = (ypr_map[2].sign < 0) ? 1 : 0;
-
-    reply.ax_src  = accel_map[0].src;
-    reply.ax_sign = (accel_map[0].sign < 0) ? 1 : 0;
-    reply.ay_src  = accel_map[1].src;
-    reply.ay_sign = (accel_map[1].sign < 0) ? 1 : 0;
-    reply.az_src  = accel_map[2].src;
-    reply.az_sign = (accel_map[2].sign < 0) ? 1 : 0;
-
-    reply.offset_x = current_offset.x;
-    reply.offset_y = current_offset.y;
-    reply.offset_z = current_offset.z;
-
+    axis_config_t cfg = current;
     k_mutex_unlock(&axis_map_mutex);
 
-    reply.crc32 = crc32_calc(&reply, sizeof(reply) - sizeof(reply.crc32));
+    reply.f.yaw_src    = cfg.ypr[0].src;
+    reply.f.yaw_sign   = (cfg.ypr[0].sign < 0) ? 1 : 0;
+    reply.f.pitch_src  = cfg.ypr[1].src;
+    reply.f.pitch_sign = (cfg.ypr[1].sign < 0) ? 1 : 0;
+    reply.f.roll_src   = cfg.ypr[2].src;
+    reply.f.roll_sign  = (cfg.ypr[2].sign < 0) ? 1 : 0;
+
+    reply.f.ax_src  = cfg.accel[0].src;
+    reply.f.ax_sign = (cfg.accel[0].sign < 0) ? 1 : 0;
+    reply.f.ay_src  = cfg.accel[1].src;
+    reply.f.ay_sign = (cfg.accel[1].sign < 0) ? 1 : 0;
+    reply.f.az_src  = cfg.accel[2].src;
+    reply.f.az_sign = (cfg.accel[2].sign < 0) ? 1 : 0;
+
+    reply.f.offset_x = cfg.offset.x;
+    reply.f.offset_y = cfg.offset.y;
+    reply.f.offset_z = cfg.offset.z;
+
+    size_t len;
+    if (v2) {
+        reply.rot_format = cfg.rot_format;
+        memcpy(reply.rot, cfg.rot, sizeof(reply.rot));
+        len = sizeof(axis_packet_v2_t);
+    } else {
+        len = sizeof(axis_packet_t);
+    }
+
+    /* CRC covers everything before it, and sits right after */
+    uint32_t crc = crc32_calc(&reply, len - sizeof(crc));
+    memcpy((uint8_t *)&reply + len - sizeof(crc), &crc, sizeof(crc));
 
-    zsock_sendto(sock, &reply, sizeof(reply), 0,
-                 (struct sockaddr *)dest, sizeof(*dest));
+    net_port_sendto(NET_PORT_AXIS_CONFIG, sock, &reply, len, 0, dest);
 }
 
-static void axis_config_thread(void *arg1, void *arg2, void *arg3)
+static int axis_config_handle(int sock, const uint8_t *data, size_t len,
+                              const struct sockaddr_in *from)
 {
-    ARG_UNUSED(arg1); ARG_UNUSED(arg2); ARG_UNUSED(arg3);
-
-    int sock;
-    struct sockaddr_in bind_addr, client_addr;
-    socklen_t client_addr_len;
-    axis_packet_t packet;
-    int ret;
+    const axis_fields_t *packet = (const axis_fields_t *)data;
+    bool v2 = (len == sizeof(axis_packet_v2_t));
 
-    while (!network_ready) {
-        k_sleep(K_MSEC(100));
+    if (!v2 && len != sizeof(axis_packet_t)) {
+        return -EINVAL;
     }
 
-    sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (sock < 0) {
-        LOG_ERR("Failed to create axis config socket: %d", sock);
-        return;
-    }
-
-    memset(&bind_addr, 0, sizeof(bind_addr));
-    bind_addr.sin_family      = AF_INET;
-    bind_addr.sin_addr.s_addr = INADDR_ANY;
-    bind_addr.sin_port        = htons(AXIS_CONFIG_PORT);
-
-    ret = zsock_bind(sock, (struct sockaddr *)&bind_addr, sizeof(bind_addr));
-    if (ret < 0) {
-        LOG_ERR("Failed to bind axis config socket: %d", ret);
-        zsock_close(sock);
-        return;
+    switch (packet->type) {
+    case AXIS_PKT_SET: {
+        /* Reply even if rejected so topside sees the config still active */
+        int err = apply_packet(packet, v2 ? (const axis_packet_v2_t *)data : NULL);
+        send_config_reply(sock, from, v2);
+        return err;
     }
 
-    LOG_INF("Axis config listener ready on port %d", AXIS_CONFIG_PORT);
-
-    while (1) {
-        client_addr_len = sizeof(client_addr);
-        ret = zsock_recvfrom(sock, &packet, sizeof(packet), 0,
-                             (struct sockaddr *)&client_addr, &client_addr_len);
-
-        if (ret != sizeof(axis_packet_t)) {
-            if (ret < 0) {
-                LOG_ERR("Axis config recv error: %d", ret);
-                k_sleep(K_MSEC(100));
-            } else {
-                LOG_WRN("Axis config: wrong packet size %d (expected %d)",
-                        ret, sizeof(axis_packet_t));
-            }
-            continue;
-        }
-
-        uint32_t calc_crc = crc32_calc(&packet,
-                                       sizeof(packet) - sizeof(packet.crc32));
-        if (calc_crc != packet.crc32) {
-            LOG_ERR("Axis config CRC mismatch (calc 0x%08X, recv 0x%08X)",
-                    calc_crc, packet.crc32);
-            continue;
-        }
+    case AXIS_PKT_REQUEST:
+        LOG_INF("Axis config requested");
+        send_config_reply(sock, from, v2);
+        return 0;
 
-        switch (packet.type) {
-        case AXIS_PKT_SET:
-            apply_packet(&packet);
-            send_config_reply(sock, &client_addr);
-            break;
-
-        case AXIS_PKT_REQUEST:
-            LOG_INF("Axis config requested");
-            send_config_reply(sock, &client_addr);
-            break;
-
-        default:
-            LOG_WRN("Axis config: unknown packet type 0x%02X", packet.type);
-            break;
-        }
+    default:
+        LOG_WRN("Axis config: unknown packet type 0x%02X", packet->type);
+        return -ENOMSG;
     }
 }
 
-void axis_config_start(void)
-{
-    k_tid_t tid = k_thread_create(&axis_config_thread_data,
-                                  axis_config_stack,
-                                  K_THREAD_STACK_SIZEOF(axis_config_stack),
-                                  axis_config_thread,
-                                  NULL, NULL, NULL,
-                                  K_PRIO_COOP(7), 0, K_NO_WAIT);
-    if (tid) {
-        LOG_INF("Axis config thread started");
-    } else {
-        LOG_ERR("Failed to start axis config thread");
-    }
-}
+const struct udp_service axis_config_service = {
+    .name     = "Axis config",
+    .port     = AXIS_CONFIG_PORT,
+    .min_len  = sizeof(axis_packet_t),
+    .max_len  = sizeof(axis_packet_v2_t),
+    .crc      = UDP_CRC_NATIVE,
+    .handler  = axis_config_handle,
+    .counters = NET_PORT_AXIS_CONFIG,
+    .priority = NET_PRIO_TELEMETRY,
+};
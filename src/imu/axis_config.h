@@ -29,25 +29,72 @@ typedef struct {
     float z;
 } imu_offset_t;
 
-/* Start the axis config UDP listener thread */
-void axis_config_start(void);
+/* How a mounting rotation was given (kept for the reply) */
+enum axis_rot_format {
+    AXIS_ROT_NONE = 0,
+    AXIS_ROT_EULER,        /* yaw, pitch, roll in degrees, ZYX */
+    AXIS_ROT_QUATERNION,   /* w, x, y, z */
+};
+
+/* One complete published axis configuration */
+typedef struct {
+    axis_map_t   ypr[3];     /* yaw, pitch, roll */
+    axis_map_t   accel[3];   /* x, y, z */
+    imu_offset_t offset;
+
+    /*
+     * Mounting rotation: the sensor's orientation in the body frame.
+     * Converted once, when set, into the matrices below; `rotated` is
+     * false for the identity so the plain permutation path stays exact.
+     */
+    bool         rotated;
+    uint8_t      rot_format;     /* enum axis_rot_format */
+    float        rot[4];         /* as received */
+    float        mount[3][3];    /* sensor → body: v_b = mount · v_s */
+    float        vec[3][3];      /* mount · accel permutation, for accel and rates */
+} axis_config_t;
+
+#define AXIS_CONFIG_GEN_NONE 1U   /* odd: never a published generation */
 
 /*
- * Apply the current axis remapping to raw sensor yaw/pitch/roll.
- * Thread-safe.
+ * Copy the configuration into `out` if it changed since generation
+ * `*gen`, and update `*gen`.  Returns false without touching `out`
+ * otherwise — one atomic load, so the control loop calls it every cycle
+ * and keeps its own copy.  Start with *gen = AXIS_CONFIG_GEN_NONE.
+ * Lock-free; safe against a concurrent SET.
  */
-void axis_config_remap_ypr(float raw_yaw, float raw_pitch, float raw_roll,
-                           float *out_yaw, float *out_pitch, float *out_roll);
+bool axis_config_sync(uint32_t *gen, axis_config_t *out);
+
+/* Apply a 3-axis remap from a snapshot: out[i] = raw[map[i].src] * map[i].sign */
+static inline void axis_config_remap(const axis_map_t map[3], const float raw[3],
+                                     float out[3])
+{
+    for (int i = 0; i < 3; i++) {
+        out[i] = raw[map[i].src] * map[i].sign;
+    }
+}
 
 /*
- * Apply the current axis remapping to raw accelerometer x/y/z.
- * Thread-safe.
+ * Bring a sensor-frame vector (acceleration, angular rate as x/y/z) into
+ * the body frame: the accel permutation, then the mounting rotation.
  */
-void axis_config_remap_accel(float raw_ax, float raw_ay, float raw_az,
-                             float *out_ax, float *out_ay, float *out_az);
+static inline void axis_config_vector(const axis_config_t *cfg, const float raw[3],
+                                      float out[3])
+{
+    if (!cfg->rotated) {
+        axis_config_remap(cfg->accel, raw, out);
+        return;
+    }
+    for (int i = 0; i < 3; i++) {
+        out[i] = cfg->vec[i][0] * raw[0] + cfg->vec[i][1] * raw[1] +
+                 cfg->vec[i][2] * raw[2];
+    }
+}
 
 /*
- * Get the current IMU offset from center of mass (mm).
- * Thread-safe.
+ * Body attitude (yaw, pitch, roll in degrees) from the sensor's: the YPR
+ * permutation, then, with a mounting rotation, R_nb = R_ns · mountᵀ
+ * and back to ZYX Euler angles.
  */
-imu_offset_t axis_config_get_offset(void);
+void axis_config_attitude(const axis_config_t *cfg, const float raw_ypr[3],
+                          float out_ypr[3]);
@@ -0,0 +1,231 @@
+/*
+ * IMU sample validation — streaming plausibility gates for VN-100S data.
+ *
+ * A corrupted SPI frame usually decodes to NaN, but it can just as well
+ * decode to finite garbage (a 170 deg yaw jump in one sample).  Each new
+ * sample is checked against the last accepted one using physical limits
+ * of the vehicle:
+ *
+ *   1. all nine values finite
+ *   2. attitude inside the sensor output range
+ *   3. |rate| below IMU_MAX_RATE_DPS
+ *   4. rate change below IMU_MAX_ANG_ACCEL_DPS2 * dt
+ *   5. attitude change consistent with the gyro rates integrated over dt
+ *   6. |accel| below IMU_MAX_ACCEL_MPS2
+ *
+ * Accepted accelerations go through a 3-sample median so a single spike
+ * that passes the gates cannot reach the speed estimator.
+ *
+ * The whole stage is straight-line float math (no trig, no division in
+ * the common path).  tools/imu_validate_bench.c runs this file on the
+ * host, where a sample takes about 40 ns; it has not been timed on the
+ * M7.
+ */
+
+#include <zephyr/sys/atomic.h>
+#include <math.h>
+
+#include "imu_validate.h"
+
+#define IMU_MAX_RATE_DPS         500.0f   /* ROV cannot spin faster than this */
+#define IMU_MAX_ANG_ACCEL_DPS2   3000.0f  /* max plausible angular acceleration */
+#define IMU_RATE_STEP_MARGIN_DPS 20.0f    /* gyro noise allowance per sample */
+#define IMU_ATT_MARGIN_DEG       5.0f     /* allowance for rate vs Euler mismatch */
+#define IMU_ATT_RATE_SCALE       1.5f     /* slack on the integrated rate bound */
+#define IMU_MAX_ACCEL_MPS2       40.0f    /* ~4 g, well above thruster authority */
+#define IMU_GIMBAL_PITCH_DEG     75.0f    /* skip yaw/roll check near gimbal lock */
+#define IMU_MAX_GAP_MS           500      /* longer gaps reseed the reference */
+#define IMU_MAX_CONSEC_REJECTS   10       /* accept and reseed after this many */
+
+static const char *reason_names[IMU_REJ_COUNT] = {
+    "nonfinite", "range", "rate", "rate_step", "att_jump", "accel"
+};
+
+static atomic_t reject_count[IMU_REJ_COUNT];
+
+static imu_sample_t ref;          /* last accepted sample (pre-median accel) */
+static int64_t ref_time_ms;
+static bool has_ref;
+static uint32_t consec_rejects;
+
+/* Accel median history: [axis][slot] */
+static float accel_hist[3][3];
+static uint8_t accel_hist_len;
+static uint8_t accel_hist_idx;
+
+static inline float absf(float v)
+{
+    return v < 0.0f ? -v : v;
+}
+
+static inline float maxf(float a, float b)
+{
+    return a > b ? a : b;
+}
+
+static inline float minf(float a, float b)
+{
+    return a < b ? a : b;
+}
+
+/* Branch-light median of three */
+static inline float median3(float a, float b, float c)
+{
+    return maxf(minf(a, b), minf(maxf(a, b), c));
+}
+
+/* Wrap angle difference to (-180, +180] */
+static inline float wrap_180(float angle)
+{
+    if (angle > 180.0f) {
+        angle -= 360.0f;
+    } else if (angle <= -180.0f) {
+        angle += 360.0f;
+    }
+    return angle;
+}
+
+static bool sample_finite(const imu_sample_t *s)
+{
+    return isfinite(s->yaw) && isfinite(s->pitch) && isfinite(s->roll) &&
+           isfinite(s->yr)  && isfinite(s->pr)    && isfinite(s->rr)   &&
+           isfinite(s->ax)  && isfinite(s->ay)    && isfinite(s->az);
+}
+
+static bool sample_in_range(const imu_sample_t *s)
+{
+    return absf(s->yaw) <= 180.0f && absf(s->pitch) <= 90.0f &&
+           absf(s->roll) <= 180.0f;
+}
+
+static float max_abs_rate(const imu_sample_t *s)
+{
+    return maxf(absf(s->yr), maxf(absf(s->pr), absf(s->rr)));
+}
+
+static float max_abs_accel(const imu_sample_t *s)
+{
+    return maxf(absf(s->ax), maxf(absf(s->ay), absf(s->az)));
+}
+
+/* Check the stateless gates, then the ones that need the reference sample */
+static enum imu_reject check_sample(const imu_sample_t *s, float dt)
+{
+    if (!sample_finite(s)) {
+        return IMU_REJ_NONFINITE;
+    }
+    if (!sample_in_range(s)) {
+        return IMU_REJ_RANGE;
+    }
+    if (max_abs_rate(s) > IMU_MAX_RATE_DPS) {
+        return IMU_REJ_RATE_LIMIT;
+    }
+    if (max_abs_accel(s) > IMU_MAX_ACCEL_MPS2) {
+        return IMU_REJ_ACCEL_LIMIT;
+    }
+    if (dt <= 0.0f) {
+        return IMU_REJ_COUNT;   /* no usable reference — accept */
+    }
+
+    float max_step = IMU_MAX_ANG_ACCEL_DPS2 * dt + IMU_RATE_STEP_MARGIN_DPS;
+    if (absf(s->yr - ref.yr) > max_step ||
+        absf(s->pr - ref.pr) > max_step ||
+        absf(s->rr - ref.rr) > max_step) {
+        return IMU_REJ_RATE_STEP;
+    }
+
+    /* Body rates are not Euler rates, so bound each angle delta by the
+     * largest rate magnitude seen over the interval plus a margin. */
+    float w = maxf(max_abs_rate(s), max_abs_rate(&ref));
+    float max_delta = w * dt * IMU_ATT_RATE_SCALE + IMU_ATT_MARGIN_DEG;
+
+    if (absf(s->pitch - ref.pitch) > max_delta) {
+        return IMU_REJ_ATTITUDE_JUMP;
+    }
+    if (absf(s->pitch) < IMU_GIMBAL_PITCH_DEG &&
+        absf(ref.pitch) < IMU_GIMBAL_PITCH_DEG) {
+        if (absf(wrap_180(s->yaw - ref.yaw)) > max_delta ||
+            absf(wrap_180(s->roll - ref.roll)) > max_delta) {
+            return IMU_REJ_ATTITUDE_JUMP;
+        }
+    }
+
+    return IMU_REJ_COUNT;
+}
+
+static void accept_sample(imu_sample_t *s, int64_t now_ms)
+{
+    ref = *s;
+    ref_time_ms = now_ms;
+    has_ref = true;
+    consec_rejects = 0;
+
+    accel_hist[0][accel_hist_idx] = s->ax;
+    accel_hist[1][accel_hist_idx] = s->ay;
+    accel_hist[2][accel_hist_idx] = s->az;
+    accel_hist_idx = (accel_hist_idx + 1) % 3;
+    if (accel_hist_len < 3) {
+        accel_hist_len++;
+    }
+
+    if (accel_hist_len == 3) {
+        s->ax = median3(accel_hist[0][0], accel_hist[0][1], accel_hist[0][2]);
+        s->ay = median3(accel_hist[1][0], accel_hist[1][1], accel_hist[1][2]);
+        s->az = median3(accel_hist[2][0], accel_hist[2][1], accel_hist[2][2]);
+    }
+}
+
+void imu_validate_reset(void)
+{
+    has_ref = false;
+    consec_rejects = 0;
+    accel_hist_len = 0;
+    accel_hist_idx = 0;
+}
+
+bool imu_validate(imu_sample_t *s, int64_t now_ms, enum imu_reject *reason)
+{
+    float dt = 0.0f;
+
+    if (has_ref && (now_ms - ref_time_ms) <= IMU_MAX_GAP_MS) {
+        dt = (float)(now_ms - ref_time_ms) * 0.001f;
+    }
+
+    enum imu_reject r = check_sample(s, dt);
+
+    /* Relational gates can lock out forever if the reference itself was
+     * bad or the sensor filter genuinely stepped (e.g. heading reset).
+     * After a run of rejections, trust the stateless gates and reseed. */
+    if (r == IMU_REJ_RATE_STEP || r == IMU_REJ_ATTITUDE_JUMP) {
+        if (consec_rejects >= IMU_MAX_CONSEC_REJECTS) {
+            r = IMU_REJ_COUNT;
+        }
+    }
+
+    if (r != IMU_REJ_COUNT) {
+        atomic_inc(&reject_count[r]);
+        consec_rejects++;
+        if (reason) {
+            *reason = r;
+        }
+        return false;
+    }
+
+    accept_sample(s, now_ms);
+    return true;
+}
+
+const char *imu_validate_reason_str(enum imu_reject reason)
+{
+    if (reason >= IMU_REJ_COUNT) {
+        return "none";
+    }
+    return reason_names[reason];
+}
+
+void imu_validate_get_stats(uint32_t out[IMU_REJ_COUNT])
+{
+    for (int i = 0; i < IMU_REJ_COUNT; i++) {
+        out[i] = (uint32_t)atomic_get(&reject_count[i]);
+    }
+}
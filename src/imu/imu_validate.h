@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* One decoded VN-100S register 239 sample */
+typedef struct {
+    float yaw, pitch, roll;   /* degrees */
+    float yr, pr, rr;         /* deg/s */
+    float ax, ay, az;         /* m/s^2, gravity compensated */
+} imu_sample_t;
+
+/* Rejection reasons — one counter per check */
+enum imu_reject {
+    IMU_REJ_NONFINITE = 0,   /* NaN/Inf anywhere in the frame */
+    IMU_REJ_RANGE,           /* attitude outside the VN-100S output range */
+    IMU_REJ_RATE_LIMIT,      /* angular rate above the physical limit */
+    IMU_REJ_RATE_STEP,       /* rate changed faster than max angular accel */
+    IMU_REJ_ATTITUDE_JUMP,   /* attitude delta disagrees with integrated rates */
+    IMU_REJ_ACCEL_LIMIT,     /* linear acceleration above the physical limit */
+    IMU_REJ_COUNT
+};
+
+/* Forget the reference sample (call after a sensor re-init) */
+void imu_validate_reset(void);
+
+/*
+ * Validate one sample against the previous accepted sample.
+ * On success the accelerations in *s are replaced by their 3-sample
+ * median and true is returned.  On failure *reason is set and the
+ * sample must be discarded.  Not thread-safe: call from the IMU task only.
+ */
+bool imu_validate(imu_sample_t *s, int64_t now_ms, enum imu_reject *reason);
+
+/* Short name of a rejection reason for log messages */
+const char *imu_validate_reason_str(enum imu_reject reason);
+
+/* Copy the per-check rejection counters (safe from any thread) */
+void imu_validate_get_stats(uint32_t out[IMU_REJ_COUNT]);
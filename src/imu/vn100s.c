@@ -4,9 +4,9 @@
 #include <zephyr/drivers/spi.h>
 #include <zephyr/logging/log.h>
 #include <string.h>
-#include <math.h>
 
 #include "vn100s.h"
+#include "imu_validate.h"
 
 LOG_MODULE_REGISTER(vn100s, LOG_LEVEL_INF);
 
@@ -26,6 +26,7 @@ static const struct spi_dt_spec vn_spi = SPI_DT_SPEC_GET(
 
 #define VN_INIT_RETRY_MS 10000
 #define VN_STALE_REINIT_MS 10000
+#define VN_REJECT_REPORT_MS 1000    /* at most one rejected-sample summary per interval */
 
 /* Register IDs */
 #define VN_REG_MODEL       1    /* Model string (24 bytes ASCII) */
@@ -157,17 +158,6 @@ static int vn100s_read_all(float *yaw, float *pitch, float *roll,
     return 0;
 }
 
-/* Reject NaN/Inf from SPI corruption — range checks are redundant
- * with the VN-100S onboard Kalman filter. */
-static bool vn_sane(float yaw, float pitch, float roll,
-                    float yr, float pr, float rr,
-                    float ax, float ay, float az)
-{
-    return isfinite(yaw) && isfinite(pitch) && isfinite(roll) &&
-           isfinite(yr)  && isfinite(pr)    && isfinite(rr)   &&
-           isfinite(ax)  && isfinite(ay)    && isfinite(az);
-}
-
 static float last_yaw, last_pitch, last_roll;
 static float last_yr, last_pr, last_rr;
 static float last_ax, last_ay, last_az;
@@ -201,6 +191,11 @@ bool vn100s_has_recent_sample(int64_t max_age_ms)
     return sample_time != 0 && (k_uptime_get() - sample_time) <= max_age_ms;
 }
 
+int64_t vn100s_get_sample_time(void)
+{
+    return last_sample_time;
+}
+
 /* Thread entry */
 
 void vn100s_task(void *p1, void *p2, void *p3)
@@ -215,6 +210,12 @@ void vn100s_task(void *p1, void *p2, void *p3)
     bool initialized = false;
     int err = 0;
 
+    /* Rejects since the last summary line */
+    uint32_t rejected = 0;
+    enum imu_reject last_reason = IMU_REJ_COUNT;
+    imu_sample_t last_rejected = { 0 };
+    int64_t next_report = 0;
+
     while (1) {
         if (!initialized) {
             err = vn100s_init(&dev);
@@ -225,32 +226,49 @@ void vn100s_task(void *p1, void *p2, void *p3)
                 continue;
             }
             initialized = true;
+            imu_validate_reset();
             last_sample_time = k_uptime_get();
         }
 
-        float yaw, pitch, roll, yr, pr, rr, ax, ay, az;
-        err = vn100s_read_all(&yaw, &pitch, &roll, &yr, &pr, &rr, &ax, &ay, &az);
+        imu_sample_t s;
+        err = vn100s_read_all(&s.yaw, &s.pitch, &s.roll,
+                              &s.yr, &s.pr, &s.rr,
+                              &s.ax, &s.ay, &s.az);
         if (!err) {
-            if (vn_sane(yaw, pitch, roll, yr, pr, rr, ax, ay, az)) {
-                last_yaw   = yaw;
-                last_pitch = pitch;
-                last_roll  = roll;
-                last_yr    = yr;
-                last_pr    = pr;
-                last_rr    = rr;
-                last_ax    = ax;
-                last_ay    = ay;
-                last_az    = az;
-                last_sample_time = k_uptime_get();
+            int64_t now = k_uptime_get();
+            enum imu_reject reason;
+
+            if (imu_validate(&s, now, &reason)) {
+                last_yaw   = s.yaw;
+                last_pitch = s.pitch;
+                last_roll  = s.roll;
+                last_yr    = s.yr;
+                last_pr    = s.pr;
+                last_rr    = s.rr;
+                last_ax    = s.ax;
+                last_ay    = s.ay;
+                last_az    = s.az;
+                last_sample_time = now;
             } else {
-                LOG_WRN("VN-100S: corrupt sample "
-                        "(y=%d p=%d r=%d)",
-                        (int)yaw, (int)pitch, (int)roll);
+                /* Only counted here: a run of bad frames at 20 Hz would
+                 * otherwise be a run of LOG_WRN formatting */
+                rejected++;
+                last_reason = reason;
+                last_rejected = s;
             }
         } else {
             LOG_ERR("VN-100S read err %d", err);
         }
 
+        if (rejected && k_uptime_get() >= next_report) {
+            LOG_WRN("VN-100S: %u sample(s) rejected, last (%s) (y=%d p=%d r=%d)",
+                    rejected, imu_validate_reason_str(last_reason),
+                    (int)last_rejected.yaw, (int)last_rejected.pitch,
+                    (int)last_rejected.roll);
+            rejected = 0;
+            next_report = k_uptime_get() + VN_REJECT_REPORT_MS;
+        }
+
         if ((k_uptime_get() - last_sample_time) > VN_STALE_REINIT_MS) {
             LOG_WRN("VN-100S has no valid data for %d s; reinitializing",
                     VN_STALE_REINIT_MS / 1000);
@@ -24,7 +24,46 @@ void vn100s_get_accel(float *ax, float *ay, float *az);
 /* True when a valid sample was received within max_age_ms. */
 bool vn100s_has_recent_sample(int64_t max_age_ms);
 
+/* Uptime (ms) of the latest valid sample, 0 before the first one */
+int64_t vn100s_get_sample_time(void);
+
 /* Thread entry for the IMU task */
 void vn100s_task(void *p1, void *p2, void *p3);
 
+#ifdef CONFIG_K2_EMUL
+#include "imu_validate.h"
+
+/* native_sim emulator controls (vn100s_emul.c) */
+
+enum vn100s_emul_fault {
+    VN_EMUL_FAULT_NONE = 0,
+    VN_EMUL_FAULT_BUS,          /* SPI transfer fails with -EIO */
+    VN_EMUL_FAULT_ERROR_BYTE,   /* sensor reports an error in the header */
+    VN_EMUL_FAULT_NAN,          /* payload decodes to NaN */
+    VN_EMUL_FAULT_YAW_JUMP,     /* finite garbage: +170 deg yaw */
+    VN_EMUL_FAULT_SILENT,       /* all-zero response (sensor not answering) */
+};
+
+struct vn100s_emul_stats {
+    uint32_t requests;          /* request-phase transfers */
+    uint32_t responses;         /* response-phase transfers */
+    uint32_t faults;            /* responses altered by fault injection */
+};
+
+/*
+ * Replay recorded samples instead of the built-in synthetic motion.
+ * The table is played back at period_ms per sample and loops.
+ * Pass NULL to return to synthetic data.
+ */
+void vn100s_emul_load(const imu_sample_t *samples, size_t count, uint32_t period_ms);
+
+/* Alter the next `count` responses with the given fault */
+void vn100s_emul_inject(enum vn100s_emul_fault fault, uint32_t count);
+
+/* Busy-wait this long inside every SPI transfer (models a slow bus) */
+void vn100s_emul_set_delay_us(uint32_t delay_us);
+
+void vn100s_emul_get_stats(struct vn100s_emul_stats *out);
+#endif
+
 #endif /* VN100S_H */
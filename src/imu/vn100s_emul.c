@@ -0,0 +1,254 @@
+/*
+ * VN-100S SPI emulator for native_sim.
+ *
+ * Implements the two-phase VN-100S SPI register protocol on the
+ * zephyr,spi-emul-controller bus so vn100s.c runs unmodified off-target:
+ *
+ *   Request phase:  [cmd, reg_id, 0x00, 0x00]            (write only)
+ *   Response phase: [0x00, cmd, reg_id, error, payload]  (transceive)
+ *
+ * Register 1 (model) and register 239 (YPR, rates, linear accel) are
+ * served; any other register answers with error 8 (invalid register).
+ * Data comes from a built-in synthetic motion (slow yaw sweep with
+ * pitch/roll oscillation and matching rates) or from a table loaded with
+ * vn100s_emul_load(), which src/sim/imu_replay.c fills from a recording
+ * with CONFIG_K2_EMUL_IMU_REPLAY.  Faults and bus delays can be injected
+ * at run time.
+ */
+
+#define DT_DRV_COMPAT vectornav_vn100s
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/drivers/spi_emul.h>
+#include <math.h>
+#include <string.h>
+
+#include "vn100s.h"
+
+#define VN_CMD_READ          0x01
+#define VN_REG_MODEL         1
+#define VN_REG_YPR_RATE_AC   239
+
+#define VN_ERR_HARD_FAULT    1
+#define VN_ERR_INVALID_REG   8
+
+#define VN_MODEL_STRING      "VN-100S-EMUL"
+#define VN_MAX_PAYLOAD       48
+
+#define TWO_PI               6.2831853f
+
+static struct k_spinlock emul_lock;
+
+static struct {
+    uint8_t req_cmd;
+    uint8_t req_reg;
+
+    const imu_sample_t *table;
+    size_t table_len;
+    uint32_t table_period_ms;
+
+    enum vn100s_emul_fault fault;
+    uint32_t fault_remaining;
+    uint32_t delay_us;
+
+    struct vn100s_emul_stats stats;
+} emul_state;
+
+/* Smooth motion with self-consistent attitude and rates */
+static void synthetic_sample(float t, imu_sample_t *s)
+{
+    const float f_yaw = 0.05f, f_pitch = 0.2f, f_roll = 0.15f, f_surge = 0.1f;
+    const float a_yaw = 120.0f, a_pitch = 5.0f, a_roll = 8.0f;
+
+    float yaw = a_yaw * sinf(TWO_PI * f_yaw * t);
+
+    s->yaw   = yaw - 360.0f * floorf((yaw + 180.0f) / 360.0f);
+    s->pitch = a_pitch * sinf(TWO_PI * f_pitch * t);
+    s->roll  = a_roll * sinf(TWO_PI * f_roll * t + 1.0f);
+    s->yr    = a_yaw * TWO_PI * f_yaw * cosf(TWO_PI * f_yaw * t);
+    s->pr    = a_pitch * TWO_PI * f_pitch * cosf(TWO_PI * f_pitch * t);
+    s->rr    = a_roll * TWO_PI * f_roll * cosf(TWO_PI * f_roll * t + 1.0f);
+    s->ax    = 0.2f * sinf(TWO_PI * f_surge * t);
+    s->ay    = 0.05f * cosf(TWO_PI * f_surge * t);
+    s->az    = 0.0f;
+}
+
+static void current_sample(imu_sample_t *s)
+{
+    int64_t now = k_uptime_get();
+
+    if (emul_state.table && emul_state.table_len > 0) {
+        size_t idx = (size_t)(now / emul_state.table_period_ms) % emul_state.table_len;
+        *s = emul_state.table[idx];
+    } else {
+        synthetic_sample((float)now * 0.001f, s);
+    }
+}
+
+static void put_float(uint8_t *dst, float v)
+{
+    memcpy(dst, &v, sizeof(v));   /* VN-100S sends little-endian, as does native_sim */
+}
+
+/* Build the response to the latched request; returns payload length */
+static size_t build_response(uint8_t *resp, enum vn100s_emul_fault fault)
+{
+    size_t len = 0;
+
+    resp[0] = 0x00;
+    resp[1] = emul_state.req_cmd;
+    resp[2] = emul_state.req_reg;
+    resp[3] = 0x00;
+
+    if (emul_state.req_cmd != VN_CMD_READ) {
+        resp[3] = VN_ERR_INVALID_REG;
+    } else if (emul_state.req_reg == VN_REG_MODEL) {
+        len = 24;
+        memset(&resp[4], 0, len);
+        memcpy(&resp[4], VN_MODEL_STRING, sizeof(VN_MODEL_STRING) - 1);
+    } else if (emul_state.req_reg == VN_REG_YPR_RATE_AC) {
+        imu_sample_t s;
+
+        current_sample(&s);
+        if (fault == VN_EMUL_FAULT_YAW_JUMP) {
+            s.yaw += (s.yaw > 0.0f) ? -170.0f : 170.0f;
+        } else if (fault == VN_EMUL_FAULT_NAN) {
+            s.pitch = NAN;
+        }
+
+        const float vals[9] = { s.yaw, s.pitch, s.roll, s.yr, s.pr, s.rr,
+                                s.ax, s.ay, s.az };
+        for (int i = 0; i < 9; i++) {
+            put_float(&resp[4 + 4 * i], vals[i]);
+        }
+        len = 36;
+    } else {
+        resp[3] = VN_ERR_INVALID_REG;
+    }
+
+    if (fault == VN_EMUL_FAULT_ERROR_BYTE) {
+        resp[3] = VN_ERR_HARD_FAULT;
+    } else if (fault == VN_EMUL_FAULT_SILENT) {
+        memset(resp, 0, 4 + len);
+    }
+    return len;
+}
+
+static size_t bufs_len(const struct spi_buf_set *set)
+{
+    size_t total = 0;
+
+    for (size_t i = 0; set && i < set->count; i++) {
+        total += set->buffers[i].len;
+    }
+    return total;
+}
+
+static int vn100s_emul_io(const struct emul *target, const struct spi_config *config,
+                          const struct spi_buf_set *tx_bufs,
+                          const struct spi_buf_set *rx_bufs)
+{
+    ARG_UNUSED(target);
+    ARG_UNUSED(config);
+
+    k_spinlock_key_t key = k_spin_lock(&emul_lock);
+
+    uint32_t delay_us = emul_state.delay_us;
+    enum vn100s_emul_fault fault = VN_EMUL_FAULT_NONE;
+    if (emul_state.fault_remaining > 0) {
+        fault = emul_state.fault;
+        emul_state.fault_remaining--;
+        emul_state.stats.faults++;
+    }
+
+    int ret = 0;
+
+    if (fault == VN_EMUL_FAULT_BUS) {
+        ret = -EIO;
+    } else if (bufs_len(rx_bufs) == 0) {
+        /* Request phase: latch command and register */
+        const struct spi_buf *b = tx_bufs && tx_bufs->count ? &tx_bufs->buffers[0] : NULL;
+        if (b && b->buf && b->len >= 2) {
+            const uint8_t *req = b->buf;
+            emul_state.req_cmd = req[0];
+            emul_state.req_reg = req[1];
+        }
+        emul_state.stats.requests++;
+    } else {
+        /* Response phase: scatter the response over the rx buffers */
+        uint8_t resp[4 + VN_MAX_PAYLOAD];
+        size_t resp_len = 4 + build_response(resp, fault);
+        size_t off = 0;
+
+        for (size_t i = 0; i < rx_bufs->count; i++) {
+            const struct spi_buf *b = &rx_bufs->buffers[i];
+            if (!b->buf) {
+                off += b->len;
+                continue;
+            }
+            for (size_t j = 0; j < b->len; j++, off++) {
+                ((uint8_t *)b->buf)[j] = (off < resp_len) ? resp[off] : 0x00;
+            }
+        }
+        emul_state.stats.responses++;
+    }
+
+    k_spin_unlock(&emul_lock, key);
+
+    if (delay_us) {
+        k_busy_wait(delay_us);
+    }
+    return ret;
+}
+
+void vn100s_emul_load(const imu_sample_t *samples, size_t count, uint32_t period_ms)
+{
+    k_spinlock_key_t key = k_spin_lock(&emul_lock);
+    emul_state.table = samples;
+    emul_state.table_len = samples ? count : 0;
+    emul_state.table_period_ms = MAX(period_ms, 1U);
+    k_spin_unlock(&emul_lock, key);
+}
+
+void vn100s_emul_inject(enum vn100s_emul_fault fault, uint32_t count)
+{
+    k_spinlock_key_t key = k_spin_lock(&emul_lock);
+    emul_state.fault = fault;
+    emul_state.fault_remaining = (fault == VN_EMUL_FAULT_NONE) ? 0 : count;
+    k_spin_unlock(&emul_lock, key);
+}
+
+void vn100s_emul_set_delay_us(uint32_t delay_us)
+{
+    emul_state.delay_us = delay_us;
+}
+
+void vn100s_emul_get_stats(struct vn100s_emul_stats *out)
+{
+    k_spinlock_key_t key = k_spin_lock(&emul_lock);
+    *out = emul_state.stats;
+    k_spin_unlock(&emul_lock, key);
+}
+
+static int vn100s_emul_init(const struct emul *target, const struct device *parent)
+{
+    ARG_UNUSED(target);
+    ARG_UNUSED(parent);
+    return 0;
+}
+
+static const struct spi_emul_api vn100s_emul_api = {
+    .io = vn100s_emul_io,
+};
+
+/* vn100s.c talks to the bus directly rather than through a Zephyr device,
+ * but the emulator framework needs one bound to the node. */
+#define VN100S_EMUL(n)                                                         \
+    DEVICE_DT_INST_DEFINE(n, NULL, NULL, NULL, NULL, POST_KERNEL,              \
+                          CONFIG_KERNEL_INIT_PRIORITY_DEVICE, NULL);           \
+    EMUL_DT_INST_DEFINE(n, vn100s_emul_init, NULL, NULL, &vn100s_emul_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(VN100S_EMUL)
@@ -15,7 +15,6 @@
 #include <zephyr/kernel.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/logging/log.h>
-#include <zephyr/net/socket.h> // added for zsock_close
 #include <zephyr/drivers/uart.h>
 #include <stdint.h>
 #include "net/net.h"
@@ -26,15 +25,12 @@
 #include "vesc/vesc_uart_zephyr.h"
 #include "pid/pid_config.h"
 #include "imu/axis_config.h"
-#include "net/control_telemetry.h"
-#include "net/setpoint_override.h"
-#include "net/system_control.h"
+#include "net/telemetry.h"
+#include "net/udp_dispatch.h"
 #include "net/ota_confirm.h"
+#include "net/log_backend_udp.h"
 #include "display/oled.h"
 
-/* Defined in net/log_backend_udp.c */
-void log_backend_udp_topside_start(void);
-
 // Register this source file as a log module named "k2_app" with INFO level
 // This allows us to use LOG_INF(), LOG_ERR(), etc. in our code
 LOG_MODULE_REGISTER(k2_app, LOG_LEVEL_INF);
@@ -72,32 +68,15 @@ int main(void)
     // Start ROV control thread
     rov_control_start();
 
-    // Start resource monitor thread
-    resource_monitor_start();
-
     // Start OLED display updater
     display_start();
 
-    // Start IMU sensor telemetry sender
-    sensor_sender_start();
-
-    // Start UDP server thread
-    udp_server_start();
-
-    // Start PID config listener
-    pid_config_start();
-
-    // Start axis config listener
-    axis_config_start();
+    // Start UDP dispatcher (command, PID/axis config, setpoint override,
+    // system control)
+    udp_dispatch_start();
 
-    // Start control telemetry sender
-    control_telemetry_start();
-
-    // Start setpoint override listener
-    setpoint_override_start();
-
-    // Start system control listener
-    system_control_start();
+    // Start telemetry multiplexer (IMU, control, resource channels)
+    telemetry_start();
 
     // Confirm a trial MCUboot image only after the app and network come up
     ota_confirm_init();
@@ -129,10 +108,6 @@ int main(void)
         // Sleep for 10 seconds (longer interval for status updates)
         k_sleep(K_SECONDS(10));
     }
-    
-    // Cleanup (never reached in embedded systems)
-    if (udp_sock >= 0) {
-        zsock_close(udp_sock);
-    }
+
     return 0;
 }
@@ -0,0 +1,80 @@
+#include "lever_arm.h"
+
+#define DEG2RAD 0.017453293f
+
+static inline void cross3(const float a[3], const float b[3], float out[3])
+{
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+void lever_arm_init(lever_arm_t *la, float alpha_tau)
+{
+    la->offset_mm.x = 0.0f;
+    la->offset_mm.y = 0.0f;
+    la->offset_mm.z = 0.0f;
+    for (int i = 0; i < 3; i++) {
+        la->r[i] = 0.0f;
+        la->w_prev[i] = 0.0f;
+        la->alpha[i] = 0.0f;
+    }
+    la->active = false;
+    la->alpha_tau = alpha_tau;
+    la->has_prev = false;
+}
+
+void lever_arm_set_offset(lever_arm_t *la, const imu_offset_t *off)
+{
+    if (off->x == la->offset_mm.x && off->y == la->offset_mm.y &&
+        off->z == la->offset_mm.z) {
+        return;
+    }
+
+    /* The configured offset points from the IMU to the CoM; r is the
+     * opposite vector, from the CoM to the IMU. */
+    la->offset_mm = *off;
+    la->r[0] = -off->x * 0.001f;
+    la->r[1] = -off->y * 0.001f;
+    la->r[2] = -off->z * 0.001f;
+    la->active = (off->x != 0.0f || off->y != 0.0f || off->z != 0.0f);
+}
+
+void lever_arm_compensate(lever_arm_t *la, const float rates_dps[3], float dt,
+                          float accel[3])
+{
+    float w[3] = {
+        rates_dps[0] * DEG2RAD,
+        rates_dps[1] * DEG2RAD,
+        rates_dps[2] * DEG2RAD,
+    };
+
+    /* Keep the alpha filter running even with zero offset so it is
+     * settled if an offset is configured in flight. */
+    if (dt > 0.0f) {
+        if (la->has_prev) {
+            float k = dt / (la->alpha_tau + dt);
+            for (int i = 0; i < 3; i++) {
+                float raw = (w[i] - la->w_prev[i]) / dt;
+                la->alpha[i] += k * (raw - la->alpha[i]);
+            }
+        }
+        for (int i = 0; i < 3; i++) {
+            la->w_prev[i] = w[i];
+        }
+        la->has_prev = true;
+    }
+
+    if (!la->active) {
+        return;
+    }
+
+    float wxr[3], centripetal[3], tangential[3];
+    cross3(w, la->r, wxr);
+    cross3(w, wxr, centripetal);
+    cross3(la->alpha, la->r, tangential);
+
+    for (int i = 0; i < 3; i++) {
+        accel[i] -= centripetal[i] + tangential[i];
+    }
+}
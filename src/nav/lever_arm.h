@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdbool.h>
+#include "../imu/axis_config.h"
+
+/*
+ * Lever-arm compensation for an IMU mounted away from the centre of mass.
+ *
+ * A rigid body's acceleration at the IMU position r (body frame) is
+ *
+ *   a_imu = a_cm + alpha x r + omega x (omega x r)
+ *
+ * so the translational acceleration at the CoM is recovered by removing
+ * the tangential (alpha x r) and centripetal (omega x (omega x r)) terms.
+ * omega comes straight from the gyro; alpha is the gyro rate
+ * differentiated and low-pass filtered, since a raw derivative of a
+ * 50 Hz gyro sample is mostly noise.
+ */
+
+typedef struct {
+    imu_offset_t offset_mm;   /* last offset seen, to detect config changes */
+    float r[3];               /* IMU position relative to the CoM, m (x, y, z) */
+    bool  active;             /* r is non-zero */
+
+    float w_prev[3];          /* previous body rates, rad/s */
+    float alpha[3];           /* filtered angular acceleration, rad/s^2 */
+    float alpha_tau;          /* low-pass time constant, s */
+    bool  has_prev;
+} lever_arm_t;
+
+/**
+ * @brief Initialize with zero offset
+ *
+ * @param alpha_tau  Angular-acceleration filter time constant, s
+ */
+void lever_arm_init(lever_arm_t *la, float alpha_tau);
+
+/**
+ * @brief Load the IMU offset (mm, from axis_config_get_offset())
+ *
+ * Cheap to call every cycle: the offset is only converted to metres
+ * when it differs from the one already loaded.
+ */
+void lever_arm_set_offset(lever_arm_t *la, const imu_offset_t *off);
+
+/**
+ * @brief Remove the lever-arm terms from a body-frame acceleration
+ *
+ * @param la         State
+ * @param rates_dps  Body rates about x, y, z (roll, pitch, yaw rate), deg/s
+ * @param dt         Time since the previous call, s
+ * @param accel      Acceleration at the IMU (m/s^2), corrected in place
+ */
+void lever_arm_compensate(lever_arm_t *la, const float rates_dps[3], float dt,
+                          float accel[3]);
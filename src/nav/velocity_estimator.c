@@ -0,0 +1,91 @@
+#include "velocity_estimator.h"
+
+#define VEL_EST_INIT_P_V     0.01f    /* (0.1 m/s)^2 — starts at rest */
+#define VEL_EST_INIT_P_BIAS  0.04f    /* (0.2 m/s^2)^2 */
+
+static inline float clampf(float v, float lo, float hi)
+{
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return v;
+}
+
+static inline float absf(float v)
+{
+    return v < 0.0f ? -v : v;
+}
+
+void vel_est_init(vel_est_t *e, const vel_est_params_t *params)
+{
+    e->params = *params;
+    e->bias = 0.0f;
+    e->p11 = VEL_EST_INIT_P_BIAS;
+    vel_est_reset(e);
+}
+
+void vel_est_reset(vel_est_t *e)
+{
+    e->v = 0.0f;
+    e->v_model = 0.0f;
+    e->p00 = VEL_EST_INIT_P_V;
+    e->p01 = 0.0f;
+}
+
+/* Scalar velocity measurement: H = [1 0] */
+static void kf_update(vel_est_t *e, float z, float r)
+{
+    float s = e->p00 + r;
+    if (s <= 0.0f) {
+        return;
+    }
+
+    float k0 = e->p00 / s;
+    float k1 = e->p01 / s;
+    float y = z - e->v;
+
+    e->v += k0 * y;
+    e->bias = clampf(e->bias + k1 * y, -e->params.bias_limit, e->params.bias_limit);
+
+    float p00 = e->p00, p01 = e->p01;
+    e->p00 = (1.0f - k0) * p00;
+    e->p01 = (1.0f - k0) * p01;
+    e->p11 -= k1 * p01;
+}
+
+float vel_est_step(vel_est_t *e, float accel, float command, float dt)
+{
+    if (dt <= 0.0f) {
+        return e->v;
+    }
+
+    const vel_est_params_t *p = &e->params;
+
+    /* Thrust/drag model, propagated open-loop so it stays independent
+     * of the accelerometer it is used to correct. */
+    float a_model = p->thrust_accel * clampf(command, -1.0f, 1.0f) -
+                    p->drag_coeff * e->v_model * absf(e->v_model);
+    e->v_model += a_model * dt;
+
+    /* Predict: F = [1 -dt; 0 1], Q = diag(qa * dt^2, qb * dt) */
+    e->v += (accel - e->bias) * dt;
+
+    float qa = p->accel_noise * p->accel_noise * dt * dt;
+    float qb = p->bias_walk * p->bias_walk * dt;
+    float p00 = e->p00 - 2.0f * dt * e->p01 + dt * dt * e->p11 + qa;
+    float p01 = e->p01 - dt * e->p11;
+    e->p00 = p00;
+    e->p01 = p01;
+    e->p11 += qb;
+
+    kf_update(e, e->v_model, p->model_sigma * p->model_sigma);
+
+    return e->v;
+}
+
+void vel_est_update_velocity(vel_est_t *e, float v_meas, float sigma)
+{
+    kf_update(e, v_meas, sigma * sigma);
+
+    /* A real velocity fix is better than the open-loop model; re-anchor it */
+    e->v_model = e->v;
+}
@@ -0,0 +1,218 @@
+/*
+ * Control Stream — every control cycle, decimated and rate-capped.
+ *
+ * control_telemetry.c samples the loop at 10 Hz, so anything above 5 Hz
+ * in the PID response aliases.  Here the control thread writes each
+ * 50 Hz snapshot into a ring (a few dozen bytes under a spinlock) and the
+ * telemetry thread drains it every CTRL_STREAM_DIVIDER ticks, so every
+ * cycle reaches topside either as-is or through an averaging decimator.
+ *
+ * The ring overwrites its oldest entry when the reader falls behind;
+ * lost samples are counted and reported in every record so topside can
+ * tell a gap from a quiet signal.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+#include "control_stream.h"
+#include "net.h"
+#include "telemetry.h"
+
+LOG_MODULE_REGISTER(ctrl_stream, LOG_LEVEL_INF);
+
+#define RING_LEN            64        /* 1.28 s of control cycles */
+#define CTRL_STREAM_DIVIDER 5         /* drain every 100 ms (5 control cycles) */
+#define DECIMATION          CONFIG_K2_CTRL_STREAM_DECIMATION
+#define MAX_BPS             CONFIG_K2_CTRL_STREAM_MAX_BPS
+
+/* Burst allowance: a quarter second of budget, but always one sample */
+#define BUCKET_DEPTH        MAX(MAX_BPS / 4, sizeof(ctrl_stream_header_t) + \
+                                             sizeof(ctrl_stream_sample_t))
+
+/* Samples are handled as flat float arrays in wire order */
+#define NUM_FIELDS          18
+BUILD_ASSERT(sizeof(ctrl_stream_sample_t) == NUM_FIELDS * sizeof(float));
+
+BUILD_ASSERT(RING_LEN >= DECIMATION + 2 * CTRL_STREAM_DIVIDER,
+             "ring must hold a decimation group plus two drain periods");
+
+struct ring_entry {
+    uint32_t cycle;
+    uint32_t ms;
+    float v[NUM_FIELDS];      /* setpoint[6], output[6], error[6] */
+};
+
+static struct k_spinlock ring_lock;
+static struct ring_entry ring[RING_LEN];
+static uint32_t ring_head;     /* total entries written */
+static uint32_t ring_tail;     /* total entries read */
+static uint32_t ring_dropped;
+
+/* Decimator state — telemetry thread only */
+static float acc[NUM_FIELDS];
+static uint32_t acc_n;
+static uint32_t acc_cycle;
+static uint32_t acc_ms;
+static uint32_t expect_cycle;
+
+/* Token bucket for the bandwidth cap, in bytes */
+static int64_t bucket_ms;
+static uint32_t bucket_bytes;
+
+static uint32_t cycle_count;
+
+void control_stream_push(const control_telemetry_t *snap)
+{
+    struct ring_entry e = {
+        .cycle = cycle_count++,
+        .ms    = (uint32_t)k_uptime_get(),
+    };
+    memcpy(&e.v[0], snap->setpoint, sizeof(snap->setpoint));
+    memcpy(&e.v[6], snap->output, sizeof(snap->output));
+    memcpy(&e.v[12], snap->error, sizeof(snap->error));
+
+    k_spinlock_key_t key = k_spin_lock(&ring_lock);
+    if (ring_head - ring_tail == RING_LEN) {
+        ring_tail++;
+        ring_dropped++;
+    }
+    ring[ring_head % RING_LEN] = e;
+    ring_head++;
+    k_spin_unlock(&ring_lock, key);
+}
+
+static bool ring_pop(struct ring_entry *out)
+{
+    k_spinlock_key_t key = k_spin_lock(&ring_lock);
+    bool ok = ring_head != ring_tail;
+    if (ok) {
+        *out = ring[ring_tail % RING_LEN];
+        ring_tail++;
+    }
+    k_spin_unlock(&ring_lock, key);
+    return ok;
+}
+
+static uint32_t ring_pending(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&ring_lock);
+    uint32_t n = ring_head - ring_tail;
+    k_spin_unlock(&ring_lock, key);
+    return n;
+}
+
+static void note_dropped(uint32_t n)
+{
+    k_spinlock_key_t key = k_spin_lock(&ring_lock);
+    ring_dropped += n;
+    k_spin_unlock(&ring_lock, key);
+}
+
+static void acc_add(const struct ring_entry *e)
+{
+    if (acc_n == 0) {
+        memset(acc, 0, sizeof(acc));
+        acc_cycle = e->cycle;
+        acc_ms = e->ms;
+    }
+    for (int i = 0; i < NUM_FIELDS; i++) {
+        acc[i] += e->v[i];
+    }
+    acc_n++;
+}
+
+static void acc_mean(float out[NUM_FIELDS])
+{
+    float k = 1.0f / (float)acc_n;
+
+    for (int i = 0; i < NUM_FIELDS; i++) {
+        out[i] = acc[i] * k;
+    }
+    acc_n = 0;
+}
+
+/* Refill the bucket and return how many samples it currently allows */
+static uint32_t bucket_allow(void)
+{
+    int64_t now = k_uptime_get();
+    int64_t refill = (now - bucket_ms) * MAX_BPS / 1000;
+
+    bucket_bytes = (uint32_t)MIN((int64_t)BUCKET_DEPTH, bucket_bytes + refill);
+    bucket_ms = now;
+
+    if (bucket_bytes <= sizeof(ctrl_stream_header_t)) {
+        return 0;
+    }
+    return (bucket_bytes - sizeof(ctrl_stream_header_t)) / sizeof(ctrl_stream_sample_t);
+}
+
+static size_t ctrl_stream_fill(uint8_t *buf, size_t max, uint32_t sequence)
+{
+    ARG_UNUSED(sequence);
+
+    ctrl_stream_header_t hdr = { .decimation = DECIMATION };
+    size_t room = (max - MIN(max, sizeof(hdr))) / sizeof(ctrl_stream_sample_t);
+    uint32_t limit = MIN(MIN(room, CTRL_STREAM_MAX_SAMPLES), bucket_allow());
+    uint8_t *out = buf + sizeof(hdr);
+    struct ring_entry e;
+
+    /* Over the cap: discard whole decimation groups so the backlog never
+     * grows past what the budget can carry; the gap is reported. */
+    uint32_t backlog = ring_pending();
+    if (backlog > (limit + 1) * DECIMATION) {
+        uint32_t excess = backlog - (limit + 1) * DECIMATION;
+        for (uint32_t i = 0; i < excess && ring_pop(&e); i++) {
+        }
+        note_dropped(excess);
+    }
+
+    while (hdr.count < limit && ring_pop(&e)) {
+        /* A gap in the cycle numbers restarts the average */
+        if (acc_n > 0 && e.cycle != expect_cycle) {
+            acc_n = 0;
+        }
+        expect_cycle = e.cycle + 1;
+
+        acc_add(&e);
+        if (acc_n < DECIMATION) {
+            continue;
+        }
+
+        if (hdr.count == 0) {
+            hdr.first_cycle = acc_cycle;
+            hdr.first_ms = acc_ms;
+        }
+        float s[NUM_FIELDS];
+        acc_mean(s);
+        memcpy(out, s, sizeof(s));
+        out += sizeof(s);
+        hdr.count++;
+    }
+
+    if (hdr.count == 0) {
+        return 0;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&ring_lock);
+    hdr.dropped = ring_dropped;
+    k_spin_unlock(&ring_lock, key);
+
+    memcpy(buf, &hdr, sizeof(hdr));
+
+    size_t len = out - buf;
+    bucket_bytes -= MIN(bucket_bytes, len);
+    return len;
+}
+
+const struct telem_channel control_stream_channel = {
+    .name        = "ctrl_stream",
+    .id          = TELEM_CH_CONTROL_STREAM,
+    .divider     = CTRL_STREAM_DIVIDER,
+    .legacy_port = CONTROL_STREAM_PORT,
+    .max_len     = sizeof(ctrl_stream_header_t) +
+                   CTRL_STREAM_MAX_SAMPLES * sizeof(ctrl_stream_sample_t),
+    .control     = true,
+    .fill        = ctrl_stream_fill,
+};
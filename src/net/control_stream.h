@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "../control.h"
+
+/*
+ * High-rate control telemetry (CONFIG_K2_CTRL_STREAM).
+ *
+ * The control loop pushes every cycle's snapshot into a ring; the
+ * telemetry thread drains it into control_stream_channel records, either
+ * one sample per cycle or averaged over CONFIG_K2_CTRL_STREAM_DECIMATION
+ * cycles, and never sends more than CONFIG_K2_CTRL_STREAM_MAX_BPS.
+ *
+ * Record layout (native byte order):
+ *   | first_cycle (4B)   control cycle number of the first sample
+ *   | first_ms (4B)      uptime of that cycle
+ *   | count (2B)         samples in this record
+ *   | decimation (1B)    control cycles per sample
+ *   | pad (1B)
+ *   | dropped (4B)       samples lost since boot (ring overflow or cap)
+ *   | count x ctrl_stream_sample_t
+ *
+ * Sample n covers cycles first_cycle + n*decimation onwards.  The
+ * average of decimation cycles is a boxcar (first-order CIC) filter:
+ * it nulls the bands that would otherwise alias onto DC and the
+ * multiples of the output rate.
+ */
+
+typedef struct {
+    uint32_t first_cycle;
+    uint32_t first_ms;
+    uint16_t count;
+    uint8_t  decimation;
+    uint8_t  _pad;
+    uint32_t dropped;
+} __attribute__((packed)) ctrl_stream_header_t;
+
+/* Axis order: [surge, sway, heave, roll, pitch, yaw] */
+typedef struct {
+    float setpoint[6];
+    float output[6];
+    float error[6];
+} __attribute__((packed)) ctrl_stream_sample_t;
+
+#define CTRL_STREAM_MAX_SAMPLES 16    /* per record; keeps one tick under the MTU */
+
+#ifdef CONFIG_K2_CTRL_STREAM
+/* Capture one control cycle.  Called from the control loop only. */
+void control_stream_push(const control_telemetry_t *snap);
+#else
+static inline void control_stream_push(const control_telemetry_t *snap)
+{
+    (void)snap;
+}
+#endif
@@ -2,17 +2,23 @@
 
 #include <stdint.h>
 
-/* Binary packet sent to topside at 10 Hz on CONTROL_TELEM_PORT.
+/* Binary record sent to topside at 10 Hz (control_telem_channel).
  * Floats are native byte order (little-endian on both STM32 and x86). */
 typedef struct {
-    uint32_t sequence;      /* network byte order */
+    uint32_t sequence;      /* telemetry tick, network byte order */
     float setpoint[6];      /* surge, sway, heave, roll, pitch, yaw */
     float output[6];        /* PID output [-1,+1] or passthrough */
     float error[6];         /* setpoint - measurement (0 when passthrough) */
     float manipulator_deg;  /* applied manipulator setpoint */
     uint16_t manipulator_pulse_us;
+    /* Command echo — topside RTT = now − cmd_topside_us − queue − age */
+    uint32_t cmd_sequence;      /* last applied command, network byte order */
+    uint64_t cmd_topside_us;    /* its v2 timestamp (0 for v1), network byte order */
+    uint32_t cmd_queue_us;      /* MCU receive → thruster apply, network byte order */
+    uint32_t cmd_age_us;        /* thruster apply → this snapshot, network byte order */
+    /* Link-loss failsafe */
+    uint8_t  failsafe_stage;    /* enum failsafe_stage */
+    uint8_t  _pad;
+    uint64_t failsafe_since_us; /* MCU uptime when entered, network byte order */
     uint32_t crc32;         /* IEEE 802.3, network byte order */
 } __attribute__((packed)) control_telem_packet_t;
-
-/* Start the control telemetry sender thread */
-void control_telemetry_start(void);
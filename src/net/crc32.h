@@ -0,0 +1,7 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Shared CRC32 (IEEE 802.3) — used by every UDP packet format */
+uint32_t crc32_calc(const void *data, size_t length);
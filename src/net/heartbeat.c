@@ -0,0 +1,89 @@
+/*
+ * Heartbeat — UDP service on HEARTBEAT_PORT (5014)
+ *
+ * Records the arrival time of every PING for the control loop's link
+ * supervision and answers with a PONG.  Only two atomics are shared
+ * with the control thread, so the handler never blocks it.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <string.h>
+
+#include "heartbeat.h"
+#include "net.h"
+#include "udp_dispatch.h"
+#include "../control.h"
+
+LOG_MODULE_REGISTER(heartbeat, LOG_LEVEL_INF);
+
+static atomic_t last_ping_ms;
+static atomic_t ping_seen;
+static atomic_t timeout_ms = ATOMIC_INIT(CONFIG_K2_HEARTBEAT_TIMEOUT_MS);
+
+int32_t heartbeat_age_ms(void)
+{
+    if (!atomic_get(&ping_seen)) {
+        return -1;
+    }
+    return (int32_t)(k_uptime_get_32() - (uint32_t)atomic_get(&last_ping_ms));
+}
+
+uint32_t heartbeat_timeout_ms(void)
+{
+    return (uint32_t)atomic_get(&timeout_ms);
+}
+
+static int heartbeat_handle(int sock, const uint8_t *data, size_t len,
+                            const struct sockaddr_in *from)
+{
+    ARG_UNUSED(len);
+
+    const heartbeat_packet_t *ping = (const heartbeat_packet_t *)data;
+
+    if (ping->type != HEARTBEAT_PING) {
+        LOG_WRN("Heartbeat: unknown packet type 0x%02X", ping->type);
+        return -ENOMSG;
+    }
+
+    atomic_set(&last_ping_ms, (atomic_val_t)k_uptime_get_32());
+    if (!atomic_set(&ping_seen, 1)) {
+        LOG_INF("Heartbeat from topside, link timeout %u ms",
+                (unsigned int)heartbeat_timeout_ms());
+    }
+
+    if (ping->timeout_ms != 0) {
+        uint16_t t = CLAMP(ping->timeout_ms, HEARTBEAT_TIMEOUT_MIN_MS,
+                           HEARTBEAT_TIMEOUT_MAX_MS);
+        if (atomic_set(&timeout_ms, t) != t) {
+            LOG_INF("Heartbeat link timeout set to %u ms", t);
+        }
+    }
+
+    int64_t since_us;
+    heartbeat_packet_t pong = {
+        .type       = HEARTBEAT_PONG,
+        .failsafe   = (uint8_t)control_get_failsafe(&since_us),
+        .timeout_ms = (uint16_t)heartbeat_timeout_ms(),
+        .sequence   = ping->sequence,
+        .topside_us = ping->topside_us,
+    };
+    pong.failsafe_since_us = since_us;
+    pong.mcu_us = control_uptime_us();
+    pong.crc32 = crc32_calc(&pong, sizeof(pong) - sizeof(pong.crc32));
+
+    net_port_sendto(NET_PORT_HEARTBEAT, sock, &pong, sizeof(pong), 0, from);
+    return 0;
+}
+
+const struct udp_service heartbeat_service = {
+    .name     = "Heartbeat",
+    .port     = HEARTBEAT_PORT,
+    .min_len  = sizeof(heartbeat_packet_t),
+    .max_len  = sizeof(heartbeat_packet_t),
+    .crc      = UDP_CRC_NATIVE,
+    .handler  = heartbeat_handle,
+    .counters = NET_PORT_HEARTBEAT,
+    .priority = NET_PRIO_CONTROL,
+};
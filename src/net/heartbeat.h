@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Topside ↔ MCU heartbeat on HEARTBEAT_PORT.
+ *
+ * Topside sends a PING several times per timeout (e.g. every 100 ms),
+ * independent of joystick traffic; the MCU answers each with a PONG
+ * carrying its failsafe stage, so both ends see the link.  Once a PING
+ * has arrived, the control loop treats the link as lost when none has
+ * arrived for the active timeout, and runs the staged failsafe in
+ * control.c.  Consoles that never send a heartbeat keep the plain
+ * command timeout.
+ *
+ * All fields native byte order (little-endian).
+ */
+
+#define HEARTBEAT_PING  0x01
+#define HEARTBEAT_PONG  0x02
+
+#define HEARTBEAT_TIMEOUT_MIN_MS  100
+#define HEARTBEAT_TIMEOUT_MAX_MS  2000
+
+typedef struct {
+    uint8_t  type;
+    uint8_t  failsafe;           /* PONG: enum failsafe_stage */
+    uint16_t timeout_ms;         /* PING: requested, 0 = default; PONG: active */
+    uint32_t sequence;           /* echoed in the PONG */
+    int64_t  topside_us;         /* PING send time, echoed in the PONG */
+    int64_t  mcu_us;             /* PONG: MCU uptime (us) when sent */
+    int64_t  failsafe_since_us;  /* PONG: MCU uptime (us) of the last stage change */
+    uint32_t crc32;
+} __attribute__((packed)) heartbeat_packet_t;
+
+/* Milliseconds since the last PING, or -1 if none has arrived since boot */
+int32_t heartbeat_age_ms(void);
+
+/* Active link-loss timeout (ms) */
+uint32_t heartbeat_timeout_ms(void);
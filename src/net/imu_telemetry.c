@@ -0,0 +1,52 @@
+/*
+ * IMU telemetry encoders.
+ *
+ * Kept free of Zephyr headers so tools/imu_telem_bench.c can build the
+ * exact encoders the sender thread uses.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "imu_telemetry.h"
+#include "crc32.h"
+
+_Static_assert(sizeof(imu_telem_packet_t) == 76, "IMU telemetry packet size changed");
+
+size_t imu_telem_encode_binary(imu_telem_packet_t *pkt, const imu_sample_t *s,
+                               const uint32_t rejects[IMU_REJ_COUNT],
+                               uint32_t sequence, uint32_t sample_ms, uint8_t flags)
+{
+    pkt->version   = IMU_TELEM_VERSION;
+    pkt->flags     = flags;
+    pkt->length    = sizeof(*pkt);
+    pkt->sequence  = sequence;
+    pkt->sample_ms = sample_ms;
+
+    pkt->ypr[0]   = s->yaw;
+    pkt->ypr[1]   = s->pitch;
+    pkt->ypr[2]   = s->roll;
+    pkt->rates[0] = s->yr;
+    pkt->rates[1] = s->pr;
+    pkt->rates[2] = s->rr;
+    pkt->accel[0] = s->ax;
+    pkt->accel[1] = s->ay;
+    pkt->accel[2] = s->az;
+    memcpy(pkt->rejects, rejects, sizeof(pkt->rejects));
+
+    pkt->crc32 = crc32_calc(pkt, sizeof(*pkt) - sizeof(pkt->crc32));
+    return sizeof(*pkt);
+}
+
+int imu_telem_encode_json(char *buf, size_t size, const imu_sample_t *s)
+{
+    int len = snprintf(buf, size,
+        "{\"imu\":{\"yaw\":%.2f,\"pitch\":%.2f,\"roll\":%.2f,"
+        "\"yr\":%.2f,\"pr\":%.2f,\"rr\":%.2f,"
+        "\"ax\":%.3f,\"ay\":%.3f,\"az\":%.3f}}",
+        (double)s->yaw, (double)s->pitch, (double)s->roll,
+        (double)s->yr, (double)s->pr, (double)s->rr,
+        (double)s->ax, (double)s->ay, (double)s->az);
+
+    return (len < (int)size) ? len : -1;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../imu/imu_validate.h"
+
+/*
+ * IMU telemetry on SENSOR_PORT (5002).
+ *
+ * Binary packet layout (76 bytes, little-endian):
+ *   | version (1B) | flags (1B) | length (2B) | sequence (4B)
+ *   | sample_ms (4B)                     uptime of the VN-100S sample
+ *   | yaw | pitch | roll (3 x 4B float)  degrees
+ *   | yr  | pr    | rr   (3 x 4B float)  deg/s
+ *   | ax  | ay    | az   (3 x 4B float)  m/s^2
+ *   | rejects (6 x 4B)                   v2: samples rejected since boot,
+ *                                        per check in enum imu_reject order
+ *   | crc32 (4B)                         over all preceding bytes
+ *
+ * length is the total packet size so newer versions can append fields;
+ * a decoder accepts any version it knows and ignores trailing bytes it
+ * does not.  With CONFIG_K2_IMU_TELEM_JSON the legacy JSON text is sent
+ * instead (first byte '{', so a decoder can tell the two apart); it has
+ * no reject counters.
+ */
+
+#define IMU_TELEM_VERSION     2
+
+#define IMU_TELEM_FLAG_FRESH  0x01   /* sample newer than IMU_TELEM_FRESH_MS */
+
+#define IMU_TELEM_FRESH_MS    100
+
+typedef struct {
+    uint8_t  version;
+    uint8_t  flags;
+    uint16_t length;
+    uint32_t sequence;
+    uint32_t sample_ms;
+    float    ypr[3];
+    float    rates[3];
+    float    accel[3];
+    uint32_t rejects[IMU_REJ_COUNT];
+    uint32_t crc32;
+} __attribute__((packed)) imu_telem_packet_t;
+
+/* Largest JSON document imu_telem_encode_json() produces */
+#define IMU_TELEM_JSON_MAX    256
+
+/* Fill *pkt from one sample and the rejection counters; returns the packet length */
+size_t imu_telem_encode_binary(imu_telem_packet_t *pkt, const imu_sample_t *s,
+                               const uint32_t rejects[IMU_REJ_COUNT],
+                               uint32_t sequence, uint32_t sample_ms, uint8_t flags);
+
+/* Legacy JSON encoding; returns the string length or a negative value */
+int imu_telem_encode_json(char *buf, size_t size, const imu_sample_t *s);
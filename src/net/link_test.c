@@ -0,0 +1,323 @@
+/*
+ * Link self-test — echo, sink and source on LINK_TEST_PORT (5015)
+ *
+ * Not a dispatcher service: the dispatcher is a cooperative thread above
+ * the control loop, and a throughput test must never be able to delay a
+ * control cycle.  This module owns a preemptible thread at
+ * LINK_TEST_PRIORITY, which only runs when no cooperative thread wants
+ * the CPU, and a socket in the bulk TX class.  The socket is opened
+ * when the test is enabled and closed again when it times out, so the
+ * disabled test costs a sleeping thread and nothing on the network.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <string.h>
+
+#include "link_test.h"
+#include "net.h"
+#include "net_counters.h"
+#include "../control.h"
+
+LOG_MODULE_REGISTER(link_test, LOG_LEVEL_INF);
+
+#define LINK_TEST_STACK_SIZE 2048
+#define LINK_TEST_PRIORITY   12      /* preemptible: below every control thread */
+#define LINK_TEST_IDLE_MS    100     /* poll timeout while nothing is sourced */
+#define LINK_TEST_BATCH      16      /* datagrams handled or sent per wake-up */
+
+static atomic_t enabled_until_ms;    /* 0 = disabled */
+static K_SEM_DEFINE(link_test_wake, 0, 1);
+
+static uint8_t rx_buf[LINK_TEST_MAX_LEN] __aligned(4);
+static uint8_t tx_buf[LINK_TEST_MAX_LEN] __aligned(4);
+
+static link_test_stats_t stats;
+static uint32_t sink_next_seq;
+
+/* Active SOURCE_REQ; count == 0 when idle */
+static struct {
+    struct sockaddr_in dest;
+    uint16_t length;
+    uint32_t count;
+    uint32_t rate_pps;
+    uint32_t sent;
+    int64_t  start_us;
+} source;
+
+void link_test_enable(uint32_t seconds)
+{
+    if (seconds == 0) {
+        atomic_set(&enabled_until_ms, 0);
+        return;
+    }
+
+    seconds = MIN(seconds, LINK_TEST_MAX_ENABLE_S);
+    uint32_t until = k_uptime_get_32() + seconds * 1000U;
+    /* 0 means disabled; a deadline landing on it just ends 1 ms later */
+    atomic_set(&enabled_until_ms, (atomic_val_t)(until ? until : 1));
+    k_sem_give(&link_test_wake);
+    LOG_INF("Link test enabled for %u s", seconds);
+}
+
+static bool link_test_active(void)
+{
+    uint32_t until = (uint32_t)atomic_get(&enabled_until_ms);
+
+    return until != 0 && (int32_t)(until - k_uptime_get_32()) > 0;
+}
+
+static void stats_reset(void)
+{
+    memset(&stats, 0, sizeof(stats));
+    sink_next_seq = 0;
+}
+
+static void header_seal(link_test_header_t *hdr)
+{
+    hdr->mcu_us = control_uptime_us();
+    hdr->crc32 = crc32_calc(hdr, sizeof(*hdr) - sizeof(hdr->crc32));
+}
+
+static void sink_count(const link_test_header_t *hdr)
+{
+    int64_t now = control_uptime_us();
+
+    if (stats.packets == 0) {
+        stats.first_us = now;
+    } else if (hdr->sequence > sink_next_seq) {
+        stats.lost += hdr->sequence - sink_next_seq;
+    } else if (hdr->sequence < sink_next_seq) {
+        stats.reordered++;
+        /* A late arrival was already counted as lost */
+        if (stats.lost) {
+            stats.lost--;
+        }
+    }
+    if (stats.packets == 0 || hdr->sequence >= sink_next_seq) {
+        sink_next_seq = hdr->sequence + 1;
+    }
+
+    stats.packets++;
+    stats.bytes += hdr->length;
+    stats.last_us = now;
+}
+
+/* Handle one validated datagram in rx_buf; returns a net_counters outcome */
+static int link_test_handle(int sock, size_t len, const struct sockaddr_in *from)
+{
+    const link_test_header_t *req = (const link_test_header_t *)rx_buf;
+    link_test_header_t *reply = (link_test_header_t *)tx_buf;
+    size_t reply_len = sizeof(*reply);
+
+    switch (req->type) {
+    case LINK_TEST_ECHO:
+        memcpy(tx_buf, rx_buf, len);
+        reply->type = LINK_TEST_ECHO_REPLY;
+        reply_len = len;
+        break;
+
+    case LINK_TEST_SINK:
+        sink_count(req);
+        return 0;
+
+    case LINK_TEST_REPORT_REQ:
+        *reply = *req;
+        reply->type = LINK_TEST_REPORT;
+        reply_len = sizeof(*reply) + sizeof(stats);
+        reply->length = (uint16_t)reply_len;
+        memcpy(&tx_buf[sizeof(*reply)], &stats, sizeof(stats));
+        break;
+
+    case LINK_TEST_RESET:
+        stats_reset();
+        return 0;
+
+    case LINK_TEST_SOURCE_REQ: {
+        link_test_source_t src;
+
+        if (len < sizeof(*req) + sizeof(src)) {
+            return -EINVAL;
+        }
+        memcpy(&src, &rx_buf[sizeof(*req)], sizeof(src));
+        source.dest     = *from;
+        source.length   = (uint16_t)len;
+        source.count    = src.count;
+        source.rate_pps = MIN(src.rate_pps, LINK_TEST_MAX_RATE_PPS);
+        source.sent     = 0;
+        source.start_us = control_uptime_us();
+        LOG_INF("Link test: sourcing %u x %u B at %u pkt/s", src.count,
+                source.length, source.rate_pps);
+        return 0;
+    }
+
+    default:
+        return -ENOMSG;
+    }
+
+    header_seal(reply);
+    net_port_sendto(NET_PORT_LINK_TEST, sock, tx_buf, reply_len, 0, from);
+    return 0;
+}
+
+static void link_test_recv(int sock)
+{
+    for (int n = 0; n < LINK_TEST_BATCH; n++) {
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+
+        int ret = zsock_recvfrom(sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT,
+                                 (struct sockaddr *)&from, &from_len);
+        if (ret < 0) {
+            if (errno != EAGAIN) {
+                net_counter_inc(NET_PORT_LINK_TEST, NET_CNT_RX_ERR);
+            }
+            return;
+        }
+
+        const link_test_header_t *hdr = (const link_test_header_t *)rx_buf;
+        size_t len = (size_t)ret;
+
+        if (len < LINK_TEST_MIN_LEN || hdr->length != len) {
+            net_counter_inc(NET_PORT_LINK_TEST, NET_CNT_SIZE);
+            continue;
+        }
+        if (!net_source_allowed(&from.sin_addr)) {
+            net_counter_inc(NET_PORT_LINK_TEST, NET_CNT_SOURCE);
+            continue;
+        }
+        if (crc32_calc(hdr, sizeof(*hdr) - sizeof(hdr->crc32)) != hdr->crc32) {
+            net_counter_inc(NET_PORT_LINK_TEST, NET_CNT_CRC);
+            continue;
+        }
+
+        int err = link_test_handle(sock, len, &from);
+        if (err == -ENOMSG) {
+            net_counter_inc(NET_PORT_LINK_TEST, NET_CNT_TYPE);
+        } else if (err < 0) {
+            net_counter_inc(NET_PORT_LINK_TEST, NET_CNT_REJECTED);
+        } else {
+            net_counter_rx(NET_PORT_LINK_TEST);
+        }
+    }
+}
+
+/*
+ * Send the SOURCE_DATA datagrams that are due.  Returns the poll timeout
+ * until the next one: 0 to come straight back, or the idle timeout.
+ */
+static int link_test_source(int sock)
+{
+    if (source.sent >= source.count) {
+        return LINK_TEST_IDLE_MS;
+    }
+
+    uint32_t due = source.count;
+    if (source.rate_pps) {
+        int64_t elapsed_us = control_uptime_us() - source.start_us;
+        due = (uint32_t)MIN((uint64_t)source.count,
+                            (uint64_t)elapsed_us * source.rate_pps / 1000000U + 1U);
+    }
+
+    link_test_header_t *hdr = (link_test_header_t *)tx_buf;
+    for (int n = 0; n < LINK_TEST_BATCH && source.sent < due; n++) {
+        memset(tx_buf, 0, source.length);
+        hdr->type     = LINK_TEST_SOURCE_DATA;
+        hdr->length   = source.length;
+        hdr->sequence = source.sent;
+        header_seal(hdr);
+
+        int ret = net_port_sendto(NET_PORT_LINK_TEST, sock, tx_buf, source.length,
+                                  ZSOCK_MSG_DONTWAIT, &source.dest);
+        if (ret < 0) {
+            /* TX queue full: back off a tick rather than drop the datagram */
+            return 1;
+        }
+        source.sent++;
+    }
+
+    if (source.sent >= source.count) {
+        LOG_INF("Link test: source done, %u datagrams", source.sent);
+        return LINK_TEST_IDLE_MS;
+    }
+    return (source.sent < due) ? 0 : 1;
+}
+
+static int link_test_open(void)
+{
+    int sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0) {
+        LOG_ERR("Failed to create link test socket: %d", errno);
+        return -errno;
+    }
+
+    struct sockaddr_in bind_addr = {
+        .sin_family = AF_INET,
+        .sin_addr.s_addr = INADDR_ANY,
+        .sin_port = htons(LINK_TEST_PORT),
+    };
+
+    if (zsock_bind(sock, (struct sockaddr *)&bind_addr, sizeof(bind_addr)) < 0) {
+        LOG_ERR("Failed to bind link test socket to port %d: %d", LINK_TEST_PORT, errno);
+        zsock_close(sock);
+        return -errno;
+    }
+
+    int err = net_socket_set_priority(sock, NET_PRIO_BULK);
+    if (err < 0) {
+        LOG_WRN("Link test: cannot set socket priority: %d", err);
+    }
+    return sock;
+}
+
+static void link_test_task(void *a, void *b, void *c)
+{
+    ARG_UNUSED(a); ARG_UNUSED(b); ARG_UNUSED(c);
+
+    while (1) {
+        k_sem_take(&link_test_wake, K_FOREVER);
+        if (!link_test_active() || !network_ready) {
+            continue;
+        }
+
+        int sock = link_test_open();
+        if (sock < 0) {
+            atomic_set(&enabled_until_ms, 0);
+            continue;
+        }
+
+        stats_reset();
+        source.count = 0;
+        LOG_INF("Link test listening on port %d", LINK_TEST_PORT);
+
+        struct zsock_pollfd pfd = { .fd = sock, .events = ZSOCK_POLLIN };
+        int timeout = LINK_TEST_IDLE_MS;
+        uint32_t gen = net_link_generation();
+
+        while (link_test_active() && gen == net_link_generation()) {
+            if (zsock_poll(&pfd, 1, timeout) > 0 && (pfd.revents & ZSOCK_POLLIN)) {
+                link_test_recv(sock);
+            }
+            timeout = link_test_source(sock);
+            if (timeout == 0) {
+                /* Equal-priority threads get a turn between bursts */
+                k_yield();
+            }
+        }
+
+        zsock_close(sock);
+        if (link_test_active()) {
+            /* Link bounced: re-open once it is back, stats start over */
+            while (!network_ready && link_test_active()) {
+                k_sleep(K_MSEC(LINK_TEST_IDLE_MS));
+            }
+            k_sem_give(&link_test_wake);
+            continue;
+        }
+        LOG_INF("Link test disabled (sink: %u packets, %u lost)", stats.packets, stats.lost);
+    }
+}
+
+K_THREAD_DEFINE(link_test_tid, LINK_TEST_STACK_SIZE, link_test_task, NULL, NULL, NULL,
+                LINK_TEST_PRIORITY, 0, 0);
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Tether link self-test on LINK_TEST_PORT (CONFIG_K2_LINK_TEST).
+ *
+ * Off at boot.  Topside enables it for a number of seconds with the
+ * system control "LNK1" command; it switches itself off again when that
+ * time runs out or on "LNK1" with 0 s.  While enabled a low-priority
+ * thread (below the control loop, bulk TX class) serves:
+ *
+ *   ECHO         → ECHO_REPLY, same datagram with mcu_us stamped;
+ *                  round trip and loss are measured topside
+ *   SINK         counted and dropped (throughput, loss topside → MCU)
+ *   REPORT_REQ   → REPORT with the sink statistics since the last
+ *                  RESET, in link_test_stats_t after the header
+ *   SOURCE_REQ   MCU sends link_test_source_t.count SOURCE_DATA
+ *                  datagrams of the request's length back to the sender
+ *                  at .rate_pps (loss, throughput MCU → topside)
+ *   RESET        clears the sink statistics
+ *
+ * Every datagram starts with link_test_header_t; `length` is the whole
+ * datagram, LINK_TEST_MIN_LEN..LINK_TEST_MAX_LEN, so a test uses one
+ * fixed payload size.  The CRC covers the header only, keeping the cost
+ * per byte at a memcpy.  All fields native byte order (little-endian).
+ */
+
+#define LINK_TEST_ECHO        0x01
+#define LINK_TEST_ECHO_REPLY  0x02
+#define LINK_TEST_SINK        0x03
+#define LINK_TEST_REPORT_REQ  0x04
+#define LINK_TEST_REPORT      0x05
+#define LINK_TEST_SOURCE_REQ  0x06
+#define LINK_TEST_SOURCE_DATA 0x07
+#define LINK_TEST_RESET       0x08
+
+#define LINK_TEST_MAX_LEN      1024    /* 8 TX net_bufs */
+#define LINK_TEST_MAX_ENABLE_S 600
+#define LINK_TEST_MAX_RATE_PPS 10000
+
+typedef struct {
+    uint8_t  type;
+    uint8_t  _pad;
+    uint16_t length;        /* whole datagram, header included */
+    uint32_t sequence;      /* sender's counter; SOURCE_DATA counts from 0 */
+    int64_t  topside_us;    /* set by topside, echoed back */
+    int64_t  mcu_us;        /* MCU uptime (us) when the MCU sent it */
+    uint32_t crc32;         /* over the fields above */
+} __attribute__((packed)) link_test_header_t;
+
+#define LINK_TEST_MIN_LEN sizeof(link_test_header_t)
+
+/* REPORT payload */
+typedef struct {
+    uint32_t packets;       /* SINK datagrams received */
+    uint32_t bytes;         /* their total length */
+    uint32_t lost;          /* sequence gaps */
+    uint32_t reordered;     /* sequence went backwards */
+    int64_t  first_us;      /* MCU uptime of the first and last SINK */
+    int64_t  last_us;
+} __attribute__((packed)) link_test_stats_t;
+
+/* SOURCE_REQ payload */
+typedef struct {
+    uint32_t count;
+    uint32_t rate_pps;      /* 0 = as fast as the TX queue allows */
+} __attribute__((packed)) link_test_source_t;
+
+/* Enable the self-test for `seconds` (clamped), or disable it with 0 */
+void link_test_enable(uint32_t seconds);
@@ -1,9 +1,28 @@
 /*
- * UDP Log Backend — forwards all Zephyr log messages to topside as plain text.
+ * UDP Log Backend — forwards all Zephyr log messages to topside.
  *
  * Runs inside the existing Zephyr deferred-log processing thread (no extra thread).
  * Activated from main() after network_init() via log_backend_udp_topside_start().
  *
+ * Messages are packed: each one is formatted into a staging buffer and
+ * appended whole to an MTU-sized datagram, which is sent when the next
+ * message would not fit or the log queue has drained.  A burst of
+ * warnings therefore leaves as a few large datagrams instead of one
+ * tiny datagram per output chunk.  A text message longer than the
+ * staging buffer is passed on in pieces and may span datagrams.
+ *
+ * The socket is (re)opened lazily by the next flush whenever it is
+ * missing or was opened before the last link-down, at most once per
+ * LOG_SOCK_RETRY_MS, so a failed open after a link bounce (or at start)
+ * costs the messages of one retry interval rather than silencing the
+ * backend for good (see sock_reopen.h).
+ *
+ * Text mode (default) sends plain lines, readable with `nc -ul 5006`.
+ * With CONFIG_K2_LOG_UDP_DICT messages are Zephyr dictionary-based
+ * binary records — no formatting on target, strings stay in the ELF —
+ * behind a small header with a sequence number and the dropped count;
+ * decode with tools/log_dict_decode.py and the build's log_dictionary.json.
+ *
  * IMPORTANT: This file must NOT use LOG_INF/LOG_ERR/LOG_WRN/LOG_DBG — doing so
  * would cause the logging subsystem to recurse back into this backend.
  */
@@ -11,47 +30,226 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log_backend.h>
 #include <zephyr/logging/log_backend_std.h>
+#include <zephyr/logging/log_ctrl.h>
 #include <zephyr/logging/log_output.h>
 #include <zephyr/logging/log_core.h>
 #include <zephyr/net/socket.h>
+#include <string.h>
 
+#ifdef CONFIG_K2_LOG_UDP_DICT
+#include <zephyr/logging/log_output_dict.h>
+#endif
+
+#include "log_backend_udp.h"
 #include "net.h"
+#include "net_counters.h"
+#include "sock_reopen.h"
+
+#define LOG_DGRAM_MAX   1472    /* 1500 B Ethernet MTU − IPv4/UDP headers */
+#define LOG_MSG_MAX     256     /* longest message kept in one datagram */
+#define LOG_SOCK_RETRY_MS 250   /* least time between socket open attempts */
 
-static int  log_sock = -1;
+static struct sock_reopen log_sock = SOCK_REOPEN_INIT;
 static bool in_panic = false;
 static struct sockaddr_in log_dest;
 static uint8_t log_out_buf[192];
+#ifdef CONFIG_K2_LOG_UDP_DICT
+static uint32_t current_format = LOG_OUTPUT_DICT;
+#else
 static uint32_t current_format = LOG_OUTPUT_TEXT;
+#endif
+
+/* Current message, filled by the log_output callback */
+static uint8_t msg_buf[LOG_MSG_MAX];
+static size_t  msg_len;
+static bool    msg_overflow;
+
+/* log_output hands over at most one log_out_buf per callback */
+BUILD_ASSERT(sizeof(log_out_buf) <= LOG_MSG_MAX);
+
+/* Datagram being packed */
+static uint8_t  dgram[LOG_DGRAM_MAX] __aligned(4);
+static size_t   dgram_len;
+static uint16_t dgram_count;
+static uint32_t dgram_seq;
+
+/* Messages lost: by the logging core, oversized records, or failed sends */
+static atomic_t log_dropped = ATOMIC_INIT(0);
+
+#ifdef CONFIG_K2_LOG_UDP_DICT
+#define DGRAM_HDR_LEN   sizeof(log_udp_dict_header_t)
+#define DGRAM_CRC_LEN   sizeof(uint32_t)
+#else
+#define DGRAM_HDR_LEN   0
+#define DGRAM_CRC_LEN   0
+#endif
 
-/* Output callback — sends formatted text as a single UDP datagram */
+static void commit_msg(void);
+
+/* Output callback — collects the message being formatted */
 static int log_udp_out(uint8_t *data, size_t length, void *ctx)
 {
     ARG_UNUSED(ctx);
 
-    if (log_sock < 0 || in_panic || length == 0) {
+    if (msg_len + length > sizeof(msg_buf)) {
+#ifdef CONFIG_K2_LOG_UDP_DICT
+        /* A dictionary record only decodes whole: drop it and count it */
+        msg_overflow = true;
         return (int)length;
+#else
+        /* Text has no framing: pass on what is staged and carry on */
+        commit_msg();
+        msg_len = 0;
+#endif
     }
-
-    zsock_sendto(log_sock, data, length, ZSOCK_MSG_DONTWAIT,
-                 (struct sockaddr *)&log_dest, sizeof(log_dest));
+    memcpy(&msg_buf[msg_len], data, length);
+    msg_len += length;
 
     return (int)length;
 }
 
 LOG_OUTPUT_DEFINE(log_output_udp, log_udp_out, log_out_buf, sizeof(log_out_buf));
 
+static void dgram_reset(void)
+{
+    dgram_len = DGRAM_HDR_LEN;
+    dgram_count = 0;
+}
+
+/* Open the socket; re-run from dgram_flush() after the link comes back */
+static int log_sock_open(void)
+{
+    log_sock.sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (log_sock.sock < 0) {
+        return -errno;
+    }
+
+    int on = 1;
+    zsock_setsockopt(log_sock.sock, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+    /* Lowest TX class, so a log burst queues behind control traffic */
+    net_socket_set_priority(log_sock.sock, NET_PRIO_BULK);
+    return 0;
+}
+
+/* A socket usable on the current link, re-opening it if due */
+static bool log_sock_ready(void)
+{
+    switch (sock_reopen_check(&log_sock, net_link_generation(), k_uptime_get(),
+                              LOG_SOCK_RETRY_MS)) {
+    case SOCK_REOPEN_READY:
+        return true;
+    case SOCK_REOPEN_WAIT:
+        return false;
+    case SOCK_REOPEN_OPEN:
+        break;
+    }
+
+    if (log_sock.sock >= 0) {
+        zsock_close(log_sock.sock);
+        log_sock.sock = -1;
+    }
+    return log_sock_open() == 0;
+}
+
+static void dgram_flush(void)
+{
+    if (dgram_count == 0) {
+        return;
+    }
+
+    /* Link down, or no socket yet: the send could only fail, so count
+     * the loss cheaply */
+    if (!network_ready || !log_sock_ready()) {
+        atomic_add(&log_dropped, dgram_count);
+        dgram_reset();
+        return;
+    }
+
+#ifdef CONFIG_K2_LOG_UDP_DICT
+    log_udp_dict_header_t hdr = {
+        .magic    = LOG_UDP_DICT_MAGIC,
+        .version  = LOG_UDP_DICT_VERSION,
+        .count    = dgram_count,
+        .sequence = dgram_seq,
+        .dropped  = (uint32_t)atomic_get(&log_dropped),
+    };
+    memcpy(dgram, &hdr, sizeof(hdr));
+
+    uint32_t crc = crc32_calc(dgram, dgram_len);
+    memcpy(&dgram[dgram_len], &crc, sizeof(crc));
+#endif
+
+    int ret = net_port_sendto(NET_PORT_LOG, log_sock.sock, dgram, dgram_len + DGRAM_CRC_LEN,
+                              ZSOCK_MSG_DONTWAIT, &log_dest);
+    if (ret < 0) {
+        atomic_add(&log_dropped, dgram_count);
+    }
+    dgram_seq++;
+    dgram_reset();
+}
+
+/* Move the staged message into the datagram, flushing first if needed */
+static void commit_msg(void)
+{
+    if (msg_overflow) {
+        atomic_inc(&log_dropped);
+        return;
+    }
+    if (msg_len == 0) {
+        return;
+    }
+
+    if (dgram_len + msg_len + DGRAM_CRC_LEN > sizeof(dgram)) {
+        dgram_flush();
+    }
+    memcpy(&dgram[dgram_len], msg_buf, msg_len);
+    dgram_len += msg_len;
+    dgram_count++;
+}
+
+static void format_msg(void (*emit)(void *arg), void *arg)
+{
+    msg_len = 0;
+    msg_overflow = false;
+
+    emit(arg);
+    commit_msg();
+
+    /* Hold the datagram open only while more messages are queued */
+    if (!log_data_pending()) {
+        dgram_flush();
+    }
+}
+
+static void emit_log_msg(void *arg)
+{
+    uint32_t flags = log_backend_std_get_flags();
+    log_format_func_t fmt = log_format_func_t_get(current_format);
+
+    fmt(&log_output_udp, &((union log_msg_generic *)arg)->log, flags);
+}
+
+static void emit_dropped(void *arg)
+{
+    uint32_t cnt = *(uint32_t *)arg;
+
+#ifdef CONFIG_K2_LOG_UDP_DICT
+    log_dict_output_dropped_process(&log_output_udp, cnt);
+#else
+    log_backend_std_dropped(&log_output_udp, cnt);
+#endif
+}
+
 static void udp_log_process(const struct log_backend *const backend,
                             union log_msg_generic *msg)
 {
     ARG_UNUSED(backend);
 
-    if (in_panic || log_sock < 0) {
+    if (in_panic) {
         return;
     }
 
-    uint32_t flags = log_backend_std_get_flags();
-    log_format_func_t fmt = log_format_func_t_get(current_format);
-    fmt(&log_output_udp, &msg->log, flags);
+    format_msg(emit_log_msg, msg);
 }
 
 static void udp_log_init(const struct log_backend *const backend)
@@ -71,8 +269,10 @@ static void udp_log_dropped(const struct log_backend *const backend,
                             uint32_t cnt)
 {
     ARG_UNUSED(backend);
-    if (log_sock >= 0 && !in_panic) {
-        log_backend_std_dropped(&log_output_udp, cnt);
+
+    atomic_add(&log_dropped, cnt);
+    if (!in_panic) {
+        format_msg(emit_dropped, &cnt);
     }
 }
 
@@ -94,20 +294,24 @@ static const struct log_backend_api log_backend_udp_api = {
 
 LOG_BACKEND_DEFINE(log_backend_udp_topside, log_backend_udp_api, false);
 
-/* Called from main() after network_init() to open the socket and activate */
-void log_backend_udp_topside_start(void)
+uint32_t log_backend_udp_dropped(void)
 {
-    log_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (log_sock < 0) {
-        return;
-    }
+    return (uint32_t)atomic_get(&log_dropped);
+}
 
-    int on = 1;
-    zsock_setsockopt(log_sock, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+/*
+ * Called from main() after network_init().  Activates the backend even
+ * if the socket cannot be opened yet; the first flush retries it.
+ */
+void log_backend_udp_topside_start(void)
+{
+    log_sock.retry_ms = 0;
+    (void)log_sock_ready();
 
     log_dest.sin_family = AF_INET;
     log_dest.sin_port   = htons(LOG_UDP_PORT);
     zsock_inet_pton(AF_INET, TOPSIDE_IP, &log_dest.sin_addr);
 
+    dgram_reset();
     log_backend_activate(&log_backend_udp_topside, NULL);
 }
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Dictionary-mode datagram on LOG_UDP_PORT (CONFIG_K2_LOG_UDP_DICT),
+ * native byte order:
+ *   | magic (1B) 'D' | version (1B) | count (2B)   messages in this datagram
+ *   | sequence (4B)                               datagram number
+ *   | dropped (4B)                                messages lost since boot
+ *   | count x Zephyr dictionary log message
+ *   | crc32 (4B)                                  over all preceding bytes
+ *
+ * Messages never straddle datagrams, so a lost datagram costs only its
+ * own messages and the decoder can resynchronise on the next one.
+ */
+
+#define LOG_UDP_DICT_MAGIC    'D'
+#define LOG_UDP_DICT_VERSION  1
+
+typedef struct {
+    uint8_t  magic;
+    uint8_t  version;
+    uint16_t count;
+    uint32_t sequence;
+    uint32_t dropped;
+} __attribute__((packed)) log_udp_dict_header_t;
+
+/* Activate the backend (after network_init); the socket opens on first use if not now */
+void log_backend_udp_topside_start(void);
+
+/* Log messages lost since boot (logging core drops plus failed sends) */
+uint32_t log_backend_udp_dropped(void);
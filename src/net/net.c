@@ -6,6 +6,9 @@
 #include <zephyr/net/net_if.h>
 #include <zephyr/net/net_mgmt.h>
 #include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_context.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet_mgmt.h>
 // Standard C library headers for string manipulation and I/O
 #include <string.h>
 #include <stdio.h>
@@ -15,12 +18,13 @@
 #include "net.h"
 #include "../control.h"
 #include "../imu/vn100s.h"
-#include "resource_monitor.h"
+#include "net_counters.h"
+#include "udp_dispatch.h"
+#include "imu_telemetry.h"
+#include "telemetry.h"
 
 LOG_MODULE_REGISTER(net_app, LOG_LEVEL_INF);
 
-#define RECV_BUFFER_SIZE 64
-
 // Packet structure definition
 typedef struct {
     uint32_t sequence;  // Sequence number
@@ -28,66 +32,63 @@ typedef struct {
     uint32_t crc32;     // CRC32 checksum
 } __attribute__((packed)) udp_packet_t;
 
+// Command frame v2: the v1 fields, then the topside send time.  Told
+// apart from v1 by its length; all fields network byte order.
+#define CMD_FRAME_V2 2
+
+typedef struct {
+    uint32_t sequence;    // Sequence number
+    uint64_t payload;     // Payload data (same encoding as v1)
+    uint8_t  version;     // CMD_FRAME_V2
+    uint8_t  reserved[3];
+    uint64_t topside_us;  // Topside send timestamp (us, topside clock), echoed back
+    uint32_t crc32;       // CRC32 checksum
+} __attribute__((packed)) udp_packet_v2_t;
+
 /* Use addresses from net.h */
 #define STATIC_IP_ADDR STATIC_DEVICE_IP
 
-// Network management callback structure for handling interface events
+// Network management callback structures for interface and carrier events
 static struct net_mgmt_event_callback mgmt_cb;
-bool network_ready = false;  // Flag to track network interface status
-
-// UDP socket and thread management variables
-int udp_sock = -1;                                    // UDP socket file descriptor
-K_THREAD_STACK_DEFINE(udp_thread_stack, 2048);      // Stack space for UDP thread
-struct k_thread udp_thread_data;                     // Thread control block
-K_THREAD_STACK_DEFINE(sensor_thread_stack, 4096);
-static struct k_thread sensor_thread_data;
-
-// Pre-computed CRC32 lookup table for faster calculation
-static const uint32_t crc32_table[256] = {
-    0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F,
-    0xE963A535, 0x9E6495A3, 0x0EDB8832, 0x79DCB8A4, 0xE0D5E91E, 0x97D2D988,
-    0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91, 0x1DB71064, 0x6AB020F2,
-    0xF3B97148, 0x84BE41DE, 0x1ADAD47D, 0x6DDDE4EB, 0xF4D4B551, 0x83D385C7,
-    0x136C9856, 0x646BA8C0, 0xFD62F97A, 0x8A65C9EC, 0x14015C4F, 0x63066CD9,
-    0xFA0F3D63, 0x8D080DF5, 0x3B6E20C8, 0x4C69105E, 0xD56041E4, 0xA2677172,
-    0x3C03E4D1, 0x4B04D447, 0xD20D85FD, 0xA50AB56B, 0x35B5A8FA, 0x42B2986C,
-    0xDBBBC9D6, 0xACBCF940, 0x32D86CE3, 0x45DF5C75, 0xDCD60DCF, 0xABD13D59,
-    0x26D930AC, 0x51DE003A, 0xC8D75180, 0xBFD06116, 0x21B4F4B5, 0x56B3C423,
-    0xCFBA9599, 0xB8BDA50F, 0x2802B89E, 0x5F058808, 0xC60CD9B2, 0xB10BE924,
-    0x2F6F7C87, 0x58684C11, 0xC1611DAB, 0xB6662D3D, 0x76DC4190, 0x01DB7106,
-    0x98D220BC, 0xEFD5102A, 0x71B18589, 0x06B6B51F, 0x9FBFE4A5, 0xE8B8D433,
-    0x7807C9A2, 0x0F00F934, 0x9609A88E, 0xE10E9818, 0x7F6A0DBB, 0x086D3D2D,
-    0x91646C97, 0xE6635C01, 0x6B6B51F4, 0x1C6C6162, 0x856530D8, 0xF262004E,
-    0x6C0695ED, 0x1B01A57B, 0x8208F4C1, 0xF50FC457, 0x65B0D9C6, 0x12B7E950,
-    0x8BBEB8EA, 0xFCB9887C, 0x62DD1DDF, 0x15DA2D49, 0x8CD37CF3, 0xFBD44C65,
-    0x4DB26158, 0x3AB551CE, 0xA3BC0074, 0xD4BB30E2, 0x4ADFA541, 0x3DD895D7,
-    0xA4D1C46D, 0xD3D6F4FB, 0x4369E96A, 0x346ED9FC, 0xAD678846, 0xDA60B8D0,
-    0x44042D73, 0x33031DE5, 0xAA0A4C5F, 0xDD0D7CC9, 0x5005713C, 0x270241AA,
-    0xBE0B1010, 0xC90C2086, 0x5768B525, 0x206F85B3, 0xB966D409, 0xCE61E49F,
-    0x5EDEF90E, 0x29D9C998, 0xB0D09822, 0xC7D7A8B4, 0x59B33D17, 0x2EB40D81,
-    0xB7BD5C3B, 0xC0BA6CAD, 0xEDB88320, 0x9ABFB3B6, 0x03B6E20C, 0x74B1D29A,
-    0xEAD54739, 0x9DD277AF, 0x04DB2615, 0x73DC1683, 0xE3630B12, 0x94643B84,
-    0x0D6D6A3E, 0x7A6A5AA8, 0xE40ECF0B, 0x9309FF9D, 0x0A00AE27, 0x7D079EB1,
-    0xF00F9344, 0x8708A3D2, 0x1E01F268, 0x6906C2FE, 0xF762575D, 0x806567CB,
-    0x196C3671, 0x6E6B06E7, 0xFED41B76, 0x89D32BE0, 0x10DA7A5A, 0x67DD4ACC,
-    0xF9B9DF6F, 0x8EBEEFF9, 0x17B7BE43, 0x60B08ED5, 0xD6D6A3E8, 0xA1D1937E,
-    0x38D8C2C4, 0x4FDFF252, 0xD1BB67F1, 0xA6BC5767, 0x3FB506DD, 0x48B2364B,
-    0xD80D2BDA, 0xAF0A1B4C, 0x36034AF6, 0x41047A60, 0xDF60EFC3, 0xA867DF55,
-    0x316E8EEF, 0x4669BE79, 0xCB61B38C, 0xBC66831A, 0x256FD2A0, 0x5268E236,
-    0xCC0C7795, 0xBB0B4703, 0x220216B9, 0x5505262F, 0xC5BA3BBE, 0xB2BD0B28,
-    0x2BB45A92, 0x5CB36A04, 0xC2D7FFA7, 0xB5D0CF31, 0x2CD99E8B, 0x5BDEAE1D,
-    0x9B64C2B0, 0xEC63F226, 0x756AA39C, 0x026D930A, 0x9C0906A9, 0xEB0E363F,
-    0x72076785, 0x05005713, 0x95BF4A82, 0xE2B87A14, 0x7BB12BAE, 0x0CB61B38,
-    0x92D28E9B, 0xE5D5BE0D, 0x7CDCEFB7, 0x0BDBDF21, 0x86D3D2D4, 0xF1D4E242,
-    0x68DDB3F8, 0x1FDA836E, 0x81BE16CD, 0xF6B9265B, 0x6FB077E1, 0x18B74777,
-    0x88085AE6, 0xFF0F6A70, 0x66063BCA, 0x11010B5C, 0x8F659EFF, 0xF862AE69,
-    0x616BFFD3, 0x166CCF45, 0xA00AE278, 0xD70DD2EE, 0x4E048354, 0x3903B3C2,
-    0xA7672661, 0xD06016F7, 0x4969474D, 0x3E6E77DB, 0xAED16A4A, 0xD9D65ADC,
-    0x40DF0B66, 0x37D83BF0, 0xA9BCAE53, 0xDEBB9EC5, 0x47B2CF7F, 0x30B5FFE9,
-    0xBDBDF21C, 0xCABAC28A, 0x53B39330, 0x24B4A3A6, 0xBAD03605, 0xCDD70693,
-    0x54DE5729, 0x23D967BF, 0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94,
-    0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D
-};
+static struct net_mgmt_event_callback carrier_cb;
+bool network_ready = false;  // Interface operationally up (carrier present)
+
+// Link-up bookkeeping for socket re-arm and recovery timing
+static atomic_t link_up;             // network_ready, for race-free transitions
+static atomic_t link_generation;     // bumped on every down → up transition
+static atomic_t carrier_up_ms;       // uptime of the last carrier-on, 0 = unknown
+static atomic_t recovery_pending;    // waiting for the first command after link-up
+
+// Local subnet for the inbound source filter; a zero mask accepts everyone
+static uint32_t local_net;
+static uint32_t local_mask;
+
+/**
+ * Record a link state change; only real transitions bump the generation
+ * @param up: true if the interface is now operationally up
+ */
+static void link_set(bool up)
+{
+    if (up) {
+        if (!atomic_cas(&link_up, 0, 1)) {
+            return;
+        }
+        // No carrier event seen (e.g. admin up with carrier already on)
+        atomic_cas(&carrier_up_ms, 0, (atomic_val_t)MAX(k_uptime_get_32(), 1U));
+        atomic_inc(&link_generation);
+        atomic_set(&recovery_pending, 1);
+        network_ready = true;
+        LOG_INF("Network interface up (link generation %u)",
+                (unsigned int)atomic_get(&link_generation));
+    } else {
+        if (!atomic_cas(&link_up, 1, 0)) {
+            return;
+        }
+        network_ready = false;
+        atomic_set(&carrier_up_ms, 0);
+        LOG_WRN("Network interface is down");
+    }
+}
 
 /**
  * Network management event handler - called when network interface events occur
@@ -98,15 +99,45 @@ static const uint32_t crc32_table[256] = {
 static void net_mgmt_event_handler(struct net_mgmt_event_callback *cb,
                                    uint64_t mgmt_event, struct net_if *iface)
 {
-    // Check if network interface came up
+    // Operational state: admin up, carrier present and not dormant
     if (mgmt_event == NET_EVENT_IF_UP) {
-        LOG_INF("Network interface up");
-        network_ready = true;  // Set flag to indicate network is available
-    } 
-    // Check if network interface went down
-    else if (mgmt_event == NET_EVENT_IF_DOWN) {
-        LOG_WRN("Network interface is down");
-        network_ready = false;  // Clear network ready flag
+        link_set(true);
+    } else if (mgmt_event == NET_EVENT_IF_DOWN) {
+        link_set(false);
+    }
+}
+
+/**
+ * Ethernet L2 carrier handler - stamps carrier-on, which precedes IF_UP,
+ * as the start of a recovery
+ */
+static void carrier_event_handler(struct net_mgmt_event_callback *cb,
+                                  uint64_t mgmt_event, struct net_if *iface)
+{
+    if (mgmt_event == NET_EVENT_ETHERNET_CARRIER_ON) {
+        atomic_set(&carrier_up_ms, (atomic_val_t)MAX(k_uptime_get_32(), 1U));
+        LOG_INF("Ethernet carrier on");
+    } else if (mgmt_event == NET_EVENT_ETHERNET_CARRIER_OFF) {
+        atomic_set(&carrier_up_ms, 0);
+        LOG_WRN("Ethernet carrier lost");
+    }
+}
+
+uint32_t net_link_generation(void)
+{
+    return (uint32_t)atomic_get(&link_generation);
+}
+
+void net_link_command_seen(void)
+{
+    if (!atomic_cas(&recovery_pending, 1, 0)) {
+        return;
+    }
+
+    uint32_t carrier_ms = (uint32_t)atomic_get(&carrier_up_ms);
+    if (carrier_ms != 0) {
+        LOG_INF("Link recovery: first command %u ms after carrier up",
+                k_uptime_get_32() - carrier_ms);
     }
 }
 
@@ -169,6 +200,10 @@ static int configure_static_ip(struct net_if *iface)
         }
         // Set the default gateway for the interface
         net_if_ipv4_set_gw(iface, &gateway);
+    } else {
+        // No route off the subnet, so nothing from outside it can be answered
+        local_mask = netmask.s_addr;
+        local_net  = addr.s_addr & netmask.s_addr;
     }
 
     // Log the complete static IP configuration for verification
@@ -177,6 +212,19 @@ static int configure_static_ip(struct net_if *iface)
     return 0;  // Configuration successful
 }
 
+int net_socket_set_priority(int sock, uint8_t priority)
+{
+    if (zsock_setsockopt(sock, SOL_SOCKET, SO_PRIORITY, &priority, sizeof(priority)) < 0) {
+        return -errno;
+    }
+    return 0;
+}
+
+bool net_source_allowed(const struct in_addr *src)
+{
+    return (src->s_addr & local_mask) == local_net;
+}
+
 /**
  * Initialize the network subsystem with static IP configuration
  * This function sets up the network interface and applies static IP settings
@@ -195,11 +243,15 @@ void network_init(void)
         return;  // Cannot proceed without a network interface
     }
 
-    // Initialize network management event callback to monitor interface status
+    // Initialize network management event callbacks to monitor link state;
+    // interface and Ethernet carrier events are separate layers
     net_mgmt_init_event_callback(&mgmt_cb, net_mgmt_event_handler,
                                  NET_EVENT_IF_UP | NET_EVENT_IF_DOWN);
-    // Register the callback with the network management subsystem
     net_mgmt_add_event_callback(&mgmt_cb);
+    net_mgmt_init_event_callback(&carrier_cb, carrier_event_handler,
+                                 NET_EVENT_ETHERNET_CARRIER_ON |
+                                 NET_EVENT_ETHERNET_CARRIER_OFF);
+    net_mgmt_add_event_callback(&carrier_cb);
 
     // Apply static IP configuration to the interface
     ret = configure_static_ip(iface);
@@ -208,35 +260,19 @@ void network_init(void)
         return;  // Configuration failed
     }
 
-    // Bring the network interface up (activate it)
+    // Bring the network interface up (activate it).  Readiness follows the
+    // operational state from here on: if the carrier is already there the
+    // interface is up now, otherwise NET_EVENT_IF_UP arrives with it.
     net_if_up(iface);
-    
-    // Allow some time for the interface to become operational
-    k_sleep(K_MSEC(200));
-    network_ready = true;  // Mark network as ready for use
+    if (net_if_is_up(iface)) {
+        link_set(true);
+    } else {
+        LOG_WRN("Network interface waiting for carrier");
+    }
     
     LOG_DBG("Static IP configuration complete");
 }
 
-/**
- * Calculate CRC32 checksum using simple polynomial
- * @param data: Pointer to data to calculate CRC for
- * @param length: Length of data in bytes
- * @return: Calculated CRC32 value
- */
-uint32_t crc32_calc(const void *data, size_t length)
-{
-    const uint8_t *bytes = (const uint8_t *)data;
-    uint32_t crc = 0xFFFFFFFF;
-
-    for (size_t i = 0; i < length; i++) {
-        uint8_t index = (crc ^ bytes[i]) & 0xFF;
-        crc = (crc >> 8) ^ crc32_table[index];
-    }
-
-    return ~crc;
-}
-
 /**
  * Convert 64-bit value from network byte order to host byte order
  * @param value: 64-bit value in network byte order
@@ -252,178 +288,213 @@ static inline uint64_t net_to_host_64(uint64_t value)
 }
 
 /**
- * UDP server thread function - handles incoming UDP messages
- * This thread runs continuously, listening for UDP packets and responding
- * @param arg1, arg2, arg3: Thread arguments (unused)
+ * Decode a length- and CRC-checked v1 or v2 command frame and forward it
+ * to the control loop
+ * @return: 0 if accepted, -ENOMSG for an unknown frame version
  */
-void udp_server_thread(void *arg1, void *arg2, void *arg3)
+static int command_decode(const uint8_t *data, size_t len)
 {
-    ARG_UNUSED(arg1); ARG_UNUSED(arg2); ARG_UNUSED(arg3);
+    if (len == sizeof(udp_packet_t)) {
+        const udp_packet_t *packet = (const udp_packet_t *)data;
 
-    struct sockaddr_in bind_addr, client_addr;
-    socklen_t client_addr_len = sizeof(client_addr);
-    
-    udp_packet_t packet;
-    int ret;
+        rov_send_command(ntohl(packet->sequence), net_to_host_64(packet->payload), 0);
+        return 0;
+    }
+
+    const udp_packet_v2_t *packet = (const udp_packet_v2_t *)data;
 
-    while (!network_ready) {
-        k_sleep(K_MSEC(100));
+    if (len != sizeof(udp_packet_v2_t) || packet->version != CMD_FRAME_V2) {
+        return -ENOMSG;
     }
+    rov_send_command(ntohl(packet->sequence), net_to_host_64(packet->payload),
+                     net_to_host_64(packet->topside_us));
+    return 0;
+}
 
-    udp_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (udp_sock < 0) {
-        LOG_ERR("Failed to create UDP socket: %d", udp_sock);
-        return;
+/**
+ * Command handler (port 12345) - called by the UDP dispatcher with a
+ * length- and CRC-checked packet; forwards the payload to the control loop
+ */
+static int command_handle(int sock, const uint8_t *data, size_t len,
+                          const struct sockaddr_in *from)
+{
+    ARG_UNUSED(sock); ARG_UNUSED(from);
+
+    int err = command_decode(data, len);
+    if (err == 0) {
+        net_link_command_seen();
     }
+    return err;
+}
 
-    memset(&bind_addr, 0, sizeof(bind_addr));
-    bind_addr.sin_family = AF_INET;
-    bind_addr.sin_addr.s_addr = INADDR_ANY;
-    bind_addr.sin_port = htons(UDP_COMMAND_PORT);
+const struct udp_service command_service = {
+    .name     = "Command",
+    .port     = UDP_COMMAND_PORT,
+    .min_len  = sizeof(udp_packet_t),
+    .max_len  = sizeof(udp_packet_v2_t),
+    .crc      = UDP_CRC_NET,
+    .handler  = command_handle,
+    .counters = NET_PORT_COMMAND,
+    .priority = NET_PRIO_CONTROL,
+};
 
-    ret = zsock_bind(udp_sock, (struct sockaddr *)&bind_addr, sizeof(bind_addr));
-    if (ret < 0) {
-        LOG_ERR("Failed to bind UDP socket: %d", ret);
-        zsock_close(udp_sock);
+#ifdef CONFIG_K2_CMD_NET_CONTEXT
+/*
+ * Zero-copy command receive path.
+ *
+ * Through the socket layer a command is copied into the socket queue,
+ * into the dispatcher's rx_buf and into rov_command_t.  Here a
+ * net_context receive callback runs in the network RX thread, reads the
+ * frame in place from the net_pkt (the cursor is already past the UDP
+ * header), checks the CRC there and queues the decoded command for the
+ * control loop.  Only a frame split across net_bufs is copied, into the
+ * frame-sized access buffer on the stack.
+ */
+static struct net_context *cmd_ctx;
+
+static void command_recv_cb(struct net_context *ctx, struct net_pkt *pkt,
+                            union net_ip_header *ip_hdr,
+                            union net_proto_header *proto_hdr,
+                            int status, void *user_data)
+{
+    ARG_UNUSED(ctx); ARG_UNUSED(proto_hdr); ARG_UNUSED(user_data);
+
+    if (!pkt) {
         return;
     }
 
-    LOG_INF("UDP server ready on port %d", UDP_COMMAND_PORT);
-
-    while (1) {
-        ret = zsock_recvfrom(udp_sock, &packet, sizeof(packet), 0,
-                             (struct sockaddr *)&client_addr, &client_addr_len);
-
-        if (ret == sizeof(udp_packet_t)) {
-            uint32_t recv_sequence = ntohl(packet.sequence);
-            uint64_t recv_payload = net_to_host_64(packet.payload);
-            uint32_t recv_crc = ntohl(packet.crc32);
-            
-            uint32_t calculated_crc = crc32_calc(&packet,
-                sizeof(packet.sequence) + sizeof(packet.payload));
-
-            if (calculated_crc == recv_crc) {
-                rov_send_command(recv_sequence, recv_payload);
-                resource_monitor_inc_udp_rx();
-            } else {
-                LOG_WRN("CRC mismatch: calc 0x%08X, recv 0x%08X",
-                        calculated_crc, recv_crc);
-                resource_monitor_inc_udp_errors();
-            }
-            
-        } else if (ret < 0) {
-            LOG_ERR("UDP recv error: %d", ret);
-            resource_monitor_inc_udp_errors();
-            k_sleep(K_MSEC(100));
-        } else {
-            LOG_WRN("Wrong packet size: got %d bytes, expected %d bytes",
-                    ret, sizeof(udp_packet_t));
-        }
+    size_t len = net_pkt_remaining_data(pkt);
+    if (status < 0) {
+        net_counter_inc(NET_PORT_COMMAND, NET_CNT_RX_ERR);
+        goto out;
+    }
+    if (len != sizeof(udp_packet_t) && len != sizeof(udp_packet_v2_t)) {
+        net_counter_inc(NET_PORT_COMMAND, NET_CNT_SIZE);
+        goto out;
     }
-}
 
-void sensor_sender_thread(void *arg1, void *arg2, void *arg3)
-{
-    ARG_UNUSED(arg1); ARG_UNUSED(arg2); ARG_UNUSED(arg3);
-    
-    int sock;
-    struct sockaddr_in dest_addr;
-    char buffer[256];
-    float yaw, pitch, roll;
-    float yr, pr, rr;
-    float ax, ay, az;
-
-    while (!network_ready) {
-        k_sleep(K_MSEC(100));
+    struct in_addr src;
+    memcpy(&src, ip_hdr->ipv4->src, sizeof(src));
+    if (!net_source_allowed(&src)) {
+        net_counter_inc(NET_PORT_COMMAND, NET_CNT_SOURCE);
+        goto out;
     }
 
-    sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (sock < 0) {
-        LOG_ERR("Failed to create sensor UDP socket: %d", sock);
-        return;
+    NET_PKT_DATA_ACCESS_DEFINE(cmd_access, udp_packet_v2_t);
+    cmd_access.size = len;
+    const uint8_t *frame = net_pkt_get_data(pkt, &cmd_access);
+    if (!frame) {
+        net_counter_inc(NET_PORT_COMMAND, NET_CNT_RX_ERR);
+        goto out;
+    }
+
+    uint32_t recv_crc;
+    memcpy(&recv_crc, &frame[len - sizeof(recv_crc)], sizeof(recv_crc));
+    if (crc32_calc(frame, len - sizeof(recv_crc)) != ntohl(recv_crc)) {
+        net_counter_inc(NET_PORT_COMMAND, NET_CNT_CRC);
+        goto out;
+    }
+    if (command_decode(frame, len) < 0) {
+        net_counter_inc(NET_PORT_COMMAND, NET_CNT_TYPE);
+        goto out;
     }
 
-    dest_addr.sin_family = AF_INET;
-    dest_addr.sin_port = htons(SENSOR_PORT);
+    net_counter_rx(NET_PORT_COMMAND);
+    net_link_command_seen();
+
+out:
+    net_pkt_unref(pkt);
+}
+
+int command_fastpath_start(void)
+{
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_addr.s_addr = INADDR_ANY,
+        .sin_port = htons(UDP_COMMAND_PORT),
+    };
 
-    int on = 1;
-    int ret = zsock_setsockopt(sock, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+    int ret = net_context_get(AF_INET, SOCK_DGRAM, IPPROTO_UDP, &cmd_ctx);
     if (ret < 0) {
-        LOG_WRN("Sensor UDP broadcast enable failed: %d", ret);
-    }
-    ret = zsock_inet_pton(AF_INET, TOPSIDE_IP, &dest_addr.sin_addr);
-    if (ret <= 0) {
-        LOG_ERR("Invalid sensor destination address: %s", TOPSIDE_IP);
-        zsock_close(sock);
-        return;
+        LOG_ERR("Command net_context get failed: %d", ret);
+        return ret;
     }
 
-    LOG_INF("Sensor UDP sender started (%s:%d)", TOPSIDE_IP, SENSOR_PORT);
-
-    while (1) {
-        vn100s_get_ypr(&yaw, &pitch, &roll);
-        vn100s_get_rates(&yr, &pr, &rr);
-        vn100s_get_accel(&ax, &ay, &az);
-
-        int len = snprintf(buffer, sizeof(buffer),
-            "{\"imu\":{\"yaw\":%.2f,\"pitch\":%.2f,\"roll\":%.2f,"
-            "\"yr\":%.2f,\"pr\":%.2f,\"rr\":%.2f,"
-            "\"ax\":%.3f,\"ay\":%.3f,\"az\":%.3f}}",
-            (double)yaw, (double)pitch, (double)roll,
-            (double)yr, (double)pr, (double)rr,
-            (double)ax, (double)ay, (double)az);
-
-        if (len > 0) {
-            ret = zsock_sendto(sock, buffer, len, 0,
-                               (struct sockaddr *)&dest_addr, sizeof(dest_addr));
-            if (ret < 0) {
-                LOG_WRN("Sensor UDP send failed: %d", ret);
-            }
-        } else {
-            LOG_WRN("Sensor JSON format failed: %d", len);
-        }
+    ret = net_context_bind(cmd_ctx, (struct sockaddr *)&addr, sizeof(addr));
+    if (ret < 0) {
+        LOG_ERR("Command net_context bind to port %d failed: %d", UDP_COMMAND_PORT, ret);
+        goto fail;
+    }
 
-        k_msleep(200);
+    ret = net_context_recv(cmd_ctx, command_recv_cb, K_NO_WAIT, NULL);
+    if (ret < 0) {
+        LOG_ERR("Command net_context recv failed: %d", ret);
+        goto fail;
     }
+
+    LOG_INF("Command listening on port %d (net_context fast path)", UDP_COMMAND_PORT);
+    return 0;
+
+fail:
+    net_context_put(cmd_ctx);
+    cmd_ctx = NULL;
+    return ret;
 }
 
-void sensor_sender_start(void)
+void command_fastpath_stop(void)
 {
-    k_tid_t thread_id = k_thread_create(&sensor_thread_data,
-                                        sensor_thread_stack,
-                                        K_THREAD_STACK_SIZEOF(sensor_thread_stack),
-                                        sensor_sender_thread,
-                                        NULL, NULL, NULL,
-                                        9, 0, K_NO_WAIT);
-
-    if (thread_id != NULL) {
-        k_thread_name_set(thread_id, "sensor_udp");
-    } else {
-        LOG_ERR("Failed to create sensor UDP thread");
+    if (cmd_ctx) {
+        net_context_put(cmd_ctx);
+        cmd_ctx = NULL;
     }
 }
+#endif /* CONFIG_K2_CMD_NET_CONTEXT */
 
-/**
- * Start the UDP server by creating and launching the server thread
- * This function creates a new thread that will handle all UDP server operations
- */
-void udp_server_start(void)
+static size_t imu_telem_fill(uint8_t *buf, size_t max, uint32_t sequence)
 {
-    k_tid_t thread_id;
-    
-    // Create and start the UDP server thread
-    thread_id = k_thread_create(&udp_thread_data,
-                               udp_thread_stack,
-                               K_THREAD_STACK_SIZEOF(udp_thread_stack),
-                               udp_server_thread,
-                               NULL, NULL, NULL,
-                               K_PRIO_COOP(7),
-                               0,
-                               K_NO_WAIT);
-    
-    if (thread_id != NULL) {
-        LOG_DBG("UDP server thread created");
-    } else {
-        LOG_ERR("Failed to create UDP server thread");
+    imu_sample_t sample;
+
+    vn100s_get_ypr(&sample.yaw, &sample.pitch, &sample.roll);
+    vn100s_get_rates(&sample.yr, &sample.pr, &sample.rr);
+    vn100s_get_accel(&sample.ax, &sample.ay, &sample.az);
+
+#ifdef CONFIG_K2_IMU_TELEM_JSON
+    ARG_UNUSED(sequence);
+
+    int len = imu_telem_encode_json((char *)buf, max, &sample);
+    if (len <= 0) {
+        LOG_WRN("Sensor JSON format failed: %d", len);
+        return 0;
+    }
+    return len;
+#else
+    imu_telem_packet_t pkt;
+    uint32_t rejects[IMU_REJ_COUNT];
+    uint8_t flags = vn100s_has_recent_sample(IMU_TELEM_FRESH_MS) ?
+                    IMU_TELEM_FLAG_FRESH : 0;
+
+    imu_validate_get_stats(rejects);
+    size_t len = imu_telem_encode_binary(&pkt, &sample, rejects, sequence,
+                                         (uint32_t)vn100s_get_sample_time(), flags);
+
+    if (len > max) {
+        return 0;
     }
+    memcpy(buf, &pkt, len);
+    return len;
+#endif
 }
+
+/* 5 Hz */
+const struct telem_channel imu_telem_channel = {
+    .name        = "imu",
+    .id          = TELEM_CH_IMU,
+    .divider     = 10,
+    .legacy_port = SENSOR_PORT,
+#ifdef CONFIG_K2_IMU_TELEM_JSON
+    .max_len     = IMU_TELEM_JSON_MAX,
+#else
+    .max_len     = sizeof(imu_telem_packet_t),
+#endif
+    .fill        = imu_telem_fill,
+};
@@ -3,6 +3,8 @@
 #include <zephyr/kernel.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <zephyr/net/net_ip.h>
+#include "crc32.h"
 
 /* Network addresses */
 #define STATIC_DEVICE_IP   "10.77.0.2"
@@ -18,13 +20,55 @@
 #define LOG_UDP_PORT       5006
 #define SETPOINT_OVR_PORT  5007
 #define SYSTEM_CONTROL_PORT 5008
+#define TELEM_MUX_PORT     5009
+#define CONTROL_STREAM_PORT 5010
+#define TIME_SYNC_PORT     5011
+#define NET_COUNTERS_PORT  5012
+#define TELEM_SUBSCRIBE_PORT 5013
+#define HEARTBEAT_PORT     5014
+#define LINK_TEST_PORT     5015
+#define THREAD_TELEM_PORT  5016
 
+/*
+ * Socket priorities (SO_PRIORITY).  With CONFIG_NET_TC_TX_COUNT=3 the
+ * stack's strict priority-to-class table is {0,0,0,0,1,1,2,2}, indexed
+ * by priority, and the TX queues are served highest class first:
+ * control (IC, 6) → class 2, telemetry (VI, 4) → class 1, and logs
+ * together with unset sockets (MCUmgr OTA) → class 0.  VO (5) would
+ * land in class 1 next to telemetry, so control uses IC.
+ */
+#define NET_PRIO_CONTROL    NET_PRIORITY_IC   /* heartbeat, time sync, control telemetry */
+#define NET_PRIO_TELEMETRY  NET_PRIORITY_VI   /* telemetry, config replies */
+#define NET_PRIO_BULK       NET_PRIORITY_BK   /* UDP log */
+
+/* Interface operationally up: admin up and Ethernet carrier present */
 extern bool network_ready;
-extern int udp_sock;
 
 void network_init(void);
-void udp_server_start(void);
-void sensor_sender_start(void);
 
-/* Shared CRC32 (IEEE 802.3) — used by net.c and resource_monitor.c */
-uint32_t crc32_calc(const void *data, size_t length);
+/*
+ * Incremented every time the link comes back up.  A module holding a
+ * socket remembers the value it opened with and re-opens when it moves,
+ * so nothing is left bound to state from before a cable glitch.
+ */
+uint32_t net_link_generation(void);
+
+/* Called for every accepted command; logs carrier-up → first command once per link-up */
+void net_link_command_seen(void);
+
+/*
+ * Whether a datagram from `src` may be processed.  With no gateway
+ * configured only the ROV's own subnet is accepted; checked before the
+ * CRC so off-subnet junk costs one compare.
+ */
+bool net_source_allowed(const struct in_addr *src);
+
+/* Set a socket's SO_PRIORITY; returns 0 or a negative errno */
+int net_socket_set_priority(int sock, uint8_t priority);
+
+#ifdef CONFIG_K2_CMD_NET_CONTEXT
+/* Receive commands via a net_context callback instead of the dispatcher */
+int command_fastpath_start(void);
+void command_fastpath_stop(void);
+#endif
+
@@ -0,0 +1,95 @@
+/*
+ * Per-port network counters
+ *
+ * Replaces the two global rx/error counters in resource_monitor.c, which
+ * lumped a CRC failure on the PID port together with a short command
+ * frame and could not say which port had last heard from topside.  The
+ * counting side is inline in net_counters.h; this file owns the table,
+ * the counted send helper and the telemetry record.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <string.h>
+
+#include "net_counters.h"
+#include "net.h"
+#include "telemetry.h"
+
+struct net_port_counters net_port_counters[NET_PORT_COUNT];
+
+static const uint16_t port_numbers[NET_PORT_COUNT] = {
+    [NET_PORT_COMMAND]         = UDP_COMMAND_PORT,
+    [NET_PORT_PID_CONFIG]      = PID_CONFIG_PORT,
+    [NET_PORT_AXIS_CONFIG]     = AXIS_CONFIG_PORT,
+    [NET_PORT_SETPOINT_OVR]    = SETPOINT_OVR_PORT,
+    [NET_PORT_SYSTEM_CONTROL]  = SYSTEM_CONTROL_PORT,
+    [NET_PORT_TIME_SYNC]       = TIME_SYNC_PORT,
+    [NET_PORT_TELEM_SUBSCRIBE] = TELEM_SUBSCRIBE_PORT,
+    [NET_PORT_HEARTBEAT]       = HEARTBEAT_PORT,
+    [NET_PORT_LINK_TEST]       = LINK_TEST_PORT,
+    [NET_PORT_TELEMETRY]       = TELEM_MUX_PORT,
+    [NET_PORT_LOG]             = LOG_UDP_PORT,
+};
+
+int net_port_sendto(enum net_port_id id, int sock, const void *buf, size_t len,
+                    int flags, const struct sockaddr_in *dest)
+{
+    int ret = zsock_sendto(sock, buf, len, flags,
+                           (const struct sockaddr *)dest, sizeof(*dest));
+
+    net_counter_inc(id, ret < 0 ? NET_CNT_TX_ERR : NET_CNT_TX);
+    return ret;
+}
+
+uint32_t net_counter_total(enum net_counter cnt)
+{
+    uint32_t total = 0;
+
+    for (size_t i = 0; i < NET_PORT_COUNT; i++) {
+        total += (uint32_t)atomic_get(&net_port_counters[i].count[cnt]);
+    }
+    return total;
+}
+
+static size_t net_counters_fill(uint8_t *buf, size_t max, uint32_t sequence)
+{
+    ARG_UNUSED(sequence);
+
+    net_counters_record_t rec;
+    uint32_t now_ms = k_uptime_get_32();
+
+    if (sizeof(rec) > max) {
+        return 0;
+    }
+
+    memset(&rec, 0, sizeof(rec));
+    rec.ports    = NET_PORT_COUNT;
+    rec.counters = NET_CNT_COUNT;
+
+    for (size_t i = 0; i < NET_PORT_COUNT; i++) {
+        const struct net_port_counters *c = &net_port_counters[i];
+        net_counters_entry_t *e = &rec.entry[i];
+
+        e->port = port_numbers[i];
+        for (size_t n = 0; n < NET_CNT_COUNT; n++) {
+            e->count[n] = (uint32_t)atomic_get(&c->count[n]);
+        }
+        e->last_rx_age_ms = (e->count[NET_CNT_RX] == 0)
+                          ? UINT32_MAX
+                          : now_ms - (uint32_t)atomic_get(&c->last_rx_ms);
+    }
+
+    memcpy(buf, &rec, sizeof(rec));
+    return sizeof(rec);
+}
+
+/* 1 Hz */
+const struct telem_channel net_counters_channel = {
+    .name        = "net_counters",
+    .id          = TELEM_CH_NET_COUNTERS,
+    .divider     = 50,
+    .legacy_port = NET_COUNTERS_PORT,
+    .max_len     = sizeof(net_counters_record_t),
+    .fill        = net_counters_fill,
+};
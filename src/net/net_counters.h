@@ -0,0 +1,89 @@
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Per-port network counters.
+ *
+ * One entry per UDP port the ROV talks on, each holding a fixed set of
+ * atomic counters and the uptime of the last accepted packet.  Counting
+ * is a single atomic_inc(), cheap enough for the dispatcher and the
+ * net_context receive callback.  The whole table is published at 1 Hz
+ * on the net_counters_channel telemetry channel.
+ *
+ * Record (native byte order):
+ *   | ports (1B) | counters (1B) | pad (2B)
+ *   | ports x entry: port (2B) | pad (2B) | counters x count (4B)
+ *   |                last_rx_age_ms (4B, UINT32_MAX = never)
+ */
+
+enum net_port_id {
+    NET_PORT_COMMAND = 0,
+    NET_PORT_PID_CONFIG,
+    NET_PORT_AXIS_CONFIG,
+    NET_PORT_SETPOINT_OVR,
+    NET_PORT_SYSTEM_CONTROL,
+    NET_PORT_TIME_SYNC,
+    NET_PORT_TELEM_SUBSCRIBE,
+    NET_PORT_HEARTBEAT,
+    NET_PORT_LINK_TEST,
+    NET_PORT_TELEMETRY,
+    NET_PORT_LOG,
+    NET_PORT_COUNT
+};
+
+enum net_counter {
+    NET_CNT_RX = 0,      /* accepted packets */
+    NET_CNT_RX_ERR,      /* socket receive errors */
+    NET_CNT_CRC,         /* CRC mismatch */
+    NET_CNT_SIZE,        /* length outside the service limits */
+    NET_CNT_TYPE,        /* unknown packet type (handler returned -ENOMSG) */
+    NET_CNT_REJECTED,    /* well-formed but refused by the handler */
+    NET_CNT_TX,          /* datagrams sent */
+    NET_CNT_TX_ERR,      /* send failures */
+    NET_CNT_SOURCE,      /* sender outside the ROV's subnet */
+    NET_CNT_COUNT
+};
+
+typedef struct {
+    uint16_t port;
+    uint16_t _pad;
+    uint32_t count[NET_CNT_COUNT];
+    uint32_t last_rx_age_ms;
+} __attribute__((packed)) net_counters_entry_t;
+
+typedef struct {
+    uint8_t  ports;
+    uint8_t  counters;
+    uint16_t _pad;
+    net_counters_entry_t entry[NET_PORT_COUNT];
+} __attribute__((packed)) net_counters_record_t;
+
+struct net_port_counters {
+    atomic_t count[NET_CNT_COUNT];
+    atomic_t last_rx_ms;
+};
+
+extern struct net_port_counters net_port_counters[NET_PORT_COUNT];
+
+static inline void net_counter_inc(enum net_port_id id, enum net_counter cnt)
+{
+    atomic_inc(&net_port_counters[id].count[cnt]);
+}
+
+/* Count an accepted packet and stamp its arrival */
+static inline void net_counter_rx(enum net_port_id id)
+{
+    atomic_inc(&net_port_counters[id].count[NET_CNT_RX]);
+    atomic_set(&net_port_counters[id].last_rx_ms, (atomic_val_t)k_uptime_get_32());
+}
+
+/* zsock_sendto() that counts the result against port `id` */
+int net_port_sendto(enum net_port_id id, int sock, const void *buf, size_t len,
+                    int flags, const struct sockaddr_in *dest);
+
+/* Sum of one counter over all ports */
+uint32_t net_counter_total(enum net_counter cnt);
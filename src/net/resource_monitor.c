@@ -1,33 +1,33 @@
 /*
- * Resource Monitor — periodic system telemetry sent to topside via UDP.
+ * Resource Monitor — system telemetry sampled at 1 Hz by the telemetry
+ * multiplexer.
  *
- * Reports CPU usage, stack/RAM stats, thread count, and UDP packet counters.
+ * Reports CPU usage, stack/RAM stats, thread count, and UDP packet totals
+ * summed over the per-port counters in net_counters.h, plus the network
+ * stack's own drop/error counters and net_pkt/net_buf pool low
+ * watermarks so the pool sizes in prj.conf can be set from real data.
  * Reuses the shared CRC32 and network constants from net.h.
  */
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/socket.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_stats.h>
 #include <string.h>
 
 #include "resource_monitor.h"
 #include "net.h"
+#include "telemetry.h"
+#include "net_counters.h"
+#include "stack_watermark.h"
 
 LOG_MODULE_DECLARE(k2_app, LOG_LEVEL_INF);
 
-#define TELEMETRY_INTERVAL_MS  1000
-#define MONITOR_STACK_SIZE     3072
-#define MONITOR_PRIORITY       9
 #define DIAG_LOG_EVERY_N       10   /* print diagnostics every N telemetry cycles */
-
-K_THREAD_STACK_DEFINE(monitor_stack, MONITOR_STACK_SIZE);
-static struct k_thread monitor_thread_data;
-
-static uint32_t telemetry_seq;
-static int      telem_sock = -1;
-
-static atomic_t udp_rx_count  = ATOMIC_INIT(0);
-static atomic_t udp_rx_errors = ATOMIC_INIT(0);
+#define NET_BUF_SAMPLE_MS      5    /* net_buf pool free-count sampling period */
 
 static uint8_t  cpu_usage_percent;
 static uint32_t prev_wall_cycles;
@@ -128,6 +128,7 @@ static void update_cpu_usage(void) { cpu_usage_percent = 0; }
 /* ------------------------------------------------------------------ */
 
 struct thread_stats {
+    uint32_t tick;                   /* telemetry tick, for stack_watermark_get() */
     uint8_t  count;
     uint32_t stack_total;
     uint32_t stack_used;
@@ -140,7 +141,7 @@ static void thread_stats_cb(const struct k_thread *t, void *out)
 
 #ifdef CONFIG_THREAD_STACK_INFO
     size_t unused;
-    if (k_thread_stack_space_get((struct k_thread *)t, &unused) == 0) {
+    if (stack_watermark_get(t, s->tick, &unused) == 0) {
         size_t size = t->stack_info.size;
         s->stack_total += size;
         s->stack_used  += (size - unused);
@@ -148,28 +149,118 @@ static void thread_stats_cb(const struct k_thread *t, void *out)
 #endif
 }
 
-static struct thread_stats get_thread_stats(void)
+/* Unlocked walk: the scheduler lock is not held across the stack checks */
+static struct thread_stats get_thread_stats(uint32_t tick)
 {
-    struct thread_stats s = {0};
-    k_thread_foreach(thread_stats_cb, &s);
+    struct thread_stats s = { .tick = tick };
+    k_thread_foreach_unlocked(thread_stats_cb, &s);
     return s;
 }
 
+/* ------------------------------------------------------------------ */
+/*  Network stack statistics                                           */
+/* ------------------------------------------------------------------ */
+
+static void net_stats_sample(telemetry_packet_t *p)
+{
+#ifdef CONFIG_NET_STATISTICS_USER_API
+    struct net_stats st;
+
+    if (net_mgmt(NET_REQUEST_STATS_GET_ALL, NULL, &st, sizeof(st)) == 0) {
+        p->ip_drop           = htonl(st.ipv4.drop);
+        p->udp_drop          = htonl(st.udp.drop);
+        p->chksum_errors     = htonl(st.ip_errors.chkerr + st.udp.chkerr);
+        p->processing_errors = htonl(st.processing_error);
+    }
+#endif
+#ifdef CONFIG_NET_STATISTICS_ETHERNET
+    struct net_stats_eth eth;
+
+    if (net_mgmt(NET_REQUEST_STATS_GET_ETHERNET, net_if_get_default(),
+                 &eth, sizeof(eth)) == 0) {
+        p->eth_rx_errors = htonl(eth.errors.rx);
+        p->eth_tx_errors = htonl(eth.errors.tx);
+    }
+#endif
+    ARG_UNUSED(p);
+}
+
+/*
+ * net_pkt slabs track their own high-water mark.  net_buf pools only
+ * expose the current free count, so a timer samples it every
+ * NET_BUF_SAMPLE_MS and keeps the minimum; a burst shorter than that can
+ * be missed, but queue build-up under load cannot.
+ */
+#ifdef CONFIG_NET_BUF_POOL_USAGE
+static struct net_buf_pool *buf_rx_pool;
+static struct net_buf_pool *buf_tx_pool;
+static atomic_t buf_rx_min_free = ATOMIC_INIT(UINT16_MAX);
+static atomic_t buf_tx_min_free = ATOMIC_INIT(UINT16_MAX);
+
+static void buf_track_min(atomic_t *min, const struct net_buf_pool *pool)
+{
+    atomic_val_t now = atomic_get(&pool->avail_count);
+
+    if (now < atomic_get(min)) {
+        atomic_set(min, now);
+    }
+}
+
+static void buf_sample_fn(struct k_timer *timer)
+{
+    ARG_UNUSED(timer);
+
+    buf_track_min(&buf_rx_min_free, buf_rx_pool);
+    buf_track_min(&buf_tx_min_free, buf_tx_pool);
+}
+
+K_TIMER_DEFINE(buf_sample_timer, buf_sample_fn, NULL);
+#endif
+
+static void net_pools_sample(telemetry_packet_t *p)
+{
+    struct k_mem_slab *rx_slab, *tx_slab;
+    struct net_buf_pool *rx_data, *tx_data;
+
+    net_pkt_get_info(&rx_slab, &tx_slab, &rx_data, &tx_data);
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+    p->pkt_rx_min_free = htons(rx_slab->info.num_blocks - k_mem_slab_max_used_get(rx_slab));
+    p->pkt_tx_min_free = htons(tx_slab->info.num_blocks - k_mem_slab_max_used_get(tx_slab));
+#endif
+    p->pkt_rx_total = htons(rx_slab->info.num_blocks);
+    p->pkt_tx_total = htons(tx_slab->info.num_blocks);
+
+#ifdef CONFIG_NET_BUF_POOL_USAGE
+    if (!buf_rx_pool) {
+        buf_rx_pool = rx_data;
+        buf_tx_pool = tx_data;
+        buf_sample_fn(NULL);
+        k_timer_start(&buf_sample_timer, K_MSEC(NET_BUF_SAMPLE_MS),
+                      K_MSEC(NET_BUF_SAMPLE_MS));
+    }
+    p->buf_rx_min_free = htons((uint16_t)atomic_get(&buf_rx_min_free));
+    p->buf_tx_min_free = htons((uint16_t)atomic_get(&buf_tx_min_free));
+#endif
+    p->buf_rx_total = htons(rx_data->buf_count);
+    p->buf_tx_total = htons(tx_data->buf_count);
+}
+
 /* ------------------------------------------------------------------ */
 /*  Telemetry packet build & send                                      */
 /* ------------------------------------------------------------------ */
 
-static void build_telemetry(telemetry_packet_t *p)
+static void build_telemetry(telemetry_packet_t *p, uint32_t sequence,
+                            const struct thread_stats *ts)
 {
     memset(p, 0, sizeof(*p));
 
-    p->sequence          = htonl(telemetry_seq);
+    p->sequence          = htonl(sequence);
     p->uptime_ms         = htonl((uint32_t)k_uptime_get());
     p->cpu_usage_percent = cpu_usage_percent;
 
     /* Aggregate stack watermarks across all threads */
-    struct thread_stats ts = get_thread_stats();
-    p->thread_count = ts.count;
+    p->thread_count = ts->count;
 
     /*
      * RAM budget.  CONFIG_SRAM_SIZE is the full physical SRAM on the
@@ -194,110 +285,80 @@ static void build_telemetry(telemetry_packet_t *p)
      */
     uint32_t total_bytes = (uint32_t)total_kb * 1024;
     uint8_t  used_pct    = (total_bytes > 0)
-                         ? (uint8_t)((ts.stack_used * 100U) / total_bytes)
+                         ? (uint8_t)((ts->stack_used * 100U) / total_bytes)
                          : 0;
-    uint16_t used_kb     = (uint16_t)(ts.stack_used / 1024);
+    uint16_t used_kb     = (uint16_t)(ts->stack_used / 1024);
     uint16_t free_kb     = (total_kb > used_kb) ? (total_kb - used_kb) : 0;
     p->ram_free_kb       = htons(free_kb);
     p->ram_used_percent  = used_pct;
 
-    p->udp_rx_count  = htonl((uint32_t)atomic_get(&udp_rx_count));
-    p->udp_rx_errors = htonl((uint32_t)atomic_get(&udp_rx_errors));
+    uint32_t rx_errors = net_counter_total(NET_CNT_RX_ERR) +
+                         net_counter_total(NET_CNT_CRC) +
+                         net_counter_total(NET_CNT_SIZE) +
+                         net_counter_total(NET_CNT_TYPE) +
+                         net_counter_total(NET_CNT_REJECTED) +
+                         net_counter_total(NET_CNT_SOURCE);
+    p->udp_rx_count  = htonl(net_counter_total(NET_CNT_RX));
+    p->udp_rx_errors = htonl(rx_errors);
+
+    net_stats_sample(p);
+    net_pools_sample(p);
 
     size_t crc_len = sizeof(*p) - sizeof(p->crc32);
     p->crc32 = htonl(crc32_calc(p, crc_len));
 }
 
-static int send_telemetry(const struct sockaddr_in *dest)
-{
-    telemetry_packet_t pkt;
-    build_telemetry(&pkt);
-
-    int ret = zsock_sendto(telem_sock, &pkt, sizeof(pkt), 0,
-                           (struct sockaddr *)dest, sizeof(*dest));
-    if (ret < 0) {
-        LOG_ERR("telemetry send: %d", ret);
-        return ret;
-    }
-    telemetry_seq++;
-    return 0;
-}
-
-/* ------------------------------------------------------------------ */
-/*  Monitor thread                                                     */
-/* ------------------------------------------------------------------ */
-
-static void monitor_thread(void *a, void *b, void *c)
+/* Print raw diagnostics every DIAG_LOG_EVERY_N samples so the
+ * serial console can confirm the values are actually changing. */
+static void log_diagnostics(uint32_t sequence, const struct thread_stats *ts)
 {
-    ARG_UNUSED(a); ARG_UNUSED(b); ARG_UNUSED(c);
-
-    /* Wait for the network stack */
-    while (!network_ready) {
-        k_sleep(K_MSEC(100));
-    }
+    static uint32_t diag_counter;
 
-    /* Open a UDP socket for telemetry — retry on failure */
-    while (telem_sock < 0) {
-        telem_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-        if (telem_sock < 0) {
-            LOG_ERR("telemetry socket: %d  (retry in 1 s)", telem_sock);
-            k_sleep(K_MSEC(1000));
-        }
+    if (++diag_counter < DIAG_LOG_EVERY_N) {
+        return;
     }
+    diag_counter = 0;
 
-    /* Build destination address once */
-    struct sockaddr_in dest = {
-        .sin_family = AF_INET,
-        .sin_port   = htons(TELEMETRY_UDP_PORT),
-    };
-    zsock_inet_pton(AF_INET, TOPSIDE_IP, &dest.sin_addr);
-
-    int on = 1;
-    zsock_setsockopt(telem_sock, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
-
-    LOG_INF("Resource monitor started (port %d)", TELEMETRY_UDP_PORT);
-
-    uint32_t diag_counter = 0;
-
-    while (1) {
-        update_cpu_usage();
-        send_telemetry(&dest);
-
-        /* Print raw diagnostics every DIAG_LOG_EVERY_N seconds so the
-         * serial console can confirm the values are actually changing. */
-        if (++diag_counter >= DIAG_LOG_EVERY_N) {
-            diag_counter = 0;
-            struct thread_stats ts = get_thread_stats();
 #ifdef CONFIG_SRAM_SIZE
-            uint32_t total_b = (uint32_t)CONFIG_SRAM_SIZE * 1024;
+    uint32_t total_b = (uint32_t)CONFIG_SRAM_SIZE * 1024;
 #else
-            uint32_t total_b = 512U * 1024;
+    uint32_t total_b = 512U * 1024;
 #endif
-            LOG_INF("[diag] cpu=%u%%  stack_used=%u B /%u B  "
-                    "threads=%u  udp_rx=%u  seq=%u",
-                    cpu_usage_percent,
-                    ts.stack_used, total_b,
-                    ts.count,
-                    (uint32_t)atomic_get(&udp_rx_count),
-                    telemetry_seq);
-        }
-
-        k_sleep(K_MSEC(TELEMETRY_INTERVAL_MS));
-    }
+    LOG_INF("[diag] cpu=%u%%  stack_used=%u B /%u B  "
+            "threads=%u  udp_rx=%u  seq=%u",
+            cpu_usage_percent,
+            ts->stack_used, total_b,
+            ts->count,
+            net_counter_total(NET_CNT_RX),
+            sequence);
 }
 
-void resource_monitor_start(void)
+static size_t resource_telem_fill(uint8_t *buf, size_t max, uint32_t sequence)
 {
-    k_tid_t tid = k_thread_create(&monitor_thread_data,
-                                   monitor_stack,
-                                   K_THREAD_STACK_SIZEOF(monitor_stack),
-                                   monitor_thread,
-                                   NULL, NULL, NULL,
-                                   MONITOR_PRIORITY, 0, K_NO_WAIT);
-    if (tid) {
-        k_thread_name_set(tid, "res_monitor");
+    telemetry_packet_t pkt;
+
+    if (sizeof(pkt) > max) {
+        return 0;
     }
+
+    /* One walk per sample, shared by the packet and the diagnostics */
+    struct thread_stats ts = get_thread_stats(sequence);
+
+    update_cpu_usage();
+    build_telemetry(&pkt, sequence, &ts);
+    log_diagnostics(sequence, &ts);
+
+    memcpy(buf, &pkt, sizeof(pkt));
+    return sizeof(pkt);
 }
 
-void resource_monitor_inc_udp_rx(void)    { atomic_inc(&udp_rx_count);  }
-void resource_monitor_inc_udp_errors(void){ atomic_inc(&udp_rx_errors); }
+/* 1 Hz, and no faster for subscribers: each sample walks every thread */
+const struct telem_channel resource_telem_channel = {
+    .name        = "resource",
+    .id          = TELEM_CH_RESOURCE,
+    .divider     = 50,
+    .min_divider = 50,
+    .legacy_port = TELEMETRY_UDP_PORT,
+    .max_len     = sizeof(telemetry_packet_t),
+    .fill        = resource_telem_fill,
+};
@@ -3,14 +3,14 @@
 #include <zephyr/kernel.h>
 #include <stdint.h>
 
-/* Telemetry packet sent to topside.
+/* Telemetry record sent to topside at 1 Hz (resource_telem_channel).
  *
  * "ram" fields reflect aggregate thread-stack watermarks, NOT heap.
  * Zephyr has no single system-wide heap query, so this is the best
  * proxy for overall memory pressure.
  */
 typedef struct {
-    uint32_t sequence;
+    uint32_t sequence;           /* telemetry tick */
     uint32_t uptime_ms;
     uint8_t  cpu_usage_percent;  /* 0-100 */
     uint8_t  ram_used_percent;   /* 0-100  (stack watermarks / SRAM) */
@@ -18,14 +18,23 @@ typedef struct {
     uint16_t ram_total_kb;       /* CONFIG_SRAM_SIZE */
     uint8_t  thread_count;
     uint8_t  reserved;
-    uint32_t udp_rx_count;
+    uint32_t udp_rx_count;       /* all ports, see net_counters.h */
     uint32_t udp_rx_errors;
+    /* Network stack (net_stats), cumulative since boot */
+    uint32_t ip_drop;            /* IPv4 packets dropped */
+    uint32_t udp_drop;           /* UDP packets dropped (no socket, queue full) */
+    uint32_t chksum_errors;      /* IPv4 header + UDP checksum errors */
+    uint32_t processing_errors;  /* packets the stack failed to process */
+    uint32_t eth_rx_errors;      /* reported by the Ethernet driver */
+    uint32_t eth_tx_errors;
+    /* Pool low watermarks: fewest free ever seen, and pool size */
+    uint16_t pkt_rx_min_free;    /* net_pkt RX slab */
+    uint16_t pkt_rx_total;
+    uint16_t pkt_tx_min_free;    /* net_pkt TX slab */
+    uint16_t pkt_tx_total;
+    uint16_t buf_rx_min_free;    /* net_buf RX data pool */
+    uint16_t buf_rx_total;
+    uint16_t buf_tx_min_free;    /* net_buf TX data pool */
+    uint16_t buf_tx_total;
     uint32_t crc32;
 } __attribute__((packed)) telemetry_packet_t;
-
-/* Start the resource monitor thread */
-void resource_monitor_start(void);
-
-/* Called from net.c on valid packet / error */
-void resource_monitor_inc_udp_rx(void);
-void resource_monitor_inc_udp_errors(void);
@@ -1,4 +0,0 @@
-#pragma once
-
-/* Start the setpoint override UDP listener thread (port 5007) */
-void setpoint_override_start(void);
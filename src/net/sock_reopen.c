@@ -0,0 +1,15 @@
+#include "sock_reopen.h"
+
+enum sock_reopen_step sock_reopen_check(struct sock_reopen *r, uint32_t link_gen,
+                                        int64_t now_ms, int32_t retry_interval_ms)
+{
+    if (r->sock >= 0 && r->gen == link_gen) {
+        return SOCK_REOPEN_READY;
+    }
+    if (now_ms < r->retry_ms) {
+        return SOCK_REOPEN_WAIT;
+    }
+    r->retry_ms = now_ms + retry_interval_ms;
+    r->gen = link_gen;
+    return SOCK_REOPEN_OPEN;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * When to re-open a UDP socket after a link bounce, for backends that
+ * open theirs lazily (log_backend_udp.c).
+ *
+ * A socket opened before the last link-down can no longer send, and
+ * socket() itself can fail while the stack settles after link-up, so
+ * the socket is re-opened whenever it is missing or from an older link
+ * generation, but at most once per retry interval.  This unit only
+ * decides; the caller closes and opens.
+ *
+ * No Zephyr dependencies, so tools/log_reopen_sim.c drives this very
+ * code through simulated link bounces on the host.
+ */
+
+struct sock_reopen {
+    int      sock;          /* -1 when there is none */
+    uint32_t gen;           /* link generation sock was opened in */
+    int64_t  retry_ms;      /* uptime of the next open attempt; 0 = now */
+};
+
+#define SOCK_REOPEN_INIT  { .sock = -1 }
+
+enum sock_reopen_step {
+    SOCK_REOPEN_READY = 0,  /* r->sock is usable on the current link */
+    SOCK_REOPEN_WAIT,       /* no usable socket, next attempt not due yet */
+    SOCK_REOPEN_OPEN,       /* close r->sock if >= 0 and store a new one */
+};
+
+/*
+ * Decide for link generation link_gen at now_ms.  On SOCK_REOPEN_OPEN
+ * the attempt is already recorded: the generation is taken before the
+ * caller's socket(), and the next attempt is due retry_interval_ms
+ * later whether or not this one succeeds.
+ */
+enum sock_reopen_step sock_reopen_check(struct sock_reopen *r, uint32_t link_gen,
+                                        int64_t now_ms, int32_t retry_interval_ms);
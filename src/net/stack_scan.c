@@ -0,0 +1,28 @@
+/*
+ * Stack fill scan — see stack_scan.h
+ *
+ * Bytes up to the first word boundary, then whole words while they are
+ * all fill, then bytes again to find where in the last word the fill
+ * stops.  Works for any base alignment and size.
+ */
+
+#include "stack_scan.h"
+
+size_t stack_scan_unused(const uint8_t *base, size_t size)
+{
+    size_t i = 0;
+
+    while (i < size && ((uintptr_t)&base[i] & 3U)) {
+        if (base[i] != STACK_FILL_BYTE) {
+            return i;
+        }
+        i++;
+    }
+    while (i + 4 <= size && *(const uint32_t *)&base[i] == STACK_FILL_WORD) {
+        i += 4;
+    }
+    while (i < size && base[i] == STACK_FILL_BYTE) {
+        i++;
+    }
+    return i;
+}
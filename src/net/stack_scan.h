@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Word-wise scan of a CONFIG_INIT_STACKS-filled stack, for
+ * stack_watermark.c.
+ *
+ * No Zephyr dependencies, so tools/stack_watermark_bench.c checks this
+ * very code against a byte-by-byte scan on the host.
+ */
+
+#define STACK_FILL_BYTE  0xaaU          /* CONFIG_INIT_STACKS pattern */
+#define STACK_FILL_WORD  0xaaaaaaaaU
+
+/*
+ * Offset of the first byte in [base, base + size) that is not the fill,
+ * or `size` if there is none: for a stack growing down, the bytes never
+ * used.  Same result as k_thread_stack_space_get()'s byte-wise loop.
+ */
+size_t stack_scan_unused(const uint8_t *base, size_t size);
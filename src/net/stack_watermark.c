@@ -0,0 +1,96 @@
+/*
+ * Stack watermarks — word-wise replacement for calling
+ * k_thread_stack_space_get() on every thread once a second
+ *
+ * The resource monitor and the thread telemetry channel both sample
+ * every thread at 1 Hz, on the same tick, and k_thread_stack_space_get()
+ * compares the unused part of each stack one byte at a time.  Answers
+ * are shared within a tick; see stack_watermark.h.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "stack_watermark.h"
+#include "stack_scan.h"
+
+LOG_MODULE_DECLARE(k2_app, LOG_LEVEL_INF);
+
+#define WATERMARK_SLOTS  48             /* threads whose answer is kept */
+
+/*
+ * Last answer for one thread.  The firmware's threads are static, so
+ * slots are never freed, as with thread_telemetry.c's baselines; with
+ * the table full a thread is simply scanned on every query.
+ */
+struct watermark {
+    const struct k_thread *tid;         /* NULL = free slot */
+    bool     valid;                     /* unused holds the answer for tick */
+    uint32_t tick;
+    size_t   unused;
+};
+
+static struct watermark marks[WATERMARK_SLOTS];
+
+#ifdef CONFIG_K2_STACK_WATERMARK_VERIFY
+static void watermark_verify(const struct k_thread *t, size_t unused)
+{
+    size_t full;
+
+    if (k_thread_stack_space_get(t, &full) == 0 && full != unused) {
+        const char *name = k_thread_name_get((k_tid_t)t);
+
+        LOG_WRN("Stack watermark %s: %u B unused, full scan %u B",
+                name ? name : "?", (unsigned)unused, (unsigned)full);
+    }
+}
+#endif
+
+static struct watermark *mark_get(const struct k_thread *t)
+{
+    struct watermark *free_slot = NULL;
+
+    for (size_t i = 0; i < ARRAY_SIZE(marks); i++) {
+        if (marks[i].tid == t) {
+            return &marks[i];
+        }
+        if (!free_slot && !marks[i].tid) {
+            free_slot = &marks[i];
+        }
+    }
+    if (free_slot) {
+        free_slot->tid = t;
+        free_slot->valid = false;
+    }
+    return free_slot;
+}
+
+int stack_watermark_get(const struct k_thread *thread, uint32_t tick, size_t *unused)
+{
+    struct watermark *m = mark_get(thread);
+
+    if (m && m->valid && m->tick == tick) {
+        *unused = m->unused;
+        return 0;
+    }
+
+#if defined(CONFIG_THREAD_STACK_INFO) && !defined(CONFIG_STACK_GROWS_UP)
+    *unused = stack_scan_unused((const uint8_t *)thread->stack_info.start,
+                                thread->stack_info.size);
+#ifdef CONFIG_K2_STACK_WATERMARK_VERIFY
+    watermark_verify(thread, *unused);
+#endif
+#else
+    int err = k_thread_stack_space_get(thread, unused);
+    if (err) {
+        return err;
+    }
+#endif
+
+    if (m) {
+        m->valid  = true;
+        m->tick   = tick;
+        m->unused = *unused;
+    }
+    return 0;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <stddef.h>
+
+/*
+ * Stack high-water marks, for the telemetry thread.
+ *
+ * k_thread_stack_space_get() scans a stack byte by byte from its far end
+ * up to the first byte that is not the CONFIG_INIT_STACKS fill.  This
+ * gives the same count but compares a word at a time, so the never-used
+ * part of each stack costs a quarter of the loads.  That part is read in
+ * full on every call rather than cached: any byte of it may have been
+ * written since the last call (a large local the thread never touched
+ * can be skipped past), and only a full read returns what the full scan
+ * does.  CONFIG_K2_STACK_WATERMARK_VERIFY checks every answer against
+ * k_thread_stack_space_get().
+ *
+ * The resource and thread channels both want every stack on the same
+ * telemetry tick, so each thread's answer is kept for the tick it was
+ * scanned on: the second query in a tick costs a table lookup, and each
+ * stack is scanned at most once per tick.  Telemetry thread only.
+ */
+
+/*
+ * Like k_thread_stack_space_get(), same result; `tick` is the telemetry
+ * tick (the fill's sequence) the answer may be shared within.
+ */
+int stack_watermark_get(const struct k_thread *thread, uint32_t tick, size_t *unused);
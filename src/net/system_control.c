@@ -1,8 +1,13 @@
 /*
- * System Control — UDP listener for high-level MCU control commands.
+ * System Control — UDP service for high-level MCU control commands.
  *
- * Listens on SYSTEM_CONTROL_PORT (5008) for reset packets:
- *   | magic "RST1" (4B) | sequence (u32 big-endian) | crc32 (u32 big-endian) |
+ * Handles command packets on SYSTEM_CONTROL_PORT (5008), delivered by
+ * the UDP dispatcher:
+ *   | magic (4B) | argument (u32 big-endian) | crc32 (u32 big-endian) |
+ *
+ *   "RST1"  reset the MCU; argument is a sequence number for the log
+ *   "LNK1"  enable the link self-test for argument seconds, 0 = disable
+ *           (CONFIG_K2_LINK_TEST, see link_test.h)
  */
 
 #include <zephyr/kernel.h>
@@ -13,101 +18,55 @@
 
 #include "net.h"
 #include "resource_monitor.h"
-#include "system_control.h"
+#include "udp_dispatch.h"
+#include "link_test.h"
 
 LOG_MODULE_REGISTER(system_control, LOG_LEVEL_INF);
 
-#define RESET_MAGIC "RST1"
-#define STACK_SIZE 2048
+#define RESET_MAGIC     "RST1"
+#define LINK_TEST_MAGIC "LNK1"
 
 typedef struct {
     char magic[4];
-    uint32_t sequence;
+    uint32_t arg;
     uint32_t crc32;
-} __attribute__((packed)) reset_packet_t;
-
-K_THREAD_STACK_DEFINE(system_control_stack, STACK_SIZE);
-static struct k_thread system_control_thread_data;
+} __attribute__((packed)) sysctl_packet_t;
 
-static void system_control_thread(void *a, void *b, void *c)
+static int system_control_handle(int sock, const uint8_t *data, size_t len,
+                                 const struct sockaddr_in *from)
 {
-    ARG_UNUSED(a);
-    ARG_UNUSED(b);
-    ARG_UNUSED(c);
-
-    while (!network_ready) {
-        k_sleep(K_MSEC(100));
-    }
-
-    int sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (sock < 0) {
-        LOG_ERR("Failed to create system control socket: %d", sock);
-        return;
+    ARG_UNUSED(sock); ARG_UNUSED(len); ARG_UNUSED(from);
+
+    const sysctl_packet_t *pkt = (const sysctl_packet_t *)data;
+
+    if (memcmp(pkt->magic, LINK_TEST_MAGIC, sizeof(pkt->magic)) == 0) {
+#ifdef CONFIG_K2_LINK_TEST
+        link_test_enable(ntohl(pkt->arg));
+        return 0;
+#else
+        LOG_WRN("System control: link test not built in");
+        return -ENOTSUP;
+#endif
     }
 
-    struct sockaddr_in bind_addr = {
-        .sin_family = AF_INET,
-        .sin_addr.s_addr = INADDR_ANY,
-        .sin_port = htons(SYSTEM_CONTROL_PORT),
-    };
-
-    if (zsock_bind(sock, (struct sockaddr *)&bind_addr, sizeof(bind_addr)) < 0) {
-        LOG_ERR("Failed to bind system control socket");
-        zsock_close(sock);
-        return;
+    if (memcmp(pkt->magic, RESET_MAGIC, sizeof(pkt->magic)) != 0) {
+        LOG_WRN("System control: unknown command");
+        return -ENOMSG;
     }
 
-    LOG_INF("System control listener ready on port %d", SYSTEM_CONTROL_PORT);
-
-    reset_packet_t pkt;
-    struct sockaddr_in client;
-    socklen_t client_len = sizeof(client);
-
-    while (1) {
-        int ret = zsock_recvfrom(sock, &pkt, sizeof(pkt), 0,
-                                 (struct sockaddr *)&client, &client_len);
-
-        if (ret != sizeof(pkt)) {
-            if (ret < 0) {
-                LOG_ERR("System control recv error: %d", ret);
-                k_sleep(K_MSEC(100));
-            } else {
-                LOG_WRN("System control: wrong size %d (expected %d)",
-                        ret, (int)sizeof(pkt));
-            }
-            continue;
-        }
-
-        uint32_t calc_crc = crc32_calc(&pkt, sizeof(pkt) - sizeof(pkt.crc32));
-        uint32_t recv_crc = ntohl(pkt.crc32);
-        if (calc_crc != recv_crc) {
-            LOG_WRN("System control CRC mismatch");
-            resource_monitor_inc_udp_errors();
-            continue;
-        }
-
-        if (memcmp(pkt.magic, RESET_MAGIC, sizeof(pkt.magic)) != 0) {
-            LOG_WRN("System control: unknown command");
-            resource_monitor_inc_udp_errors();
-            continue;
-        }
-
-        resource_monitor_inc_udp_rx();
-        LOG_WRN("MCU reset requested by topside (seq #%u)", ntohl(pkt.sequence));
-        k_msleep(100);
-        sys_reboot(SYS_REBOOT_COLD);
-    }
+    LOG_WRN("MCU reset requested by topside (seq #%u)", ntohl(pkt->arg));
+    k_msleep(100);
+    sys_reboot(SYS_REBOOT_COLD);
+    return 0;
 }
 
-void system_control_start(void)
-{
-    k_tid_t tid = k_thread_create(&system_control_thread_data,
-                                  system_control_stack,
-                                  K_THREAD_STACK_SIZEOF(system_control_stack),
-                                  system_control_thread,
-                                  NULL, NULL, NULL,
-                                  K_PRIO_COOP(7), 0, K_NO_WAIT);
-    if (tid) {
-        k_thread_name_set(tid, "system_control");
-    }
-}
+const struct udp_service system_control_service = {
+    .name     = "System control",
+    .port     = SYSTEM_CONTROL_PORT,
+    .min_len  = sizeof(sysctl_packet_t),
+    .max_len  = sizeof(sysctl_packet_t),
+    .crc      = UDP_CRC_NET,
+    .handler  = system_control_handle,
+    .counters = NET_PORT_SYSTEM_CONTROL,
+    .priority = NET_PRIO_CONTROL,
+};
@@ -1,4 +0,0 @@
-#pragma once
-
-/* Start the system control UDP listener thread (port 5008). */
-void system_control_start(void);
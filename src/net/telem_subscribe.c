@@ -0,0 +1,219 @@
+/*
+ * Telemetry subscriptions — UDP service on TELEM_SUBSCRIBE_PORT (5013)
+ *
+ * Keeps the lease table the multiplexer reads each tick.  The handler
+ * runs in the dispatcher thread and the reader in the telemetry thread,
+ * so the table sits behind a spinlock; both sides only copy a few
+ * hundred bytes while holding it.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <string.h>
+
+#include "telem_subscribe.h"
+#include "telemetry.h"
+#include "net.h"
+#include "udp_dispatch.h"
+
+LOG_MODULE_REGISTER(telem_sub, LOG_LEVEL_INF);
+
+struct sub_entry {
+    bool     active;
+    int64_t  expires_ms;
+    struct telem_subscriber sub;
+};
+
+static struct sub_entry subs[TELEM_MAX_SUBSCRIBERS];
+static struct k_spinlock subs_lock;
+
+static bool sub_empty(const struct telem_subscriber *s)
+{
+    for (size_t i = 0; i < TELEM_CH_ID_LIMIT; i++) {
+        if (s->divider[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Caller holds subs_lock */
+static struct sub_entry *sub_find(const struct sockaddr_in *addr, bool create)
+{
+    struct sub_entry *free_slot = NULL;
+
+    for (size_t i = 0; i < TELEM_MAX_SUBSCRIBERS; i++) {
+        struct sub_entry *e = &subs[i];
+
+        if (!e->active) {
+            free_slot = free_slot ? free_slot : e;
+            continue;
+        }
+        if (e->sub.addr.sin_addr.s_addr == addr->sin_addr.s_addr &&
+            e->sub.addr.sin_port == addr->sin_port) {
+            return e;
+        }
+    }
+
+    if (!create || !free_slot) {
+        return NULL;
+    }
+    memset(free_slot, 0, sizeof(*free_slot));
+    free_slot->active = true;
+    free_slot->sub.addr = *addr;
+    return free_slot;
+}
+
+/*
+ * Divider for a requested interval, no faster than the channel allows;
+ * 0 if the channel cannot be sent
+ */
+static uint16_t grant_divider(const struct telem_channel *ch, uint16_t period_ms)
+{
+    if (period_ms == 0) {
+        return ch->divider;
+    }
+    return (uint16_t)MAX(period_ms / TELEM_BASE_TICK_MS, MAX(ch->min_divider, 1U));
+}
+
+static int subscribe(const telem_sub_packet_t *req, const struct sockaddr_in *addr,
+                     telem_sub_packet_t *reply)
+{
+    uint16_t divider[TELEM_CH_ID_LIMIT] = {0};
+    uint16_t granted = 0;
+    uint16_t slowest = 0;
+
+    if (req->channel >= TELEM_CH_ID_LIMIT) {
+        return -EINVAL;
+    }
+    for (uint8_t id = 1; id < TELEM_CH_ID_LIMIT; id++) {
+        const struct telem_channel *ch = telemetry_channel_find(id);
+
+        if (!ch || (req->channel != 0 && req->channel != id)) {
+            continue;
+        }
+        /* "Every channel" means every channel that is on by default */
+        if (req->channel == 0 && ch->divider == 0) {
+            continue;
+        }
+        divider[id] = grant_divider(ch, req->period_ms);
+        granted = divider[id];
+        slowest = MAX(slowest, granted);
+    }
+    if (granted == 0) {
+        return -EINVAL;
+    }
+
+    uint16_t lease_s = req->lease_s ? req->lease_s : TELEM_SUB_LEASE_DEFAULT_S;
+    lease_s = MIN(lease_s, TELEM_SUB_LEASE_MAX_S);
+
+    k_spinlock_key_t key = k_spin_lock(&subs_lock);
+    struct sub_entry *e = sub_find(addr, true);
+    if (e) {
+        for (size_t id = 0; id < TELEM_CH_ID_LIMIT; id++) {
+            if (divider[id]) {
+                e->sub.divider[id] = divider[id];
+            }
+        }
+        e->expires_ms = k_uptime_get() + (int64_t)lease_s * 1000;
+    }
+    k_spin_unlock(&subs_lock, key);
+
+    if (!e) {
+        LOG_WRN("Telemetry subscribe: table full");
+        return -ENOSPC;
+    }
+
+    if (req->channel != 0) {
+        reply->period_ms = granted * TELEM_BASE_TICK_MS;
+    } else if (req->period_ms != 0) {
+        reply->period_ms = slowest * TELEM_BASE_TICK_MS;
+    }
+    reply->lease_s   = lease_s;
+    return 0;
+}
+
+static void unsubscribe(const telem_sub_packet_t *req, const struct sockaddr_in *addr)
+{
+    k_spinlock_key_t key = k_spin_lock(&subs_lock);
+    struct sub_entry *e = sub_find(addr, false);
+    if (e) {
+        if (req->channel != 0 && req->channel < TELEM_CH_ID_LIMIT) {
+            e->sub.divider[req->channel] = 0;
+        }
+        if (req->channel == 0 || sub_empty(&e->sub)) {
+            e->active = false;
+        }
+    }
+    k_spin_unlock(&subs_lock, key);
+}
+
+size_t telem_subscribers_get(struct telem_subscriber *out, size_t max)
+{
+    int64_t now = k_uptime_get();
+    size_t n = 0;
+
+    k_spinlock_key_t key = k_spin_lock(&subs_lock);
+    for (size_t i = 0; i < TELEM_MAX_SUBSCRIBERS; i++) {
+        struct sub_entry *e = &subs[i];
+
+        if (e->active && now >= e->expires_ms) {
+            e->active = false;
+        }
+        if (e->active && n < max) {
+            out[n++] = e->sub;
+        }
+    }
+    k_spin_unlock(&subs_lock, key);
+    return n;
+}
+
+static int telem_sub_handle(int sock, const uint8_t *data, size_t len,
+                            const struct sockaddr_in *from)
+{
+    ARG_UNUSED(len);
+
+    const telem_sub_packet_t *req = (const telem_sub_packet_t *)data;
+    struct sockaddr_in addr = *from;
+    int err = 0;
+
+    if (req->port != 0) {
+        addr.sin_port = htons(req->port);
+    }
+
+    telem_sub_packet_t reply = {
+        .type    = TELEM_SUB_ACK,
+        .channel = req->channel,
+        .port    = ntohs(addr.sin_port),
+    };
+
+    switch (req->type) {
+    case TELEM_SUB_SUBSCRIBE:
+        err = subscribe(req, &addr, &reply);
+        break;
+
+    case TELEM_SUB_UNSUBSCRIBE:
+        unsubscribe(req, &addr);
+        break;
+
+    default:
+        LOG_WRN("Telemetry subscribe: unknown packet type 0x%02X", req->type);
+        return -ENOMSG;
+    }
+
+    reply.crc32 = crc32_calc(&reply, sizeof(reply) - sizeof(reply.crc32));
+    net_port_sendto(NET_PORT_TELEM_SUBSCRIBE, sock, &reply, sizeof(reply), 0, from);
+    return err;
+}
+
+const struct udp_service telem_subscribe_service = {
+    .name     = "Telemetry subscribe",
+    .port     = TELEM_SUBSCRIBE_PORT,
+    .min_len  = sizeof(telem_sub_packet_t),
+    .max_len  = sizeof(telem_sub_packet_t),
+    .crc      = UDP_CRC_NATIVE,
+    .handler  = telem_sub_handle,
+    .counters = NET_PORT_TELEM_SUBSCRIBE,
+    .priority = NET_PRIO_TELEMETRY,
+};
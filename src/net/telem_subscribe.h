@@ -0,0 +1,66 @@
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "telemetry.h"
+
+/*
+ * Telemetry subscriptions on TELEM_SUBSCRIBE_PORT.
+ *
+ * A console or recorder subscribes to the channels it wants, each at its
+ * own interval, and the multiplexer sends those records unicast to it
+ * instead of broadcasting to TOPSIDE_IP.  Broadcast with the channels'
+ * default intervals stays the fallback while nobody is subscribed.
+ *
+ * Subscriptions are leased: every SUBSCRIBE renews the lease of the
+ * subscriber (address + port) for all of its channels, and a subscriber
+ * whose lease runs out is dropped, so a crashed console stops costing
+ * tether bandwidth within lease_s.
+ *
+ * Packet (12 bytes, native byte order):
+ *   | type (1B) | channel (1B) | period_ms (2B) | port (2B) | lease_s (2B)
+ *   | crc32 (4B)
+ *
+ *   SUBSCRIBE    channel 0 = every enabled channel; period_ms 0 = the
+ *                channel's default; port 0 = the sender's source port;
+ *                lease_s 0 = TELEM_SUB_LEASE_DEFAULT_S
+ *   UNSUBSCRIBE  channel 0 = drop the subscriber entirely
+ *   ACK          reply to both, with the granted period_ms and lease_s;
+ *                lease_s 0 means the request was refused (or, for
+ *                UNSUBSCRIBE, that nothing is left)
+ *
+ * A channel that is costly to sample (the thread walks behind resource
+ * and threads) has a minimum interval; a faster request is granted at
+ * that minimum and the ACK says so.  For channel 0 with a period the
+ * ACK carries the longest interval granted to any channel.
+ */
+
+#define TELEM_SUB_SUBSCRIBE    0x01
+#define TELEM_SUB_UNSUBSCRIBE  0x02
+#define TELEM_SUB_ACK          0x03
+
+#define TELEM_MAX_SUBSCRIBERS      4
+#define TELEM_SUB_LEASE_DEFAULT_S  10
+#define TELEM_SUB_LEASE_MAX_S      60
+
+typedef struct {
+    uint8_t  type;
+    uint8_t  channel;
+    uint16_t period_ms;
+    uint16_t port;
+    uint16_t lease_s;
+    uint32_t crc32;
+} __attribute__((packed)) telem_sub_packet_t;
+
+struct telem_subscriber {
+    struct sockaddr_in addr;
+    uint16_t divider[TELEM_CH_ID_LIMIT];   /* by channel id, 0 = not subscribed */
+};
+
+/*
+ * Copy the subscribers whose lease has not expired into out (at most
+ * max) and return how many there are.  Expired entries are freed.
+ */
+size_t telem_subscribers_get(struct telem_subscriber *out, size_t max);
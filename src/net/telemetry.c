@@ -0,0 +1,371 @@
+/*
+ * Telemetry multiplexer
+ *
+ * Replaces the per-channel sender threads (IMU at 5 Hz, control at
+ * 10 Hz, resources at 1 Hz).  Each of those owned a stack, a socket and
+ * its own sleep loop, so their samples drifted relative to each other
+ * and every sample cost a separate sendto().  Now a single thread runs
+ * a TELEM_BASE_TICK_MS tick on an absolute deadline, asks each channel
+ * whose divider is due for its record, and sends the records of a tick
+ * together in one datagram on TELEM_MUX_PORT.
+ *
+ * Each tick first samples every channel due for at least one
+ * destination into sample_buf, once, then copies the records each
+ * destination wants into its own datagrams.  Destinations are the
+ * subscribers from telem_subscribe.c, or TOPSIDE_IP with the channels'
+ * default dividers while there are none.
+ *
+ * Control channels (control, ctrl_stream) are packed into datagrams of
+ * their own and sent first, from a second socket at NET_PRIO_CONTROL.
+ * Everything else goes out at NET_PRIO_TELEMETRY, so an IMU or thread
+ * table burst cannot hold up a control record in the TX queue.
+ *
+ * With CONFIG_K2_TELEM_LEGACY_PORTS each record is instead broadcast on
+ * its own to the channel's old port, for topside tools that predate the
+ * multiplexed format.  Subscriptions are not available in that mode.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <string.h>
+
+#include "telemetry.h"
+#include "time_sync.h"
+#include "net.h"
+#include "net_counters.h"
+#ifndef CONFIG_K2_TELEM_LEGACY_PORTS
+#include "telem_subscribe.h"
+#endif
+
+LOG_MODULE_REGISTER(telemetry, LOG_LEVEL_INF);
+
+/* Resource stats walk every thread; legacy JSON IMU needs float printf */
+#ifdef CONFIG_K2_IMU_TELEM_JSON
+#define TELEM_STACK_SIZE 4096
+#else
+#define TELEM_STACK_SIZE 3072
+#endif
+#define TELEM_PRIORITY   9
+#define TELEM_SAMPLE_BUF 4096      /* every channel's worst-case record */
+
+static const struct telem_channel *const channels[] = {
+    &imu_telem_channel,
+    &control_telem_channel,
+    &resource_telem_channel,
+    &net_counters_channel,
+    &thread_telem_channel,
+#ifdef CONFIG_K2_CTRL_STREAM
+    &control_stream_channel,
+#endif
+};
+
+#define NUM_CHANNELS ARRAY_SIZE(channels)
+
+static uint8_t tx_buf[TELEM_MAX_DATAGRAM] __aligned(4);
+
+K_THREAD_STACK_DEFINE(telem_stack, TELEM_STACK_SIZE);
+static struct k_thread telem_thread_data;
+
+static int telem_sock = -1;             /* NET_PRIO_TELEMETRY */
+static int telem_ctrl_sock = -1;        /* NET_PRIO_CONTROL, control channels */
+static struct sockaddr_in telem_dest;
+static int64_t tick_topside_us;
+
+const struct telem_channel *telemetry_channel_find(uint8_t id)
+{
+    for (size_t i = 0; i < NUM_CHANNELS; i++) {
+        if (channels[i]->id == id) {
+            return channels[i];
+        }
+    }
+    return NULL;
+}
+
+static int channel_sock(const struct telem_channel *ch)
+{
+    return ch->control ? telem_ctrl_sock : telem_sock;
+}
+
+static int send_buf(int sock, const void *buf, size_t len, const struct sockaddr_in *dest)
+{
+    int ret = net_port_sendto(NET_PORT_TELEMETRY, sock, buf, len, 0, dest);
+    if (ret < 0) {
+        LOG_WRN("Telemetry send to port %u failed: %d", ntohs(dest->sin_port), errno);
+        return -errno;
+    }
+    return 0;
+}
+
+#ifdef CONFIG_K2_TELEM_LEGACY_PORTS
+
+static void run_tick(uint32_t tick, uint32_t tick_ms)
+{
+    ARG_UNUSED(tick_ms);
+
+    for (size_t i = 0; i < NUM_CHANNELS; i++) {
+        const struct telem_channel *ch = channels[i];
+
+        if (ch->divider == 0 || tick % ch->divider != 0) {
+            continue;
+        }
+        size_t len = ch->fill(tx_buf, sizeof(tx_buf), tick);
+        if (len > 0) {
+            telem_dest.sin_port = htons(ch->legacy_port);
+            send_buf(channel_sock(ch), tx_buf, len, &telem_dest);
+        }
+    }
+}
+
+#else
+
+static uint8_t sample_buf[TELEM_SAMPLE_BUF] __aligned(4);
+
+/* Where each channel's record (header + payload) sits in sample_buf */
+static struct {
+    uint16_t off;
+    uint16_t len;       /* 0 = not sampled this tick */
+} sampled[NUM_CHANNELS];
+
+/* Broadcast fallback: TOPSIDE_IP at the channels' default dividers */
+static struct telem_subscriber broadcast_dest;
+
+/* Telemetry thread only; static to keep it off the stack */
+static struct telem_subscriber dests[TELEM_MAX_SUBSCRIBERS];
+
+static size_t dgram_len;
+static uint8_t dgram_count;
+
+static bool due(uint16_t divider, uint32_t tick)
+{
+    return divider != 0 && tick % divider == 0;
+}
+
+static void dgram_begin(void)
+{
+    dgram_len = sizeof(telem_mux_header_t);
+    dgram_count = 0;
+}
+
+static void dgram_flush(int sock, uint32_t tick, uint32_t tick_ms,
+                        const struct sockaddr_in *dest)
+{
+    if (dgram_count == 0) {
+        return;
+    }
+
+    telem_mux_header_t *hdr = (telem_mux_header_t *)tx_buf;
+    hdr->version  = TELEM_MUX_VERSION;
+    hdr->count    = dgram_count;
+    hdr->length   = dgram_len + sizeof(uint32_t);
+    hdr->sequence = tick;
+    hdr->tick_ms  = tick_ms;
+    hdr->tick_topside_us = tick_topside_us;
+
+    uint32_t crc = crc32_calc(tx_buf, dgram_len);
+    memcpy(&tx_buf[dgram_len], &crc, sizeof(crc));
+
+    send_buf(sock, tx_buf, dgram_len + sizeof(crc), dest);
+    dgram_begin();
+}
+
+/* Fill every channel due for at least one destination, once per tick */
+static void sample_tick(size_t ndests, uint32_t tick)
+{
+    const size_t rec_hdr = sizeof(telem_record_header_t);
+    size_t used = 0;
+
+    for (size_t i = 0; i < NUM_CHANNELS; i++) {
+        const struct telem_channel *ch = channels[i];
+        bool wanted = false;
+
+        sampled[i].len = 0;
+        for (size_t d = 0; d < ndests && !wanted; d++) {
+            wanted = due(dests[d].divider[ch->id], tick);
+        }
+        if (!wanted || used + rec_hdr + ch->max_len > sizeof(sample_buf)) {
+            continue;
+        }
+
+        size_t len = ch->fill(&sample_buf[used + rec_hdr], ch->max_len, tick);
+        if (len == 0) {
+            continue;
+        }
+
+        telem_record_header_t rec = {
+            .channel = ch->id,
+            .len     = (uint16_t)len,
+        };
+        memcpy(&sample_buf[used], &rec, rec_hdr);
+        sampled[i].off = (uint16_t)used;
+        sampled[i].len = (uint16_t)(rec_hdr + len);
+        used += rec_hdr + len;
+    }
+}
+
+/* Send the records of either the control channels or all the others */
+static void send_class(const struct telem_subscriber *dest, bool control,
+                       uint32_t tick, uint32_t tick_ms)
+{
+    const size_t limit = sizeof(tx_buf) - sizeof(uint32_t);
+    const int sock = control ? telem_ctrl_sock : telem_sock;
+
+    dgram_begin();
+
+    for (size_t i = 0; i < NUM_CHANNELS; i++) {
+        if (channels[i]->control != control || sampled[i].len == 0 ||
+            !due(dest->divider[channels[i]->id], tick)) {
+            continue;
+        }
+        if (dgram_len + sampled[i].len > limit) {
+            dgram_flush(sock, tick, tick_ms, &dest->addr);
+        }
+        memcpy(&tx_buf[dgram_len], &sample_buf[sampled[i].off], sampled[i].len);
+        dgram_len += sampled[i].len;
+        dgram_count++;
+    }
+
+    dgram_flush(sock, tick, tick_ms, &dest->addr);
+}
+
+static void send_tick(const struct telem_subscriber *dest, uint32_t tick, uint32_t tick_ms)
+{
+    send_class(dest, true, tick, tick_ms);
+    send_class(dest, false, tick, tick_ms);
+}
+
+static void mux_init(void)
+{
+    size_t worst = 0;
+
+    broadcast_dest.addr = telem_dest;
+    broadcast_dest.addr.sin_port = htons(TELEM_MUX_PORT);
+    for (size_t i = 0; i < NUM_CHANNELS; i++) {
+        broadcast_dest.divider[channels[i]->id] = channels[i]->divider;
+        worst += sizeof(telem_record_header_t) + channels[i]->max_len;
+    }
+    if (worst > sizeof(sample_buf)) {
+        LOG_WRN("Telemetry sample buffer %u B < worst case %u B; late channels may skip",
+                (unsigned)sizeof(sample_buf), (unsigned)worst);
+    }
+}
+
+static void run_tick(uint32_t tick, uint32_t tick_ms)
+{
+    size_t ndests = telem_subscribers_get(dests, ARRAY_SIZE(dests));
+
+    if (ndests == 0) {
+        dests[0] = broadcast_dest;
+        ndests = 1;
+    }
+
+    sample_tick(ndests, tick);
+    for (size_t d = 0; d < ndests; d++) {
+        send_tick(&dests[d], tick, tick_ms);
+    }
+}
+
+#endif /* CONFIG_K2_TELEM_LEGACY_PORTS */
+
+/* (Re)open one telemetry socket at `priority` — retry on failure */
+static void telem_sock_open(int *sock, uint8_t priority)
+{
+    if (*sock >= 0) {
+        zsock_close(*sock);
+        *sock = -1;
+    }
+
+    while (*sock < 0) {
+        *sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (*sock < 0) {
+            LOG_ERR("telemetry socket: %d  (retry in 1 s)", errno);
+            k_sleep(K_MSEC(1000));
+        }
+    }
+
+    int on = 1;
+    zsock_setsockopt(*sock, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+    int err = net_socket_set_priority(*sock, priority);
+    if (err < 0) {
+        LOG_WRN("telemetry socket priority %u: %d", priority, err);
+    }
+}
+
+static void telem_open(void)
+{
+    telem_sock_open(&telem_sock, NET_PRIO_TELEMETRY);
+    telem_sock_open(&telem_ctrl_sock, NET_PRIO_CONTROL);
+}
+
+static void telem_thread(void *a, void *b, void *c)
+{
+    ARG_UNUSED(a); ARG_UNUSED(b); ARG_UNUSED(c);
+
+    while (!network_ready) {
+        k_sleep(K_MSEC(100));
+    }
+
+    uint32_t armed_gen = net_link_generation();
+    telem_open();
+
+    telem_dest.sin_family = AF_INET;
+    zsock_inet_pton(AF_INET, TOPSIDE_IP, &telem_dest.sin_addr);
+#ifndef CONFIG_K2_TELEM_LEGACY_PORTS
+    mux_init();
+#endif
+
+    for (size_t i = 0; i < NUM_CHANNELS; i++) {
+        const struct telem_channel *ch = channels[i];
+        if (ch->divider == 0) {
+            LOG_INF("Telemetry channel %s: disabled", ch->name);
+        } else {
+            LOG_INF("Telemetry channel %s: %u ms", ch->name,
+                    ch->divider * TELEM_BASE_TICK_MS);
+        }
+    }
+    LOG_INF("Telemetry started (%s)",
+            IS_ENABLED(CONFIG_K2_TELEM_LEGACY_PORTS) ? "legacy ports" : "mux port");
+
+    uint32_t tick = 0;
+    int64_t next = k_uptime_get();
+
+    while (1) {
+        if (!time_sync_to_topside_us(next * 1000, &tick_topside_us)) {
+            tick_topside_us = 0;
+        }
+        /* Nothing to send into while the link is down; the tick keeps
+         * counting so channel phases line up again afterwards */
+        if (network_ready) {
+            uint32_t gen = net_link_generation();
+            if (gen != armed_gen) {
+                LOG_INF("Link back up, re-opening telemetry sockets");
+                armed_gen = gen;
+                telem_open();
+            }
+            run_tick(tick, (uint32_t)next);
+        }
+        tick++;
+
+        /* Absolute deadline: the tick does not drift with send time */
+        next += TELEM_BASE_TICK_MS;
+        int64_t now = k_uptime_get();
+        if (next <= now) {
+            /* Fell behind (e.g. blocked in sendto) — skip, don't burst */
+            next = now + TELEM_BASE_TICK_MS;
+        }
+        k_sleep(K_TIMEOUT_ABS_MS(next));
+    }
+}
+
+void telemetry_start(void)
+{
+    k_tid_t tid = k_thread_create(&telem_thread_data,
+                                   telem_stack,
+                                   K_THREAD_STACK_SIZEOF(telem_stack),
+                                   telem_thread,
+                                   NULL, NULL, NULL,
+                                   TELEM_PRIORITY, 0, K_NO_WAIT);
+    if (tid) {
+        k_thread_name_set(tid, "telemetry");
+    }
+}
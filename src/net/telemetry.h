@@ -0,0 +1,97 @@
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Telemetry multiplexer — one thread samples every outbound telemetry
+ * channel on a common base tick and packs the records due on that tick
+ * into as few datagrams as fit the MTU.
+ *
+ * Datagram on TELEM_MUX_PORT (native byte order):
+ *   | version (1B) | count (1B) | length (2B)      total datagram size
+ *   | sequence (4B)                               base tick number
+ *   | tick_ms (4B)                                uptime of the tick
+ *   | tick_topside_us (8B)                        tick in topside time, 0 if unsynced
+ *   | count x record: channel (1B) | pad (1B) | len (2B) | payload
+ *   | crc32 (4B)                                  over all preceding bytes
+ *
+ * Every record in a datagram was sampled on the same tick, so channels
+ * line up on tick_ms, and tick_topside_us places them on the topside
+ * clock once time sync (time_sync.h) has converged.  Record payloads are the channel's own packet
+ * (e.g. imu_telem_packet_t), unchanged from the legacy per-port format.
+ * A tick whose records overflow one datagram is split; the parts share
+ * the sequence number.  Control channels (.control) never share a
+ * datagram with the others: they go first, from their own socket in the
+ * control TX class, so sensor and resource records cannot queue ahead
+ * of them.
+ *
+ * Datagrams are broadcast to TOPSIDE_IP unless a console has subscribed
+ * (telem_subscribe.h); then each subscriber gets its own datagrams,
+ * unicast, with only its channels at its intervals.
+ */
+
+#define TELEM_MUX_VERSION   2
+#define TELEM_BASE_TICK_MS  20        /* matches the 50 Hz control loop */
+#define TELEM_MAX_DATAGRAM  1472      /* 1500 B Ethernet MTU − IPv4/UDP headers */
+
+/* Channel ids on the wire */
+enum telem_channel_id {
+    TELEM_CH_IMU      = 1,
+    TELEM_CH_CONTROL  = 2,
+    TELEM_CH_RESOURCE = 3,
+    TELEM_CH_CONTROL_STREAM = 4,
+    TELEM_CH_NET_COUNTERS   = 5,
+    TELEM_CH_THREADS        = 6,
+};
+
+#define TELEM_CH_ID_LIMIT   16        /* channel ids are below this */
+
+typedef struct {
+    uint8_t  version;
+    uint8_t  count;
+    uint16_t length;
+    uint32_t sequence;
+    uint32_t tick_ms;
+    int64_t  tick_topside_us;
+} __attribute__((packed)) telem_mux_header_t;
+
+typedef struct {
+    uint8_t  channel;
+    uint8_t  _pad;
+    uint16_t len;
+} __attribute__((packed)) telem_record_header_t;
+
+/*
+ * Write one record payload into buf (at most max bytes) and return its
+ * length, or 0 to skip this tick.  `sequence` is the shared tick number
+ * and should be used for any sequence field in the payload.  Called from
+ * the telemetry thread only.
+ */
+typedef size_t (*telem_fill_t)(uint8_t *buf, size_t max, uint32_t sequence);
+
+struct telem_channel {
+    const char   *name;
+    uint8_t       id;
+    uint16_t      divider;        /* sample every N base ticks, 0 = off */
+    uint16_t      min_divider;    /* fastest a subscriber is granted, 0 = any */
+    uint16_t      legacy_port;    /* own port with CONFIG_K2_TELEM_LEGACY_PORTS */
+    uint16_t      max_len;        /* largest payload fill() produces */
+    bool          control;        /* sent on the NET_PRIO_CONTROL socket */
+    telem_fill_t  fill;
+};
+
+/* Channel descriptors, defined next to their fill functions */
+extern const struct telem_channel imu_telem_channel;       /* net.c */
+extern const struct telem_channel control_telem_channel;   /* control_telemetry.c */
+extern const struct telem_channel resource_telem_channel;  /* resource_monitor.c */
+extern const struct telem_channel control_stream_channel;  /* control_stream.c */
+extern const struct telem_channel net_counters_channel;    /* net_counters.c */
+extern const struct telem_channel thread_telem_channel;    /* thread_telemetry.c */
+
+/* Channel with wire id `id`, or NULL if there is none */
+const struct telem_channel *telemetry_channel_find(uint8_t id);
+
+/* Start the telemetry thread (sends once the network is up) */
+void telemetry_start(void);
@@ -0,0 +1,176 @@
+/*
+ * Per-thread telemetry — CPU cycles and stack peak for every thread
+ *
+ * resource_monitor.c reports one CPU % from the idle thread and the sum
+ * of all stack watermarks, which cannot say whether it is sensor_udp or
+ * rov_control that is eating the time or close to overflowing.  This
+ * channel reports each thread on its own.
+ *
+ * The walk uses k_thread_foreach_unlocked(): the scheduler lock is held
+ * only to step from one thread to the next, not across the callback, so
+ * the stack checks below never block the control loop or interrupts.
+ * Runtime baselines are kept per thread rather than per sample, so a
+ * thread's cycle count stays correct however the table is paged.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <string.h>
+
+#include "thread_telemetry.h"
+#include "net.h"
+#include "telemetry.h"
+#include "stack_watermark.h"
+
+#define THREAD_TELEM_BASELINES 48    /* threads tracked for cycle deltas */
+
+/*
+ * Previous sample of one thread.  The firmware's threads are static, so
+ * slots are never freed; a thread object reused by a new thread shows
+ * up as runtime going backwards and restarts its baseline.
+ */
+struct baseline {
+    const struct k_thread *tid;      /* NULL = free slot */
+    uint64_t cycles;
+    int64_t  ticks;
+};
+
+static struct baseline baselines[THREAD_TELEM_BASELINES];
+static uint8_t next_page;
+
+struct walk {
+    thread_telem_entry_t *entry;     /* output for this page */
+    uint32_t tick;                   /* telemetry tick, for stack_watermark_get() */
+    size_t   first;                  /* index of the page's first thread */
+    size_t   index;                  /* threads seen so far */
+    uint8_t  count;                  /* entries written */
+};
+
+static struct baseline *baseline_get(const struct k_thread *t)
+{
+    struct baseline *free_slot = NULL;
+
+    for (size_t i = 0; i < ARRAY_SIZE(baselines); i++) {
+        if (baselines[i].tid == t) {
+            return &baselines[i];
+        }
+        if (!free_slot && !baselines[i].tid) {
+            free_slot = &baselines[i];
+        }
+    }
+    if (free_slot) {
+        free_slot->tid = t;
+        free_slot->ticks = 0;
+    }
+    return free_slot;
+}
+
+static void sample_runtime(const struct k_thread *t, thread_telem_entry_t *e)
+{
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+    k_thread_runtime_stats_t rt;
+    struct baseline *b = baseline_get(t);
+    int64_t now = k_uptime_ticks();
+
+    if (k_thread_runtime_stats_get((k_tid_t)t, &rt) != 0) {
+        e->flags |= THREAD_TELEM_FIRST;
+        return;
+    }
+    if (!b || b->ticks == 0 || rt.execution_cycles < b->cycles) {
+        e->flags |= THREAD_TELEM_FIRST;
+    } else {
+        e->cycles    = (uint32_t)MIN(rt.execution_cycles - b->cycles, UINT32_MAX);
+        e->window_us = (uint32_t)MIN(k_ticks_to_us_floor64(now - b->ticks), UINT32_MAX);
+    }
+    if (b) {
+        b->cycles = rt.execution_cycles;
+        b->ticks  = now ? now : 1;
+    }
+#else
+    ARG_UNUSED(t);
+    e->flags |= THREAD_TELEM_FIRST;
+#endif
+}
+
+static void sample_stack(const struct k_thread *t, uint32_t tick, thread_telem_entry_t *e)
+{
+#ifdef CONFIG_THREAD_STACK_INFO
+    size_t unused;
+
+    e->stack_size = t->stack_info.size;
+    if (stack_watermark_get(t, tick, &unused) == 0) {
+        e->stack_used = t->stack_info.size - unused;
+    }
+#else
+    ARG_UNUSED(t);
+    ARG_UNUSED(tick);
+    ARG_UNUSED(e);
+#endif
+}
+
+static void walk_cb(const struct k_thread *t, void *user_data)
+{
+    struct walk *w = user_data;
+    size_t index = w->index++;
+
+    if (index < w->first || w->count >= THREAD_TELEM_PER_PAGE) {
+        return;
+    }
+
+    thread_telem_entry_t *e = &w->entry[w->count++];
+    const char *name = k_thread_name_get((k_tid_t)t);
+
+    memset(e, 0, sizeof(*e));
+    if (name) {
+        strncpy(e->name, name, sizeof(e->name));
+    }
+    e->priority = (int8_t)k_thread_priority_get((k_tid_t)t);
+    sample_runtime(t, e);
+    sample_stack(t, w->tick, e);
+}
+
+static size_t thread_telem_fill(uint8_t *buf, size_t max, uint32_t sequence)
+{
+    const size_t page_len = sizeof(thread_telem_header_t) +
+                            THREAD_TELEM_PER_PAGE * sizeof(thread_telem_entry_t);
+    if (page_len > max) {
+        return 0;
+    }
+
+    thread_telem_header_t hdr = {
+        .cycles_hz = sys_clock_hw_cycles_per_sec(),
+        .page      = next_page,
+    };
+    struct walk w = {
+        .entry = (thread_telem_entry_t *)(buf + sizeof(hdr)),
+        .tick  = sequence,
+        .first = (size_t)next_page * THREAD_TELEM_PER_PAGE,
+    };
+
+    k_thread_foreach_unlocked(walk_cb, &w);
+
+    hdr.threads = (uint8_t)MIN(w.index, UINT8_MAX);
+    hdr.pages   = (uint8_t)DIV_ROUND_UP(hdr.threads, THREAD_TELEM_PER_PAGE);
+    hdr.count   = w.count;
+    next_page   = (next_page + 1 < hdr.pages) ? next_page + 1 : 0;
+
+    if (w.count == 0) {
+        /* Fewer threads than last time; the next sample starts over */
+        return 0;
+    }
+
+    memcpy(buf, &hdr, sizeof(hdr));
+    return sizeof(hdr) + w.count * sizeof(thread_telem_entry_t);
+}
+
+/* 1 Hz, and no faster for subscribers: each sample walks every thread */
+const struct telem_channel thread_telem_channel = {
+    .name        = "threads",
+    .id          = TELEM_CH_THREADS,
+    .divider     = 50,
+    .min_divider = 50,
+    .legacy_port = THREAD_TELEM_PORT,
+    .max_len     = sizeof(thread_telem_header_t) +
+                   THREAD_TELEM_PER_PAGE * sizeof(thread_telem_entry_t),
+    .fill        = thread_telem_fill,
+};
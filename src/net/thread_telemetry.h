@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Per-thread CPU load and stack telemetry (thread_telem_channel, 1 Hz).
+ *
+ * One record per sample, native byte order: a header and up to
+ * THREAD_TELEM_PER_PAGE entries.  With more threads than fit, the table
+ * is sent in pages on successive samples; `page` of `pages` says which
+ * slice this is.  Every entry carries its own measurement window, so an
+ * entry is usable on its own whichever samples a subscriber receives:
+ *
+ *   load = cycles / (cycles_hz × window_us / 1e6)
+ *
+ * An entry flagged THREAD_TELEM_FIRST has no previous sample to measure
+ * against (first time seen, or baseline table full) and reports 0 cycles.
+ */
+
+#define THREAD_TELEM_NAME_LEN  16      /* NUL-padded, unterminated if full */
+#define THREAD_TELEM_PER_PAGE  32      /* keeps a record under the MTU */
+
+#define THREAD_TELEM_FIRST     0x01
+
+typedef struct {
+    char     name[THREAD_TELEM_NAME_LEN];
+    int8_t   priority;
+    uint8_t  flags;
+    uint16_t _pad;
+    uint32_t cycles;        /* executed since this thread's previous entry */
+    uint32_t window_us;     /* wall time over the same interval */
+    uint32_t stack_size;
+    uint32_t stack_used;    /* peak, from the stack fill pattern */
+} __attribute__((packed)) thread_telem_entry_t;
+
+typedef struct {
+    uint32_t cycles_hz;     /* unit of `cycles` */
+    uint8_t  threads;       /* all threads, over every page */
+    uint8_t  page;
+    uint8_t  pages;
+    uint8_t  count;         /* entries in this record */
+} __attribute__((packed)) thread_telem_header_t;
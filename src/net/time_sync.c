@@ -0,0 +1,130 @@
+/*
+ * Time Sync — NTP-style offset and skew estimation against topside.
+ *
+ * Every k_uptime_get() timestamp the ROV sends is relative to its own
+ * boot, which cannot be lined up with topside video or joystick logs.
+ * Topside polls this service (port 5011, via the UDP dispatcher) and
+ * the resulting clock model converts MCU time to topside time for the
+ * telemetry multiplexer and anyone else who asks.
+ *
+ * On the direct Ethernet link the round trip is a few hundred
+ * microseconds, so the lowest-delay sample of the last TS_WINDOW is
+ * accurate to well under a millisecond; the PI loop then tracks the
+ * crystal frequency error so the offset holds between polls.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <string.h>
+
+#include "time_sync.h"
+#include "time_sync_model.h"
+#include "net.h"
+#include "udp_dispatch.h"
+#include "../control.h"
+
+LOG_MODULE_REGISTER(time_sync, LOG_LEVEL_INF);
+
+#define TS_MAX_DELAY_US   50000        /* reject samples with a longer round trip */
+#define TS_HOLDOVER_US    (600LL * 1000000)   /* model valid this long without updates */
+
+static struct k_spinlock ts_lock;
+static struct time_sync_model ts;
+
+static void add_sample(const time_sync_packet_t *p)
+{
+    k_spinlock_key_t key = k_spin_lock(&ts_lock);
+    enum time_sync_model_event ev = time_sync_model_add(&ts, p->t1, p->t2, p->t3, p->t4);
+    int64_t offset_us = (int64_t)ts.ref_offset_us;
+    int64_t delay_us = ts.delay_us;
+    k_spin_unlock(&ts_lock, key);
+
+    if (ev == TIME_SYNC_MODEL_SEEDED) {
+        LOG_INF("Time sync: offset %lld us, delay %lld us",
+                (long long)offset_us, (long long)delay_us);
+    } else if (ev == TIME_SYNC_MODEL_STEPPED) {
+        LOG_WRN("Time sync: step, re-seeded at offset %lld us", (long long)offset_us);
+    }
+}
+
+bool time_sync_to_topside_us(int64_t mcu_us, int64_t *topside_us)
+{
+    k_spinlock_key_t key = k_spin_lock(&ts_lock);
+
+    bool ok = ts.synced && (mcu_us - ts.updated_us) < TS_HOLDOVER_US;
+    if (ok) {
+        *topside_us = time_sync_model_to_topside(&ts, mcu_us);
+    }
+
+    k_spin_unlock(&ts_lock, key);
+    return ok;
+}
+
+void time_sync_get_status(struct time_sync_status *out)
+{
+    k_spinlock_key_t key = k_spin_lock(&ts_lock);
+
+    out->synced     = ts.synced;
+    out->offset_us  = (int64_t)ts.ref_offset_us;
+    out->skew_ppb   = (int32_t)(ts.skew * 1e9);
+    out->delay_us   = (uint32_t)ts.delay_us;
+    out->samples    = ts.samples;
+    out->updated_us = ts.updated_us;
+
+    k_spin_unlock(&ts_lock, key);
+}
+
+static int time_sync_handle(int sock, const uint8_t *data, size_t len,
+                            const struct sockaddr_in *from)
+{
+    int64_t rx_us = control_uptime_us();
+    ARG_UNUSED(len);
+
+    const time_sync_packet_t *req = (const time_sync_packet_t *)data;
+
+    switch (req->type) {
+    case TIME_SYNC_REQUEST: {
+        time_sync_packet_t resp = {
+            .type     = TIME_SYNC_RESPONSE,
+            .sequence = req->sequence,
+            .t1       = req->t1,
+            .t2       = rx_us,
+        };
+        int64_t unused;
+        if (time_sync_to_topside_us(rx_us, &unused)) {
+            resp.flags |= TIME_SYNC_FLAG_SYNCED;
+        }
+
+        /* Stamp t3 as late as possible; only the CRC is left */
+        resp.t3 = control_uptime_us();
+        resp.crc32 = crc32_calc(&resp, sizeof(resp) - sizeof(resp.crc32));
+
+        net_port_sendto(NET_PORT_TIME_SYNC, sock, &resp, sizeof(resp), 0, from);
+        return 0;
+    }
+
+    case TIME_SYNC_REPORT:
+        if (req->t3 < req->t2 || req->t4 < req->t1 || req->t3 > rx_us ||
+            (req->t4 - req->t1) - (req->t3 - req->t2) > TS_MAX_DELAY_US) {
+            return -EINVAL;
+        }
+        add_sample(req);
+        return 0;
+
+    default:
+        LOG_WRN("Time sync: unknown packet type 0x%02X", req->type);
+        return -ENOMSG;
+    }
+}
+
+const struct udp_service time_sync_service = {
+    .name     = "Time sync",
+    .port     = TIME_SYNC_PORT,
+    .min_len  = sizeof(time_sync_packet_t),
+    .max_len  = sizeof(time_sync_packet_t),
+    .crc      = UDP_CRC_NATIVE,
+    .handler  = time_sync_handle,
+    .counters = NET_PORT_TIME_SYNC,
+    .priority = NET_PRIO_CONTROL,
+};
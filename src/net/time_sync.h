@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Topside ↔ MCU time synchronisation on TIME_SYNC_PORT.
+ *
+ * Topside drives a three-message exchange (see tools/time_sync_client.py):
+ *
+ *   REQUEST  topside → MCU   t1 = topside send time
+ *   RESPONSE MCU → topside   t1 echoed, t2 = MCU receive, t3 = MCU send
+ *   REPORT   topside → MCU   t1..t3 echoed, t4 = topside receive
+ *
+ * Both ends then know all four timestamps and compute the NTP offset
+ * ((t1 − t2) + (t4 − t3)) / 2 and round-trip delay (t4 − t1) − (t3 − t2).
+ * The MCU keeps the lowest-delay sample of a short window and feeds it
+ * to a PI clock model (offset + frequency skew), so conversions stay
+ * accurate between exchanges and hold over if topside goes quiet.
+ *
+ * Topside timestamps are in microseconds on whatever clock the client
+ * uses (the reference client uses the Unix wall clock); MCU timestamps
+ * are control_uptime_us().
+ */
+
+#define TIME_SYNC_REQUEST   0x01
+#define TIME_SYNC_RESPONSE  0x02
+#define TIME_SYNC_REPORT    0x03
+
+#define TIME_SYNC_FLAG_SYNCED 0x01   /* RESPONSE: MCU clock model is valid */
+
+/* All fields native byte order (little-endian) */
+typedef struct {
+    uint8_t  type;
+    uint8_t  flags;
+    uint16_t _pad;
+    uint32_t sequence;
+    int64_t  t1;        /* topside send (topside us) */
+    int64_t  t2;        /* MCU receive (MCU uptime us) */
+    int64_t  t3;        /* MCU send (MCU uptime us) */
+    int64_t  t4;        /* topside receive (topside us), REPORT only */
+    uint32_t crc32;
+} __attribute__((packed)) time_sync_packet_t;
+
+struct time_sync_status {
+    bool     synced;
+    int64_t  offset_us;     /* topside − MCU at the last update */
+    int32_t  skew_ppb;      /* topside clock rate relative to the MCU */
+    uint32_t delay_us;      /* round trip of the sample last used */
+    uint32_t samples;       /* REPORTs accepted since boot */
+    int64_t  updated_us;    /* MCU time of the last model update */
+};
+
+/*
+ * Convert an MCU uptime (us) to topside time (us).  Returns false and
+ * leaves *topside_us untouched until the first exchange has completed
+ * or after the model has gone stale.
+ */
+bool time_sync_to_topside_us(int64_t mcu_us, int64_t *topside_us);
+
+void time_sync_get_status(struct time_sync_status *out);
@@ -0,0 +1,78 @@
+#include "time_sync_model.h"
+
+#include <stddef.h>
+
+#define TS_STEP_US  10000        /* error above this re-seeds the model */
+#define TS_KP       0.3
+#define TS_KI       0.05
+
+static enum time_sync_model_event model_update(struct time_sync_model *m,
+                                               const struct ts_sample *s)
+{
+    enum time_sync_model_event ev = TIME_SYNC_MODEL_UPDATED;
+
+    if (m->synced) {
+        double dt = (double)(s->mcu_us - m->ref_mcu_us);
+        double predicted = m->ref_offset_us + m->skew * dt;
+        double err = (double)s->offset_us - predicted;
+
+        if (err <= TS_STEP_US && err >= -TS_STEP_US) {
+            m->ref_mcu_us = s->mcu_us;
+            m->ref_offset_us = predicted + TS_KP * err;
+            if (dt > 0.0) {
+                m->skew += TS_KI * err / dt;
+            }
+            m->delay_us = s->delay_us;
+            m->updated_us = s->mcu_us;
+            return ev;
+        }
+        ev = TIME_SYNC_MODEL_STEPPED;
+    } else {
+        ev = TIME_SYNC_MODEL_SEEDED;
+    }
+
+    m->ref_mcu_us = s->mcu_us;
+    m->ref_offset_us = (double)s->offset_us;
+    m->skew = 0.0;
+    m->synced = true;
+    m->delay_us = s->delay_us;
+    m->updated_us = s->mcu_us;
+    return ev;
+}
+
+enum time_sync_model_event time_sync_model_add(struct time_sync_model *m,
+                                               int64_t t1, int64_t t2,
+                                               int64_t t3, int64_t t4)
+{
+    struct ts_sample s = {
+        .mcu_us    = t2 + (t3 - t2) / 2,
+        .offset_us = ((t1 - t2) + (t4 - t3)) / 2,
+        .delay_us  = (t4 - t1) - (t3 - t2),
+    };
+
+    m->window[m->count % TS_WINDOW] = s;
+    m->count++;
+    m->samples++;
+
+    /* Clock filter: the lowest-delay sample has the least asymmetry */
+    const struct ts_sample *best = NULL;
+    uint32_t n = (m->count < TS_WINDOW) ? m->count : TS_WINDOW;
+    for (uint32_t i = 0; i < n; i++) {
+        if (!best || m->window[i].delay_us < best->delay_us) {
+            best = &m->window[i];
+        }
+    }
+
+    /* Feed each sample to the model at most once */
+    if (best->mcu_us <= m->last_used_us) {
+        return TIME_SYNC_MODEL_KEPT;
+    }
+    m->last_used_us = best->mcu_us;
+    return model_update(m, best);
+}
+
+int64_t time_sync_model_to_topside(const struct time_sync_model *m, int64_t mcu_us)
+{
+    double dt = (double)(mcu_us - m->ref_mcu_us);
+    return mcu_us + (int64_t)(m->ref_offset_us + m->skew * dt);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Clock model behind time_sync.c: a lowest-delay filter over the last
+ * TS_WINDOW exchanges feeding a PI model of offset and frequency skew.
+ *
+ * No Zephyr dependencies and no locking; time_sync.c holds its spinlock
+ * around every call, and tools/time_sync_sim.c runs this very code on
+ * the host against a simulated link.
+ */
+
+#define TS_WINDOW   8
+
+struct ts_sample {
+    int64_t mcu_us;       /* midpoint of t2/t3 */
+    int64_t offset_us;
+    int64_t delay_us;
+};
+
+struct time_sync_model {
+    struct ts_sample window[TS_WINDOW];
+    uint32_t count;
+    int64_t last_used_us;      /* mcu_us of the sample last fed to the model */
+
+    bool synced;
+    int64_t ref_mcu_us;        /* model: offset(t) = ref_offset + skew * (t − ref_mcu) */
+    double ref_offset_us;
+    double skew;               /* dimensionless (us per us) */
+    int64_t delay_us;
+    int64_t updated_us;
+    uint32_t samples;
+};
+
+/* What time_sync_model_add() did with the exchange */
+enum time_sync_model_event {
+    TIME_SYNC_MODEL_KEPT = 0,  /* filter kept an earlier sample, model unchanged */
+    TIME_SYNC_MODEL_UPDATED,   /* PI step towards the new sample */
+    TIME_SYNC_MODEL_SEEDED,    /* first sample, model started from it */
+    TIME_SYNC_MODEL_STEPPED,   /* error above TS_STEP_US, re-seeded */
+};
+
+/*
+ * Add one completed exchange (t1..t4 as in time_sync_packet_t) and feed
+ * the lowest-delay sample of the window to the model, at most once per
+ * sample.  A zero-initialised model is valid and unsynced.
+ */
+enum time_sync_model_event time_sync_model_add(struct time_sync_model *m,
+                                               int64_t t1, int64_t t2,
+                                               int64_t t3, int64_t t4);
+
+/* MCU uptime to topside time; only meaningful once m->synced */
+int64_t time_sync_model_to_topside(const struct time_sync_model *m, int64_t mcu_us);
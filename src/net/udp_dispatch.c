@@ -0,0 +1,327 @@
+/*
+ * UDP service dispatcher
+ *
+ * Replaces the per-port listener threads (command, PID config, axis
+ * config, setpoint override, system control).  Each of those used to own
+ * a 2 KB stack and sit in a blocking recvfrom(); now a single thread
+ * waits in zsock_poll() on all of their sockets and calls the matching
+ * handler from the static service table below.
+ *
+ * Handlers run in this thread, so they must not block for long — every
+ * existing handler only copies a few bytes, takes a short mutex, and
+ * maybe sends a reply.
+ *
+ * Flood handling: each wake-up drains up to DISPATCH_BATCH datagrams per
+ * socket instead of one, and rejects by length and source address before
+ * spending a CRC on them.  Drops are only counted in the hot path; one
+ * summary line per service and DIAG_INTERVAL_MS says what was dropped,
+ * so a flood of junk no longer turns into a flood of LOG_WRN formatting.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <string.h>
+
+#include "udp_dispatch.h"
+#include "net.h"
+
+LOG_MODULE_REGISTER(udp_dispatch, LOG_LEVEL_INF);
+
+#define DISPATCH_STACK_SIZE 2048
+#define DISPATCH_BUF_SIZE   128     /* larger than any service packet */
+#define DISPATCH_BATCH      16      /* datagrams per socket per wake-up */
+#define DIAG_INTERVAL_MS    1000
+#define LINK_CHECK_MS       100     /* poll timeout, bounds socket re-arm delay */
+
+static const struct udp_service *const services[] = {
+#ifndef CONFIG_K2_CMD_NET_CONTEXT
+    &command_service,
+#endif
+    &pid_config_service,
+    &axis_config_service,
+    &setpoint_override_service,
+    &system_control_service,
+    &time_sync_service,
+    &heartbeat_service,
+#ifndef CONFIG_K2_TELEM_LEGACY_PORTS
+    &telem_subscribe_service,
+#endif
+};
+
+#define NUM_SERVICES ARRAY_SIZE(services)
+
+/* Drops since the last summary line, per service */
+struct drop_stats {
+    uint32_t size;
+    uint32_t source;
+    uint32_t crc;
+    uint32_t rx_err;
+    uint16_t last_len;
+    int      last_errno;
+    struct in_addr last_from;
+};
+
+static struct zsock_pollfd fds[NUM_SERVICES];
+static struct drop_stats drops[NUM_SERVICES];
+static bool drops_pending;
+static uint8_t rx_buf[DISPATCH_BUF_SIZE] __aligned(4);
+
+K_THREAD_STACK_DEFINE(udp_dispatch_stack, DISPATCH_STACK_SIZE);
+static struct k_thread udp_dispatch_thread_data;
+
+static int open_service(const struct udp_service *svc)
+{
+    if (svc->max_len > DISPATCH_BUF_SIZE || svc->min_len > svc->max_len) {
+        LOG_ERR("%s: bad length limits %u..%u", svc->name,
+                svc->min_len, svc->max_len);
+        return -EINVAL;
+    }
+
+    int sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0) {
+        LOG_ERR("Failed to create %s socket: %d", svc->name, errno);
+        return -errno;
+    }
+
+    struct sockaddr_in bind_addr = {
+        .sin_family = AF_INET,
+        .sin_addr.s_addr = INADDR_ANY,
+        .sin_port = htons(svc->port),
+    };
+
+    if (zsock_bind(sock, (struct sockaddr *)&bind_addr, sizeof(bind_addr)) < 0) {
+        LOG_ERR("Failed to bind %s socket to port %d: %d",
+                svc->name, svc->port, errno);
+        zsock_close(sock);
+        return -errno;
+    }
+
+    int err = net_socket_set_priority(sock, svc->priority);
+    if (err < 0) {
+        LOG_WRN("%s: cannot set priority %u: %d", svc->name, svc->priority, err);
+    }
+
+    return sock;
+}
+
+static bool crc_ok(const struct udp_service *svc, const uint8_t *data, size_t len)
+{
+    uint32_t recv_crc;
+
+    if (svc->crc == UDP_CRC_NONE) {
+        return true;
+    }
+    if (len < sizeof(recv_crc)) {
+        return false;
+    }
+
+    memcpy(&recv_crc, &data[len - sizeof(recv_crc)], sizeof(recv_crc));
+    if (svc->crc == UDP_CRC_NET) {
+        recv_crc = ntohl(recv_crc);
+    }
+
+    return crc32_calc(data, len - sizeof(recv_crc)) == recv_crc;
+}
+
+/* Receive and handle one datagram; returns false once the socket is empty */
+static bool service_recv_one(const struct udp_service *svc, int sock,
+                             struct drop_stats *d)
+{
+    struct sockaddr_in from;
+    socklen_t from_len = sizeof(from);
+
+    int ret = zsock_recvfrom(sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT,
+                             (struct sockaddr *)&from, &from_len);
+    if (ret < 0) {
+        if (errno == EAGAIN) {
+            return false;
+        }
+        net_counter_inc(svc->counters, NET_CNT_RX_ERR);
+        d->rx_err++;
+        d->last_errno = errno;
+        drops_pending = true;
+        return false;
+    }
+
+    /* Cheapest checks first: a flood of junk never reaches the CRC */
+    size_t len = (size_t)ret;
+    if (len < svc->min_len || len > svc->max_len) {
+        net_counter_inc(svc->counters, NET_CNT_SIZE);
+        d->size++;
+        d->last_len = (uint16_t)len;
+        d->last_from = from.sin_addr;
+        drops_pending = true;
+        return true;
+    }
+
+    if (!net_source_allowed(&from.sin_addr)) {
+        net_counter_inc(svc->counters, NET_CNT_SOURCE);
+        d->source++;
+        d->last_from = from.sin_addr;
+        drops_pending = true;
+        return true;
+    }
+
+    if (!crc_ok(svc, rx_buf, len)) {
+        net_counter_inc(svc->counters, NET_CNT_CRC);
+        d->crc++;
+        d->last_from = from.sin_addr;
+        drops_pending = true;
+        return true;
+    }
+
+    int err = svc->handler(sock, rx_buf, len, &from);
+    if (err == -ENOMSG) {
+        net_counter_inc(svc->counters, NET_CNT_TYPE);
+    } else if (err < 0) {
+        net_counter_inc(svc->counters, NET_CNT_REJECTED);
+    } else {
+        net_counter_rx(svc->counters);
+    }
+    return true;
+}
+
+/*
+ * Drain a readable socket.  The batch limit keeps one flooded port from
+ * starving the others; whatever is left makes the next poll return at
+ * once.
+ */
+static void service_recv(const struct udp_service *svc, int sock,
+                         struct drop_stats *d)
+{
+    for (int n = 0; n < DISPATCH_BATCH; n++) {
+        if (!service_recv_one(svc, sock, d)) {
+            break;
+        }
+    }
+}
+
+static void report_drops(void)
+{
+    for (size_t i = 0; i < NUM_SERVICES; i++) {
+        struct drop_stats *d = &drops[i];
+        const uint8_t *ip = (const uint8_t *)&d->last_from.s_addr;
+
+        if (d->size || d->source || d->crc) {
+            LOG_WRN("%s: dropped %u wrong size (last %u B, expected %u..%u), "
+                    "%u off-subnet, %u bad CRC; last from %u.%u.%u.%u",
+                    services[i]->name, d->size, d->last_len,
+                    services[i]->min_len, services[i]->max_len,
+                    d->source, d->crc, ip[0], ip[1], ip[2], ip[3]);
+        }
+        if (d->rx_err) {
+            LOG_ERR("%s: %u recv errors (last %d)", services[i]->name,
+                    d->rx_err, d->last_errno);
+        }
+        memset(d, 0, sizeof(*d));
+    }
+    drops_pending = false;
+}
+
+/*
+ * (Re)open every service socket.  Called at start and whenever the link
+ * generation moves, i.e. after the link has been down, so no socket
+ * outlives a cable glitch and a service that failed to open gets
+ * another try.
+ */
+static void arm_services(void)
+{
+#ifdef CONFIG_K2_CMD_NET_CONTEXT
+    command_fastpath_stop();
+    command_fastpath_start();
+#endif
+
+    for (size_t i = 0; i < NUM_SERVICES; i++) {
+        if (fds[i].fd >= 0) {
+            zsock_close(fds[i].fd);
+        }
+        /* A negative fd is ignored by poll, so a failed service just
+         * stays silent instead of taking the others down with it. */
+        fds[i].fd = open_service(services[i]);
+        fds[i].events = ZSOCK_POLLIN;
+        if (fds[i].fd >= 0) {
+            LOG_INF("%s listening on port %d", services[i]->name, services[i]->port);
+        }
+    }
+}
+
+static void udp_dispatch_thread(void *a, void *b, void *c)
+{
+    ARG_UNUSED(a);
+    ARG_UNUSED(b);
+    ARG_UNUSED(c);
+
+    while (!network_ready) {
+        k_sleep(K_MSEC(LINK_CHECK_MS));
+    }
+
+    for (size_t i = 0; i < NUM_SERVICES; i++) {
+        fds[i].fd = -1;
+    }
+    uint32_t armed_gen = net_link_generation();
+    arm_services();
+
+    int64_t next_report = 0;
+    int poll_errno = 0;
+
+    while (1) {
+        uint32_t gen = net_link_generation();
+        if (gen != armed_gen && network_ready) {
+            LOG_INF("Link back up, re-arming service sockets");
+            armed_gen = gen;
+            arm_services();
+        }
+
+        /* Wake up for the next summary while there is one to print, and
+         * often enough to notice a link change */
+        int timeout = LINK_CHECK_MS;
+        if (drops_pending) {
+            timeout = (int)CLAMP(next_report - k_uptime_get(), 0, LINK_CHECK_MS);
+        }
+
+        int ret = zsock_poll(fds, NUM_SERVICES, timeout);
+        if (ret < 0) {
+            /* Interrupted: just poll again.  Anything else is logged once
+             * and backed off by a millisecond so a persistent failure
+             * cannot spin this cooperative thread. */
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            if (errno != poll_errno) {
+                LOG_ERR("UDP dispatch poll error: %d", errno);
+                poll_errno = errno;
+            }
+            k_sleep(K_MSEC(1));
+            continue;
+        }
+        poll_errno = 0;
+
+        for (size_t i = 0; i < NUM_SERVICES; i++) {
+            if (fds[i].revents & ZSOCK_POLLIN) {
+                service_recv(services[i], fds[i].fd, &drops[i]);
+            }
+            fds[i].revents = 0;
+        }
+
+        if (drops_pending && k_uptime_get() >= next_report) {
+            report_drops();
+            next_report = k_uptime_get() + DIAG_INTERVAL_MS;
+        }
+    }
+}
+
+void udp_dispatch_start(void)
+{
+    k_tid_t tid = k_thread_create(&udp_dispatch_thread_data,
+                                  udp_dispatch_stack,
+                                  K_THREAD_STACK_SIZEOF(udp_dispatch_stack),
+                                  udp_dispatch_thread,
+                                  NULL, NULL, NULL,
+                                  K_PRIO_COOP(7), 0, K_NO_WAIT);
+    if (tid) {
+        k_thread_name_set(tid, "udp_dispatch");
+    } else {
+        LOG_ERR("Failed to start UDP dispatch thread");
+    }
+}
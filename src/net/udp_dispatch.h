@@ -0,0 +1,56 @@
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "net_counters.h"
+
+/*
+ * UDP service dispatcher — one thread polls every inbound service socket
+ * and routes each datagram to the owning module's handler.
+ *
+ * Length and CRC are checked here, before the handler runs, so handlers
+ * only ever see well-formed packets.  Every outcome is counted against
+ * the service's entry in net_counters.h.
+ */
+
+/* Where the trailing CRC32 sits and how it is encoded */
+enum udp_crc_policy {
+    UDP_CRC_NONE = 0,   /* no CRC field */
+    UDP_CRC_NATIVE,     /* last 4 bytes, CPU byte order (little-endian) */
+    UDP_CRC_NET,        /* last 4 bytes, network byte order */
+};
+
+/*
+ * Handle one validated datagram.  `sock` is the service's own socket so
+ * replies go out from the service port.  Return 0 if the packet was
+ * accepted, -ENOMSG for an unknown packet type, or another negative
+ * errno if it was rejected.
+ */
+typedef int (*udp_handler_t)(int sock, const uint8_t *data, size_t len,
+                             const struct sockaddr_in *from);
+
+struct udp_service {
+    const char          *name;
+    uint16_t             port;
+    uint16_t             min_len;
+    uint16_t             max_len;
+    enum udp_crc_policy  crc;
+    udp_handler_t        handler;
+    enum net_port_id     counters;
+    uint8_t              priority;   /* SO_PRIORITY for replies, NET_PRIO_* */
+};
+
+/* Service descriptors, defined next to their handlers */
+extern const struct udp_service command_service;        /* net.c */
+extern const struct udp_service pid_config_service;     /* pid_config.c */
+extern const struct udp_service axis_config_service;    /* axis_config.c */
+extern const struct udp_service setpoint_override_service;
+extern const struct udp_service system_control_service;
+extern const struct udp_service time_sync_service;      /* time_sync.c */
+extern const struct udp_service telem_subscribe_service; /* telem_subscribe.c */
+extern const struct udp_service heartbeat_service;      /* heartbeat.c */
+
+/* Start the dispatcher thread (binds all services once the network is up) */
+void udp_dispatch_start(void);
@@ -20,8 +20,16 @@ enum pid_axis {
     PID_AXIS_COUNT  /* always last — equals 6 */
 };
 
-/* Start the PID config UDP listener thread */
-void pid_config_start(void);
-
 /* Get a snapshot of the gains for one axis (thread-safe) */
 pid_gains_t pid_config_get_gains(enum pid_axis axis);
+
+/*
+ * Copy all six axes' gains into `out` if they were changed since
+ * generation `*gen`, and update `*gen`.  Returns false without touching
+ * `out` otherwise, which costs one atomic load — cheap enough to call
+ * every control cycle.  Start with *gen = PID_CONFIG_GEN_NONE to get the
+ * first copy.  Lock-free; safe against a concurrent SET.
+ */
+#define PID_CONFIG_GEN_NONE 1U   /* odd: never a published generation */
+
+bool pid_config_sync(uint32_t *gen, pid_gains_t out[PID_AXIS_COUNT]);
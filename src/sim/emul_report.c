@@ -0,0 +1,89 @@
+/*
+ * native_sim emulator report.
+ *
+ * Logs driver throughput as seen from the far side of the emulated buses
+ * (VN-100S SPI transfers, VESC duty frames) once per report period, and
+ * optionally walks through every fault the emulators can inject so the
+ * driver error paths run in CI.  The numbers are what the CI job greps
+ * for; the IMU validation counters show which faults were caught.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "../imu/vn100s.h"
+#include "../imu/imu_validate.h"
+#include "../vesc/vesc_uart_zephyr.h"
+
+LOG_MODULE_REGISTER(emul_report, LOG_LEVEL_INF);
+
+#define REPORT_STACK_SIZE   1024
+#define REPORT_PRIORITY     10
+#define FAULT_BURST         3      /* responses altered per fault step */
+#define VESC_STALL_MS       200
+
+static const enum vn100s_emul_fault fault_cycle[] = {
+    VN_EMUL_FAULT_BUS,
+    VN_EMUL_FAULT_ERROR_BYTE,
+    VN_EMUL_FAULT_NAN,
+    VN_EMUL_FAULT_YAW_JUMP,
+    VN_EMUL_FAULT_SILENT,
+};
+
+static void emul_report_task(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    struct vn100s_emul_stats vn_prev = {0};
+    struct vesc_emul_stats vesc_prev = {0};
+    size_t step = 0;
+    const uint32_t period_s = CONFIG_K2_EMUL_REPORT_S;
+
+    while (1) {
+        k_sleep(K_SECONDS(period_s));
+
+        struct vn100s_emul_stats vn;
+        struct vesc_emul_stats vesc;
+        uint32_t rejects[IMU_REJ_COUNT];
+
+        vn100s_emul_get_stats(&vn);
+        vesc_emul_get_stats(&vesc);
+        imu_validate_get_stats(rejects);
+
+        LOG_INF("vn100s: %u req/s %u resp/s, faults %u",
+                (vn.requests - vn_prev.requests) / period_s,
+                (vn.responses - vn_prev.responses) / period_s,
+                vn.faults);
+        LOG_INF("vesc: %u frames/s %u B/s, crc %u framing %u unknown %u",
+                (vesc.frames - vesc_prev.frames) / period_s,
+                (vesc.bytes - vesc_prev.bytes) / period_s,
+                vesc.crc_errors, vesc.framing_errors, vesc.unknown_cmds);
+        LOG_INF("imu rejects: nonfinite %u range %u rate %u step %u att %u accel %u",
+                rejects[IMU_REJ_NONFINITE], rejects[IMU_REJ_RANGE],
+                rejects[IMU_REJ_RATE_LIMIT], rejects[IMU_REJ_RATE_STEP],
+                rejects[IMU_REJ_ATTITUDE_JUMP], rejects[IMU_REJ_ACCEL_LIMIT]);
+
+        vn_prev = vn;
+        vesc_prev = vesc;
+
+        if (IS_ENABLED(CONFIG_K2_EMUL_FAULT_CYCLE)) {
+            enum vn100s_emul_fault f = fault_cycle[step % ARRAY_SIZE(fault_cycle)];
+
+            LOG_INF("injecting VN-100S fault %d x%d", f, FAULT_BURST);
+            vn100s_emul_inject(f, FAULT_BURST);
+
+            /* Once per cycle, back the VESC TX ring up for a while */
+            if (step % ARRAY_SIZE(fault_cycle) == 0) {
+                vesc_emul_set_stall(true);
+                k_msleep(VESC_STALL_MS);
+                vesc_emul_set_stall(false);
+            }
+            step++;
+        }
+    }
+}
+
+K_THREAD_DEFINE(emul_report_tid, REPORT_STACK_SIZE, emul_report_task, NULL, NULL, NULL,
+                REPORT_PRIORITY, 0, 0);
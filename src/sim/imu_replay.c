@@ -0,0 +1,122 @@
+/*
+ * native_sim IMU replay.
+ *
+ * Parses the recording embedded from CONFIG_K2_EMUL_IMU_REPLAY_FILE
+ * (CSV rows as tools/imu_telem_decode.py --csv prints them) once at
+ * boot and hands the samples to the VN-100S emulator, so the IMU task,
+ * the validation gates and the control loop run on real vehicle motion
+ * instead of the synthetic sweep.  Playback uses the mean sample_ms step
+ * between adjacent rows that both parsed, and loops; the jump back to
+ * the first row is a real discontinuity and the validation gates treat
+ * it as one.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../imu/vn100s.h"
+
+LOG_MODULE_REGISTER(imu_replay, LOG_LEVEL_INF);
+
+#define REPLAY_DEFAULT_PERIOD_MS  200   /* imu_telem_channel, for rows without sample_ms */
+#define REPLAY_FIELDS             12    /* sequence, sample_ms, fresh, then the nine values */
+
+static const char replay_csv[] = {
+#include "imu_replay.csv.inc"
+    '\0'
+};
+
+static imu_sample_t replay[CONFIG_K2_EMUL_IMU_REPLAY_MAX];
+
+/* One row [line, eol) into *s; false for the header or a malformed row */
+static bool parse_row(const char *line, const char *eol, imu_sample_t *s,
+                      int64_t *sample_ms)
+{
+    float v[9];
+    const char *p = line;
+
+    for (int field = 0; field < REPLAY_FIELDS; field++) {
+        const char *comma = memchr(p, ',', eol - p);
+        const char *end_field = comma ? comma : eol;
+        char *end;
+
+        if ((field < REPLAY_FIELDS - 1) != (comma != NULL)) {
+            return false;               /* too few or too many fields */
+        }
+        if (field == 1) {
+            /* Empty in rows decoded from legacy JSON telemetry */
+            *sample_ms = strtoll(p, &end, 10);
+            if (end == p || end != end_field) {
+                *sample_ms = -1;
+            }
+        } else if (field >= 3) {
+            v[field - 3] = strtof(p, &end);
+            if (end == p || end > end_field) {
+                return false;
+            }
+        }
+        p = end_field + 1;
+    }
+
+    s->yaw = v[0];
+    s->pitch = v[1];
+    s->roll = v[2];
+    s->yr = v[3];
+    s->pr = v[4];
+    s->rr = v[5];
+    s->ax = v[6];
+    s->ay = v[7];
+    s->az = v[8];
+    return true;
+}
+
+static int imu_replay_init(void)
+{
+    const char *p = replay_csv;
+    const char *text_end = replay_csv + strlen(replay_csv);
+    int64_t prev_ms = -1, span_ms = 0;
+    size_t n = 0, steps = 0, skipped = 0;
+
+    while (p < text_end) {
+        const char *eol = memchr(p, '\n', text_end - p);
+        eol = eol ? eol : text_end;
+
+        const char *row_end = (eol > p && eol[-1] == '\r') ? eol - 1 : eol;
+        int64_t sample_ms;
+
+        if (row_end > p) {
+            if (n < ARRAY_SIZE(replay) && parse_row(p, row_end, &replay[n], &sample_ms)) {
+                if (prev_ms >= 0 && sample_ms > prev_ms) {
+                    span_ms += sample_ms - prev_ms;
+                    steps++;
+                }
+                prev_ms = sample_ms;
+                n++;
+            } else {
+                prev_ms = -1;           /* no step across a skipped row */
+                skipped++;
+            }
+        }
+        p = eol + 1;
+    }
+
+    if (n < 2) {
+        LOG_ERR("IMU replay: %zu usable rows in the recording, using synthetic motion", n);
+        return 0;
+    }
+
+    uint32_t period_ms = REPLAY_DEFAULT_PERIOD_MS;
+    if (steps > 0) {
+        period_ms = (uint32_t)MAX((span_ms + (int64_t)steps / 2) / (int64_t)steps, 1);
+    }
+
+    vn100s_emul_load(replay, n, period_ms);
+    LOG_INF("IMU replay: %zu samples at %u ms (%u s loop), %zu lines skipped",
+            n, period_ms, (uint32_t)(n * period_ms / 1000), skipped);
+    return 0;
+}
+
+SYS_INIT(imu_replay_init, APPLICATION, 0);
@@ -0,0 +1,46 @@
+/*
+ * native_sim Ethernet link flap.
+ *
+ * Drops the carrier of the default interface for K2_SIM_LINK_FLAP_DOWN_MS
+ * every K2_SIM_LINK_FLAP_PERIOD_S seconds, the same way an Ethernet
+ * driver reports a cable glitch.  That drives the whole recovery path:
+ * carrier and IF_UP/DOWN events, network_ready, socket re-arm in the
+ * services, and the "first command N ms after carrier up" line net.c
+ * logs once a command gets through, which is the recovery time.  Keep a
+ * command source running (e.g. tools/cmd_flood.py --rate 50).
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/ethernet.h>
+
+LOG_MODULE_REGISTER(link_flap, LOG_LEVEL_INF);
+
+#define FLAP_STACK_SIZE     1024
+#define FLAP_PRIORITY       14
+
+static void link_flap_task(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    struct net_if *iface = net_if_get_default();
+    if (!iface) {
+        LOG_ERR("link flap: no network interface");
+        return;
+    }
+
+    while (1) {
+        k_sleep(K_SECONDS(CONFIG_K2_SIM_LINK_FLAP_PERIOD_S));
+
+        LOG_INF("link flap: carrier off for %u ms", CONFIG_K2_SIM_LINK_FLAP_DOWN_MS);
+        net_eth_carrier_off(iface);
+        k_msleep(CONFIG_K2_SIM_LINK_FLAP_DOWN_MS);
+        net_eth_carrier_on(iface);
+    }
+}
+
+K_THREAD_DEFINE(link_flap_tid, FLAP_STACK_SIZE, link_flap_task, NULL, NULL, NULL,
+                FLAP_PRIORITY, 0, 0);
@@ -0,0 +1,51 @@
+/*
+ * native_sim UDP log flood.
+ *
+ * Alternates K2_SIM_LOG_FLOOD_PERIOD_S seconds of quiet with as many
+ * seconds of log bursts at K2_SIM_LOG_FLOOD_RATE messages per second, so
+ * tools/tc_latency.py can compare control telemetry latency with and
+ * without a saturated log socket in a single run.  Messages are spread
+ * over 1 ms slices from a low-priority thread; whatever the deferred log
+ * buffer cannot take is dropped and counted like any other log overflow.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(log_flood, LOG_LEVEL_INF);
+
+#define FLOOD_STACK_SIZE    1024
+#define FLOOD_PRIORITY      14
+#define FLOOD_SLICE_MS      1
+
+static void log_flood_task(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    const uint32_t period_ms = CONFIG_K2_SIM_LOG_FLOOD_PERIOD_S * 1000U;
+    const uint32_t per_slice = MAX(CONFIG_K2_SIM_LOG_FLOOD_RATE * FLOOD_SLICE_MS / 1000, 1);
+    uint32_t seq = 0;
+
+    while (1) {
+        LOG_INF("log flood: quiet for %u s", CONFIG_K2_SIM_LOG_FLOOD_PERIOD_S);
+        k_msleep(period_ms);
+
+        LOG_INF("log flood: %u msg/s for %u s", CONFIG_K2_SIM_LOG_FLOOD_RATE,
+                CONFIG_K2_SIM_LOG_FLOOD_PERIOD_S);
+        int64_t end = k_uptime_get() + period_ms;
+
+        while (k_uptime_get() < end) {
+            for (uint32_t i = 0; i < per_slice; i++) {
+                LOG_INF("flood %08u: the quick brown fox jumps over the lazy dog %08x",
+                        seq, seq * 2654435761U);
+                seq++;
+            }
+            k_msleep(FLOOD_SLICE_MS);
+        }
+    }
+}
+
+K_THREAD_DEFINE(log_flood_tid, FLOOD_STACK_SIZE, log_flood_task, NULL, NULL, NULL,
+                FLOOD_PRIORITY, 0, 0);
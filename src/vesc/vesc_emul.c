@@ -0,0 +1,243 @@
+/*
+ * VESC UART emulator for native_sim.
+ *
+ * Sits on the far end of the zephyr,uart-emul device behind the
+ * vesc-uart alias and plays the role of the local VESC: every byte the
+ * interrupt-driven TX path in vesc_uart_zephyr.c pushes out is drained,
+ * reassembled into VESC frames (0x02 len payload crc_hi crc_lo 0x03) and
+ * checked with an independent CRC16, so a bug in the packet builder shows
+ * up as a CRC or framing error rather than being mirrored back.
+ *
+ * COMM_SET_DUTY and COMM_CAN_FORWARD(COMM_SET_DUTY) are decoded; the
+ * latest duty per id and a ring log of recent frames can be read back.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/init.h>
+#include <zephyr/drivers/serial/uart_emul.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+#include "vesc_uart_zephyr.h"
+
+LOG_MODULE_REGISTER(vesc_emul, LOG_LEVEL_INF);
+
+#define VESC_UART_NODE DT_ALIAS(vesc_uart)
+
+BUILD_ASSERT(DT_NODE_HAS_COMPAT(VESC_UART_NODE, zephyr_uart_emul),
+             "vesc-uart must be a zephyr,uart-emul node when K2_EMUL is set");
+
+static const struct device *vesc_uart = DEVICE_DT_GET(VESC_UART_NODE);
+
+#define START_BYTE       0x02
+#define STOP_BYTE        0x03
+#define MAX_PAYLOAD      64
+
+#define CMD_SET_DUTY     5
+#define CMD_CAN_FORWARD  34
+
+#define FRAME_LOG_LEN    64
+#define NUM_IDS          256
+
+enum rx_state {
+    RX_START,
+    RX_LEN,
+    RX_PAYLOAD,
+    RX_CRC_HI,
+    RX_CRC_LO,
+    RX_STOP,
+};
+
+static struct k_spinlock emul_lock;
+
+static struct {
+    enum rx_state state;
+    uint8_t len;
+    uint8_t pos;
+    uint8_t payload[MAX_PAYLOAD];
+    uint16_t crc_rx;
+
+    int32_t duty[NUM_IDS];
+    struct vesc_emul_frame log[FRAME_LOG_LEN];
+    size_t log_head;
+    size_t log_count;
+
+    bool stall;
+    struct vesc_emul_stats stats;
+} emul_state;
+
+/* Table-free CRC16-CCITT (XModem); deliberately not shared with vesc_protocol.c */
+static uint16_t emul_crc16(const uint8_t *data, size_t len)
+{
+    uint16_t crc = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        uint16_t x = ((crc >> 8) ^ data[i]) & 0xFF;
+        x ^= x >> 4;
+        crc = (crc << 8) ^ (x << 12) ^ (x << 5) ^ x;
+    }
+    return crc;
+}
+
+static int32_t get_be32(const uint8_t *p)
+{
+    return (int32_t)(((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+                     ((uint32_t)p[2] << 8) | p[3]);
+}
+
+static void record_duty(uint8_t id, int32_t duty_raw)
+{
+    emul_state.duty[id] = duty_raw;
+
+    struct vesc_emul_frame *f = &emul_state.log[emul_state.log_head];
+    f->timestamp_ms = k_uptime_get();
+    f->id = id;
+    f->duty_raw = duty_raw;
+
+    emul_state.log_head = (emul_state.log_head + 1) % FRAME_LOG_LEN;
+    if (emul_state.log_count < FRAME_LOG_LEN) {
+        emul_state.log_count++;
+    }
+    emul_state.stats.frames++;
+}
+
+static void handle_payload(const uint8_t *p, uint8_t len)
+{
+    if (len == 5 && p[0] == CMD_SET_DUTY) {
+        record_duty(VESC_EMUL_LOCAL_ID, get_be32(&p[1]));
+    } else if (len == 7 && p[0] == CMD_CAN_FORWARD && p[2] == CMD_SET_DUTY) {
+        record_duty(p[1], get_be32(&p[3]));
+    } else {
+        emul_state.stats.unknown_cmds++;
+    }
+}
+
+static void parse_byte(uint8_t b)
+{
+    switch (emul_state.state) {
+    case RX_START:
+        if (b == START_BYTE) {
+            emul_state.state = RX_LEN;
+        } else {
+            emul_state.stats.framing_errors++;
+        }
+        break;
+    case RX_LEN:
+        if (b == 0 || b > MAX_PAYLOAD) {
+            emul_state.stats.framing_errors++;
+            emul_state.state = RX_START;
+        } else {
+            emul_state.len = b;
+            emul_state.pos = 0;
+            emul_state.state = RX_PAYLOAD;
+        }
+        break;
+    case RX_PAYLOAD:
+        emul_state.payload[emul_state.pos++] = b;
+        if (emul_state.pos == emul_state.len) {
+            emul_state.state = RX_CRC_HI;
+        }
+        break;
+    case RX_CRC_HI:
+        emul_state.crc_rx = (uint16_t)b << 8;
+        emul_state.state = RX_CRC_LO;
+        break;
+    case RX_CRC_LO:
+        emul_state.crc_rx |= b;
+        emul_state.state = RX_STOP;
+        break;
+    case RX_STOP:
+        emul_state.state = RX_START;
+        if (b != STOP_BYTE) {
+            emul_state.stats.framing_errors++;
+        } else if (emul_crc16(emul_state.payload, emul_state.len) != emul_state.crc_rx) {
+            emul_state.stats.crc_errors++;
+        } else {
+            handle_payload(emul_state.payload, emul_state.len);
+        }
+        break;
+    }
+}
+
+static void drain_uart(void)
+{
+    uint8_t chunk[32];
+    uint32_t n;
+
+    do {
+        n = uart_emul_get_tx_data(vesc_uart, chunk, sizeof(chunk));
+
+        k_spinlock_key_t key = k_spin_lock(&emul_lock);
+        emul_state.stats.bytes += n;
+        for (uint32_t i = 0; i < n; i++) {
+            parse_byte(chunk[i]);
+        }
+        k_spin_unlock(&emul_lock, key);
+    } while (n == sizeof(chunk));
+}
+
+/* Called by uart-emul whenever the driver fills the TX FIFO */
+static void tx_data_ready(const struct device *dev, size_t size, void *user_data)
+{
+    ARG_UNUSED(dev);
+    ARG_UNUSED(size);
+    ARG_UNUSED(user_data);
+
+    if (!emul_state.stall) {
+        drain_uart();
+    }
+}
+
+int32_t vesc_emul_get_duty(uint8_t id)
+{
+    k_spinlock_key_t key = k_spin_lock(&emul_lock);
+    int32_t duty = emul_state.duty[id];
+    k_spin_unlock(&emul_lock, key);
+    return duty;
+}
+
+size_t vesc_emul_read_frames(struct vesc_emul_frame *out, size_t max)
+{
+    k_spinlock_key_t key = k_spin_lock(&emul_lock);
+
+    size_t n = MIN(max, emul_state.log_count);
+    size_t start = (emul_state.log_head + FRAME_LOG_LEN - emul_state.log_count) % FRAME_LOG_LEN;
+
+    for (size_t i = 0; i < n; i++) {
+        out[i] = emul_state.log[(start + i) % FRAME_LOG_LEN];
+    }
+    emul_state.log_count = 0;
+
+    k_spin_unlock(&emul_lock, key);
+    return n;
+}
+
+void vesc_emul_set_stall(bool stall)
+{
+    emul_state.stall = stall;
+    if (!stall) {
+        drain_uart();
+    }
+}
+
+void vesc_emul_get_stats(struct vesc_emul_stats *out)
+{
+    k_spinlock_key_t key = k_spin_lock(&emul_lock);
+    *out = emul_state.stats;
+    k_spin_unlock(&emul_lock, key);
+}
+
+static int vesc_emul_init(void)
+{
+    if (!device_is_ready(vesc_uart)) {
+        LOG_ERR("VESC emulator UART not ready");
+        return -ENODEV;
+    }
+
+    uart_emul_callback_tx_data_ready_set(vesc_uart, tx_data_ready, NULL);
+    return 0;
+}
+
+SYS_INIT(vesc_emul_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
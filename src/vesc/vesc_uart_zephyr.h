@@ -22,4 +22,41 @@ void vesc_set_duty_local(float duty);
  * @param can_id CAN ID of the VESC (0-253)
  * @param duty Duty cycle (-1.0 to +1.0)
  */
-void vesc_set_duty_can(uint8_t can_id, float duty);
\ No newline at end of file
+void vesc_set_duty_can(uint8_t can_id, float duty);
+
+#ifdef CONFIG_K2_EMUL
+#include <stdbool.h>
+
+/* native_sim VESC emulator (vesc_emul.c) */
+
+#define VESC_EMUL_LOCAL_ID 0xFF   /* id recorded for the UART-local VESC */
+
+/* One decoded duty frame */
+struct vesc_emul_frame {
+    int64_t  timestamp_ms;
+    uint8_t  id;                  /* CAN id, or VESC_EMUL_LOCAL_ID */
+    int32_t  duty_raw;            /* -100000 .. +100000 */
+};
+
+struct vesc_emul_stats {
+    uint32_t bytes;               /* bytes drained from the UART */
+    uint32_t frames;              /* well-formed duty frames */
+    uint32_t crc_errors;
+    uint32_t framing_errors;      /* bad start/stop byte or length */
+    uint32_t unknown_cmds;
+};
+
+/* Latest duty seen for a CAN id (VESC_EMUL_LOCAL_ID for UART-local) */
+int32_t vesc_emul_get_duty(uint8_t id);
+
+/*
+ * Copy up to max recorded frames, oldest first, and clear the log.
+ * The log keeps the most recent frames; returns the number copied.
+ */
+size_t vesc_emul_read_frames(struct vesc_emul_frame *out, size_t max);
+
+/* Stop draining the UART (models a stuck line) — TX backs up into the driver */
+void vesc_emul_set_stall(bool stall);
+
+void vesc_emul_get_stats(struct vesc_emul_stats *out);
+#endif
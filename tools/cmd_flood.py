@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""
+Command-path flood benchmark.
+
+Sends valid 16-byte command frames (neutral sticks, lights off) to port
+12345 as fast as possible, or at --rate packets/s, for --seconds.  Then
+reads the ROV's resource telemetry to report how many commands the
+firmware accepted and the CPU load it reported during the flood.
+
+Run once per firmware build, e.g. on native_sim over the TAP interface:
+
+    west build -b native_sim -- -DCONFIG_K2_CMD_NET_CONTEXT=n   # socket path
+    west build -b native_sim -- -DCONFIG_K2_CMD_NET_CONTEXT=y   # net_context path
+    python3 tools/cmd_flood.py --target 10.77.0.2 --seconds 10
+
+Compare "accepted" and "cpu" between the two builds.  tools/cmd_path_bench.sh
+does both builds, the TAP setup and the runs in one go.  Resource records
+are read from the multiplexed telemetry port (5009) or, with --legacy,
+from port 12346.
+
+--junk N sends N invalid frames (bad CRC, then wrong size) after every
+valid one, to check that garbage does not crowd out real commands.
+--sweep raises the rate step by step until the firmware stops accepting
+at least 99 % of the valid frames and reports the highest rate that
+held, i.e. the maximum sustained valid-command rate:
+
+    python3 tools/cmd_flood.py --sweep --junk 4 --seconds 5
+"""
+
+import argparse
+import binascii
+import socket
+import struct
+import sys
+import time
+
+from telem_mux_decode import CH_RESOURCE, RESOURCE, RESOURCE_LEN, decode_datagram
+
+NEUTRAL_PAYLOAD = 0x8000808080808080   # manipulator 0, light 0, axes centred
+
+
+def command_frame(sequence, v2=False):
+    if v2:
+        # v2: v1 fields, version 2, 3 pad bytes, topside send time (us)
+        body = struct.pack('>IQB3xQ', sequence, NEUTRAL_PAYLOAD, 2,
+                           time.time_ns() // 1000)
+    else:
+        body = struct.pack('>IQ', sequence, NEUTRAL_PAYLOAD)
+    return body + struct.pack('>I', binascii.crc32(body))
+
+
+def junk_frames(frame):
+    """Invalid variants of a valid frame: flipped CRC, then truncated."""
+    return (frame[:-1] + bytes([frame[-1] ^ 0xFF]), frame[:-3])
+
+
+class ResourceReader:
+    """Latest (uptime_ms, cpu %, udp_rx, udp_rx_errors) from resource telemetry."""
+
+    def __init__(self, legacy):
+        self.legacy = legacy
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        self.sock.bind(('', 12346 if legacy else 5009))
+        self.sock.setblocking(False)
+        self.latest = None
+
+    def _parse(self, payload):
+        if len(payload) != RESOURCE_LEN:
+            return
+        (_, uptime, cpu, _, _, _, _, _, rx, rx_err) = RESOURCE.unpack_from(payload)
+        self.latest = (uptime, cpu, rx, rx_err)
+
+    def poll(self):
+        while True:
+            try:
+                data = self.sock.recv(2048)
+            except BlockingIOError:
+                return self.latest
+            if self.legacy:
+                self._parse(data)
+                continue
+            try:
+                _, _, _, records = decode_datagram(data)
+            except ValueError:
+                continue
+            for channel, payload in records:
+                if channel == CH_RESOURCE:
+                    self._parse(payload)
+
+    def wait_next(self, timeout):
+        """Block until a resource record newer than the current one arrives."""
+        before = self.poll()
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            now = self.poll()
+            if now is not None and now != before:
+                return now
+            time.sleep(0.05)
+        return self.latest
+
+
+def flood(res, tx, args, rate):
+    """Send valid frames at `rate` (0 = flat out) for args.seconds.
+    Returns (sent, elapsed, accepted, cpu samples) or None without telemetry."""
+    start = res.wait_next(3.0)
+    if start is None:
+        return None
+
+    interval = 1.0 / rate if rate > 0 else 0.0
+    cpu_samples = []
+    sent = 0
+    t0 = time.monotonic()
+    next_tx = t0
+    end = t0 + args.seconds
+
+    while True:
+        now = time.monotonic()
+        if now >= end:
+            break
+        if interval:
+            if now < next_tx:
+                time.sleep(min(next_tx - now, 0.001))
+                continue
+            next_tx += interval
+        frame = command_frame(sent, args.v2)
+        tx.sendto(frame, (args.target, args.port))
+        for n in range(args.junk):
+            tx.sendto(junk_frames(frame)[n % 2], (args.target, args.port))
+        sent += 1
+        if sent % 256 == 0:
+            r = res.poll()
+            if r is not None and (not cpu_samples or r[0] != cpu_samples[-1][0]):
+                cpu_samples.append((r[0], r[1]))
+    elapsed = time.monotonic() - t0
+
+    # Let the next 1 Hz record report the final counters
+    end_state = res.wait_next(2.5)
+
+    accepted = end_state[2] - start[2]
+    errors = end_state[3] - start[3]
+    cpus = [c for _, c in cpu_samples[1:]] or [end_state[1]]
+    return sent, elapsed, accepted, errors, cpus
+
+
+def report(sent, elapsed, accepted, errors, cpus):
+    print(f'sent       {sent} in {elapsed:.2f} s ({sent / elapsed:.0f} pkt/s)')
+    print(f'accepted   {accepted} ({100.0 * accepted / max(sent, 1):.1f} %), '
+          f'rx errors {errors}')
+    print(f'cpu        mean {sum(cpus) / len(cpus):.0f} %, max {max(cpus)} % '
+          f'over {len(cpus)} samples')
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument('--target', default='10.77.0.2')
+    ap.add_argument('--port', type=int, default=12345)
+    ap.add_argument('--seconds', type=float, default=10.0)
+    ap.add_argument('--rate', type=float, default=0.0,
+                    help='packets/s (0 = as fast as possible)')
+    ap.add_argument('--v2', action='store_true',
+                    help='send 28-byte v2 frames with a send timestamp')
+    ap.add_argument('--junk', type=int, default=0,
+                    help='invalid frames sent after each valid one')
+    ap.add_argument('--sweep', action='store_true',
+                    help='step the rate up from --rate (default 500/s) until '
+                         'frames are lost')
+    ap.add_argument('--legacy', action='store_true',
+                    help='resource telemetry on port 12346 instead of 5009')
+    args = ap.parse_args()
+
+    res = ResourceReader(args.legacy)
+    tx = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+
+    if not args.sweep:
+        result = flood(res, tx, args, args.rate)
+        if result is None:
+            print('no resource telemetry received; is the ROV up?', file=sys.stderr)
+            return 1
+        report(*result)
+        return 0
+
+    rate = args.rate or 500.0
+    best = None
+    while True:
+        print(f'--- {rate:.0f} pkt/s')
+        result = flood(res, tx, args, rate)
+        if result is None:
+            print('no resource telemetry received; is the ROV up?', file=sys.stderr)
+            return 1
+        report(*result)
+        sent, elapsed, accepted = result[:3]
+        achieved = sent / elapsed
+        # Stop once frames are lost or the host itself cannot go faster
+        if accepted < 0.99 * sent or achieved < 0.9 * rate:
+            break
+        best = achieved
+        rate *= 1.5
+
+    if best is None:
+        print(f'no rate held; lowest tried was {rate:.0f} pkt/s')
+    else:
+        print(f'max sustained valid-command rate: {best:.0f} pkt/s '
+              f'(with {args.junk} junk frames each)')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,95 @@
+#!/usr/bin/env bash
+#
+# Command path flood benchmark on native_sim: socket path through the UDP
+# dispatcher (CONFIG_K2_CMD_NET_CONTEXT=n) against the net_context fast
+# path (=y).
+#
+# Builds both variants, brings up the host side of the TAP link
+# (HOST_IP on TAP_IF, as Zephyr's net-tools/net-setup.sh does), runs each
+# build in turn, floods it with tools/cmd_flood.py flat out and then with
+# --sweep, and prints the results side by side.  Needs west and root (or
+# sudo) for the TAP interface.
+#
+#   ./tools/cmd_path_bench.sh [seconds per run]
+
+set -euo pipefail
+
+script_dir="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+repo_dir="$(dirname "$script_dir")"
+workspace_dir="$(dirname "$repo_dir")"
+
+SECONDS_PER_RUN="${1:-10}"
+HOST_IP="${HOST_IP:-10.77.0.1}"
+MCU_IP="${MCU_IP:-10.77.0.2}"
+PREFIX="${PREFIX:-24}"
+TAP_IF="${TAP_IF:-zeth}"
+BOARD="native_sim/native/64"
+out_dir="${repo_dir}/build-cmd-bench"
+
+as_root() {
+    if [[ "${EUID}" -eq 0 ]]; then
+        "$@"
+    else
+        sudo "$@"
+    fi
+}
+
+if [[ -f "${workspace_dir}/.venv/bin/activate" ]]; then
+    # shellcheck source=/dev/null
+    source "${workspace_dir}/.venv/bin/activate"
+fi
+if ! command -v west >/dev/null 2>&1; then
+    echo "west not found. Install west or create a Zephyr virtual environment at ${workspace_dir}/.venv." >&2
+    exit 1
+fi
+
+tap_up() {
+    if ! ip link show "$TAP_IF" >/dev/null 2>&1; then
+        as_root ip tuntap add "$TAP_IF" mode tap user "$(id -un)"
+    fi
+    as_root ip addr replace "${HOST_IP}/${PREFIX}" dev "$TAP_IF"
+    as_root ip link set "$TAP_IF" up
+}
+
+run_variant() {
+    local name="$1" value="$2"
+    local build_dir="${out_dir}/${name}"
+    local log="${out_dir}/${name}.txt"
+
+    echo "=== ${name} (CONFIG_K2_CMD_NET_CONTEXT=${value})"
+    west build -p -b "$BOARD" -d "$build_dir" "$repo_dir" -- \
+        "-DCONFIG_K2_CMD_NET_CONTEXT=${value}" >"${build_dir}.build.log" 2>&1 || {
+        echo "build failed, see ${build_dir}.build.log" >&2
+        exit 1
+    }
+
+    "${build_dir}/zephyr/zephyr.exe" >"${build_dir}.run.log" 2>&1 &
+    local pid=$!
+    trap "kill ${pid} 2>/dev/null || true" EXIT
+    sleep 3
+
+    (
+        cd "$script_dir"
+        echo "--- flat out"
+        python3 cmd_flood.py --target "$MCU_IP" --seconds "$SECONDS_PER_RUN"
+        echo "--- sweep, 4 junk frames per valid one"
+        python3 cmd_flood.py --target "$MCU_IP" --seconds "$SECONDS_PER_RUN" --sweep --junk 4
+    ) | tee "$log"
+
+    kill "$pid" 2>/dev/null || true
+    wait "$pid" 2>/dev/null || true
+    trap - EXIT
+}
+
+mkdir -p "$out_dir"
+tap_up
+run_variant socket n
+run_variant net_context y
+
+echo
+echo "=== summary"
+for name in socket net_context; do
+    echo "${name}:"
+    grep -m 3 -E '^(sent|accepted|cpu) ' "${out_dir}/${name}.txt" | sed 's/^/    /'
+    grep -E '^(max sustained|no rate held)' "${out_dir}/${name}.txt" | sed 's/^/    /'
+done
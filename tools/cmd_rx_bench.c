@@ -0,0 +1,276 @@
+/*
+ * Host benchmark of the command receive path behind the UDP dispatcher:
+ * the early length and source checks, the CRC, command_decode() and the
+ * hand-off into the control loop's 10-entry queue.
+ *
+ * Build and run on the host:
+ *
+ *   cc -O2 -Isrc/net -o cmd_rx_bench tools/cmd_rx_bench.c src/net/crc32.c
+ *   ./cmd_rx_bench [frames] [junk]
+ *
+ * Part one times each frame kind on its own: valid v1 and v2 frames,
+ * and the three rejects (wrong size, off-subnet, bad CRC).  Part two
+ * feeds a flood of valid frames, each followed by `junk` invalid ones,
+ * against a control loop that drains the queue every 20 ms, at rates
+ * from 100 to 100000 valid frames/s of simulated time.  It checks that
+ * the command the loop acts on each cycle is the newest one received
+ * before it, whatever the rate.
+ *
+ * The checks and queue hand-off mirror src/net/udp_dispatch.c,
+ * src/net/net.c and rov_send_command() in src/control.c; the CRC is the
+ * real src/net/crc32.c.  Times are for the host CPU and leave out the
+ * socket receive, which on the MCU costs more than everything here, so
+ * the result is a ceiling on the dispatcher's own work, not the rate
+ * the ROV sustains; cmd_flood.py --sweep measures that on the target.
+ */
+
+#include <arpa/inet.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "crc32.h"
+
+#define CMD_V1_LEN     16        /* sizeof(udp_packet_t) */
+#define CMD_V2_LEN     28        /* sizeof(udp_packet_v2_t) */
+#define CMD_FRAME_V2   2
+#define QUEUE_DEPTH    10        /* rov_command_queue */
+#define CYCLE_US       20000     /* CONTROL_PERIOD_MS */
+
+struct frame {
+    uint8_t  data[CMD_V2_LEN];
+    size_t   len;
+    uint32_t src;                /* network order */
+};
+
+typedef struct {
+    uint32_t sequence;
+    int8_t   surge, sway, heave, roll, pitch, yaw;
+    uint8_t  light;
+    int8_t   manipulator;
+    uint64_t topside_us;
+} command_t;
+
+static uint32_t local_net, local_mask;
+static command_t queue[QUEUE_DEPTH];
+static unsigned q_head, q_count;
+static uint32_t overflows;
+static uint32_t rejected;
+
+/* ---- src/net/udp_dispatch.c, src/net/net.c, src/control.c ---- */
+
+static uint64_t net_to_host_64(uint64_t v)
+{
+    return __builtin_bswap64(v);
+}
+
+static void send_command(uint32_t sequence, uint64_t payload, uint64_t topside_us)
+{
+    command_t c = {
+        .sequence    = sequence,
+        .topside_us  = topside_us,
+        .surge       = (int8_t)((payload >> 0)  & 0xFF) - 128,
+        .sway        = (int8_t)((payload >> 8)  & 0xFF) - 128,
+        .heave       = (int8_t)((payload >> 16) & 0xFF) - 128,
+        .roll        = (int8_t)((payload >> 24) & 0xFF) - 128,
+        .pitch       = (int8_t)((payload >> 32) & 0xFF) - 128,
+        .yaw         = (int8_t)((payload >> 40) & 0xFF) - 128,
+        .light       = (uint8_t)((payload >> 48) & 0xFF),
+        .manipulator = (int8_t)((int16_t)((payload >> 56) & 0xFF) - 128),
+    };
+
+    /* Drop the oldest on overflow, as rov_send_command() does */
+    if (q_count == QUEUE_DEPTH) {
+        q_head = (q_head + 1) % QUEUE_DEPTH;
+        q_count--;
+        overflows++;
+    }
+    queue[(q_head + q_count) % QUEUE_DEPTH] = c;
+    q_count++;
+}
+
+static int command_decode(const uint8_t *data, size_t len)
+{
+    uint32_t seq;
+    uint64_t payload, topside_us = 0;
+
+    memcpy(&seq, data, 4);
+    memcpy(&payload, data + 4, 8);
+    if (len != CMD_V1_LEN) {
+        if (len != CMD_V2_LEN || data[12] != CMD_FRAME_V2) {
+            return -1;
+        }
+        memcpy(&topside_us, data + 16, 8);
+        topside_us = net_to_host_64(topside_us);
+    }
+    send_command(ntohl(seq), net_to_host_64(payload), topside_us);
+    return 0;
+}
+
+static void receive(const struct frame *f)
+{
+    if (f->len < CMD_V1_LEN || f->len > CMD_V2_LEN) {
+        rejected++;
+        return;
+    }
+    if ((f->src & local_mask) != local_net) {
+        rejected++;
+        return;
+    }
+    uint32_t crc;
+    memcpy(&crc, &f->data[f->len - 4], 4);
+    if (crc32_calc(f->data, f->len - 4) != ntohl(crc)) {
+        rejected++;
+        return;
+    }
+    if (command_decode(f->data, f->len) != 0) {
+        rejected++;
+    }
+}
+
+/* The control loop keeps the last command it dequeues */
+static bool loop_drain(command_t *last)
+{
+    bool any = q_count > 0;
+
+    while (q_count > 0) {
+        *last = queue[q_head];
+        q_head = (q_head + 1) % QUEUE_DEPTH;
+        q_count--;
+    }
+    return any;
+}
+
+/* ---- frames ---- */
+
+static void make_valid(struct frame *f, uint32_t seq, bool v2)
+{
+    uint32_t be_seq = htonl(seq);
+    uint64_t payload = net_to_host_64(0x8000808080808080ULL ^ seq);
+
+    memset(f, 0, sizeof(*f));
+    memcpy(f->data, &be_seq, 4);
+    memcpy(f->data + 4, &payload, 8);
+    f->len = CMD_V1_LEN;
+    if (v2) {
+        uint64_t ts = net_to_host_64(1700000000000000ULL + seq);
+        f->data[12] = CMD_FRAME_V2;
+        memcpy(f->data + 16, &ts, 8);
+        f->len = CMD_V2_LEN;
+    }
+    uint32_t crc = htonl(crc32_calc(f->data, f->len - 4));
+    memcpy(&f->data[f->len - 4], &crc, 4);
+    f->src = inet_addr("10.77.0.1");
+}
+
+static void make_junk(struct frame *f, uint32_t seq, int kind)
+{
+    make_valid(f, seq, false);
+    switch (kind % 3) {
+    case 0: f->data[f->len - 1] ^= 0xFF; break;        /* bad CRC */
+    case 1: f->len -= 3; break;                        /* wrong size */
+    case 2: f->src = inet_addr("192.168.1.50"); break;  /* off-subnet */
+    }
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double time_kind(const char *name, struct frame *frames, long n)
+{
+    command_t last;
+    double t0 = now_s();
+
+    for (long i = 0; i < n; i++) {
+        receive(&frames[i]);
+        if (q_count == QUEUE_DEPTH) {
+            loop_drain(&last);
+        }
+    }
+    double ns = (now_s() - t0) / n * 1e9;
+    loop_drain(&last);
+    printf("%-12s %6.1f ns/frame  %10.0f frames/s per core\n", name, ns, 1e9 / ns);
+    return ns;
+}
+
+int main(int argc, char **argv)
+{
+    long n = (argc > 1) ? atol(argv[1]) : 2000000;
+    int junk = (argc > 2) ? atoi(argv[2]) : 4;
+
+    if (junk < 0 || junk > 16) {
+        fprintf(stderr, "junk must be 0..16\n");
+        return 1;
+    }
+    struct frame *frames = malloc(sizeof(*frames) * (size_t)n);
+
+    local_mask = inet_addr("255.255.255.0");
+    local_net  = inet_addr("10.77.0.0");
+
+    printf("--- per frame kind, %ld frames each\n", n);
+    for (long i = 0; i < n; i++) make_valid(&frames[i], (uint32_t)i, false);
+    time_kind("valid v1", frames, n);
+    for (long i = 0; i < n; i++) make_valid(&frames[i], (uint32_t)i, true);
+    time_kind("valid v2", frames, n);
+    for (long i = 0; i < n; i++) make_junk(&frames[i], (uint32_t)i, 1);
+    time_kind("wrong size", frames, n);
+    for (long i = 0; i < n; i++) make_junk(&frames[i], (uint32_t)i, 2);
+    time_kind("off-subnet", frames, n);
+    for (long i = 0; i < n; i++) make_junk(&frames[i], (uint32_t)i, 0);
+    time_kind("bad CRC", frames, n);
+
+    printf("--- flood, %d junk frames after each valid one, 10 s simulated\n", junk);
+    static const long rates[] = { 100, 500, 1000, 5000, 20000, 100000 };
+    for (size_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+        long rate = rates[r];
+        long sent = rate * 10;
+        long cycles = 0, stale = 0;
+        uint32_t newest = 0;
+        int64_t next_cycle_us = CYCLE_US;
+        command_t last;
+        struct frame f, bad[16];
+        double busy = 0;
+
+        q_head = q_count = 0;
+        overflows = rejected = 0;
+
+        for (long i = 0; i < sent; i++) {
+            int64_t t_us = i * 1000000 / rate;
+
+            while (t_us >= next_cycle_us) {
+                if (loop_drain(&last) && last.sequence != newest) {
+                    stale++;
+                }
+                cycles++;
+                next_cycle_us += CYCLE_US;
+            }
+
+            make_valid(&f, (uint32_t)i, false);
+            for (int j = 0; j < junk; j++) {
+                make_junk(&bad[j], (uint32_t)i, j);
+            }
+            double t0 = now_s();
+            receive(&f);
+            for (int j = 0; j < junk; j++) {
+                receive(&bad[j]);
+            }
+            busy += now_s() - t0;
+            newest = (uint32_t)i;
+        }
+        printf("%7ld valid/s: %6.2f %% of one host core, %u older commands "
+               "dropped, loop acted on a stale command in %ld of %ld cycles\n",
+               rate, busy / 10.0 * 100.0, overflows, stale, cycles);
+        if (stale) {
+            return 1;
+        }
+    }
+    free(frames);
+    return 0;
+}
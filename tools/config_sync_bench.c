@@ -0,0 +1,237 @@
+/*
+ * Host benchmark and test of the control loop's per-cycle config reads,
+ * run on the firmware's generation-counted store (src/config_gen.c).
+ *
+ * Build and run on the host:
+ *
+ *   cc -O2 -pthread -Isrc -Itools/host -o config_sync_bench \
+ *      tools/config_sync_bench.c src/config_gen.c
+ *   ./config_sync_bench [cycles]
+ *
+ * tools/host supplies <zephyr/sys/atomic.h> on GCC atomics; everything
+ * else config_gen.c does is the firmware's code as built.
+ *
+ * Part one times the steady state: the getters the generation check
+ * replaced (six pid_config_get_gains() calls, two axis remaps and the
+ * offset getter, each a lock/copy/unlock under a pthread mutex standing
+ * in for k_mutex) against config_gen_sync() on a gains store and an
+ * axis store with nothing changing.  The old getters are no longer in
+ * the tree, so that half is a model of them.  Absolute times are for the
+ * host CPU; on the M7 a k_mutex lock/unlock pair is a pair of system
+ * calls into the scheduler, so the ratio there is larger, not smaller.
+ *
+ * Part two checks the store under a writer for one second.  A 50 us
+ * interval timer stands in for the writer thread: its SIGALRM handler
+ * publishes versions with config_gen_write_begin()/_end(), but stops
+ * half way through each write and finishes it on the next tick, so the
+ * reader sees writes in progress (an odd generation, as on SMP) as well
+ * as writes landing in the middle of its copy (a preempted reader).  The
+ * reader copies in a loop with config_gen_read(), as
+ * pid_config_get_gains() does, and config_gen_sync().  Every field of a
+ * version holds that version's number, so a torn copy shows up as two
+ * different numbers.  Exits non-zero on one.
+ */
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+#include "config_gen.h"
+
+#define AXES      6
+#define GEN_NONE  1U              /* PID_CONFIG_GEN_NONE, AXIS_CONFIG_GEN_NONE */
+
+typedef struct { float kp, ki, kd; } gains_t;
+typedef struct { uint8_t src; int8_t sign; } map_t;
+typedef struct { float x, y, z; } offset_t;
+typedef struct { map_t ypr[3]; map_t accel[3]; offset_t offset; } axis_cfg_t;
+
+static gains_t gains[AXES];
+static axis_cfg_t axis = {
+    .ypr   = { {0, 1}, {1, 1}, {2, 1} },
+    .accel = { {0, 1}, {1, 1}, {2, 1} },
+};
+static pthread_mutex_t gains_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t axis_mutex = PTHREAD_MUTEX_INITIALIZER;
+static atomic_t gains_seq, axis_seq;
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* ---- Before: lock per getter call ---- */
+
+static gains_t get_gains_locked(int i)
+{
+    pthread_mutex_lock(&gains_mutex);
+    gains_t g = gains[i];
+    pthread_mutex_unlock(&gains_mutex);
+    return g;
+}
+
+static void remap_locked(const map_t *map, const float raw[3], float out[3])
+{
+    pthread_mutex_lock(&axis_mutex);
+    for (int i = 0; i < 3; i++) {
+        out[i] = raw[map[i].src] * map[i].sign;
+    }
+    pthread_mutex_unlock(&axis_mutex);
+}
+
+static offset_t get_offset_locked(void)
+{
+    pthread_mutex_lock(&axis_mutex);
+    offset_t o = axis.offset;
+    pthread_mutex_unlock(&axis_mutex);
+    return o;
+}
+
+/* ---- After: axis_config_remap() on the loop's own copy ---- */
+
+static void remap(const map_t *map, const float raw[3], float out[3])
+{
+    for (int i = 0; i < 3; i++) {
+        out[i] = raw[map[i].src] * map[i].sign;
+    }
+}
+
+static void steady_state(long cycles)
+{
+    float raw[3] = { 10.0f, -2.0f, 0.5f };
+    float out[3];
+    volatile float sink = 0.0f;
+
+    double t0 = now_s();
+    for (long c = 0; c < cycles; c++) {
+        for (int i = 0; i < AXES; i++) {
+            gains_t g = get_gains_locked(i);
+            sink += g.kp;
+        }
+        remap_locked(axis.ypr, raw, out);
+        sink += out[0];
+        remap_locked(axis.accel, raw, out);
+        sink += out[1];
+        offset_t o = get_offset_locked();
+        sink += o.x;
+    }
+    double t_locked = now_s() - t0;
+
+    uint32_t gains_gen = GEN_NONE, axis_gen = GEN_NONE;
+    gains_t local_gains[AXES];
+    axis_cfg_t local_axis;
+
+    t0 = now_s();
+    for (long c = 0; c < cycles; c++) {
+        if (config_gen_sync(&gains_seq, &gains_gen, local_gains, gains, sizeof(gains))) {
+            sink += local_gains[0].kp;
+        }
+        if (config_gen_sync(&axis_seq, &axis_gen, &local_axis, &axis, sizeof(axis))) {
+            sink += local_axis.offset.x;
+        }
+        remap(local_axis.ypr, raw, out);
+        sink += out[0];
+        remap(local_axis.accel, raw, out);
+        sink += out[1];
+    }
+    double t_gen = now_s() - t0;
+
+    printf("cycles          %ld\n", cycles);
+    printf("locked getters  %7.1f ns/cycle (9 lock/unlock pairs)\n", t_locked / cycles * 1e9);
+    printf("generation      %7.1f ns/cycle (2 atomic loads)\n", t_gen / cycles * 1e9);
+    printf("speed-up        %7.1fx\n", t_locked / t_gen);
+}
+
+/* ---- Under a writer ---- */
+
+static volatile long versions_written;
+
+/* Half a write per tick: begin and the first three axes, then the rest and end */
+static void writer_tick(int sig)
+{
+    static bool half;
+    static float v = 1.0f;
+
+    (void)sig;
+    if (!half) {
+        config_gen_write_begin(&gains_seq);
+        for (int i = 0; i < AXES / 2; i++) {
+            gains[i].kp = gains[i].ki = gains[i].kd = v;
+        }
+    } else {
+        for (int i = AXES / 2; i < AXES; i++) {
+            gains[i].kp = gains[i].ki = gains[i].kd = v;
+        }
+        config_gen_write_end(&gains_seq);
+        v += 1.0f;
+        versions_written++;
+    }
+    half = !half;
+}
+
+static bool consistent(const gains_t g[AXES])
+{
+    for (int i = 0; i < AXES; i++) {
+        if (g[i].kp != g[0].kp || g[i].ki != g[0].kp || g[i].kd != g[0].kp) {
+            printf("torn copy: axis %d holds %.0f/%.0f/%.0f, axis 0 %.0f\n", i,
+                   (double)g[i].kp, (double)g[i].ki, (double)g[i].kd, (double)g[0].kp);
+            return false;
+        }
+    }
+    return true;
+}
+
+static int concurrent(double seconds)
+{
+    struct itimerval tick = { { 0, 50 }, { 0, 50 } };
+    struct itimerval off = { { 0, 0 }, { 0, 0 } };
+    uint32_t gen = GEN_NONE;
+    gains_t local[AXES], snap[AXES];
+    long reads = 0, copies = 0;
+    float last = 0.0f;
+    int err = 0;
+
+    signal(SIGALRM, writer_tick);
+    setitimer(ITIMER_REAL, &tick, NULL);
+
+    for (double end = now_s() + seconds; !err && now_s() < end; reads++) {
+        uint32_t g = config_gen_read(&gains_seq, snap, gains, sizeof(gains));
+        if (!consistent(snap) || (g & 1)) {
+            err = 1;
+            break;
+        }
+        if (!config_gen_sync(&gains_seq, &gen, local, gains, sizeof(gains))) {
+            continue;
+        }
+        copies++;
+        if (!consistent(local) || (gen & 1) || local[0].kp < last) {
+            printf("generation %u: %.0f after %.0f\n", gen, (double)local[0].kp,
+                   (double)last);
+            err = 1;
+        }
+        last = local[0].kp;
+    }
+
+    setitimer(ITIMER_REAL, &off, NULL);
+    if (!err) {
+        printf("under a writer  %ld reads, %ld new versions synced, %ld written, none torn\n",
+               reads, copies, versions_written);
+    }
+    return err;
+}
+
+int main(int argc, char **argv)
+{
+    long cycles = (argc > 1) ? atol(argv[1]) : 10000000;
+
+    steady_state(cycles);
+    return concurrent(1.0);
+}
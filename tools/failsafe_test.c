@@ -0,0 +1,175 @@
+/*
+ * Host test of the staged link-loss failsafe in src/failsafe.c, driven
+ * the way rov_control_thread() drives it.
+ *
+ * Build and run on the host:
+ *
+ *   cc -O2 -Isrc -o failsafe_test tools/failsafe_test.c src/failsafe.c -lm
+ *   ./failsafe_test
+ *
+ * A 50 Hz loop receives a command every cycle.  The command handling
+ * below mirrors control.c: a new command refreshes the command timer,
+ * and reaches the sticks only while failsafe_pilot_live(); entering
+ * FAILSAFE_ATTITUDE zeroes the sticks.  Scenarios:
+ *
+ *   - heartbeat lost while commands keep flowing: the stages step on
+ *     their durations, the sticks hold the last live value through
+ *     HOLD and stay zero from ATTITUDE on, and the outputs ramp to 0;
+ *     a fresh heartbeat restores normal control
+ *   - commands stop with the heartbeat still arriving: failsafe after
+ *     FAILSAFE_COMMS_TIMEOUT_MS
+ *
+ * Time starts at 1 s of uptime: a command time of 0 means none yet.
+ * Exits non-zero on the first failed check.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "failsafe.h"
+
+#define HOLD_MS      500    /* Kconfig defaults */
+#define ATTITUDE_MS  3000
+#define RAMP_MS      1000
+#define HB_TIMEOUT   300
+#define PERIOD_MS    20
+
+static struct failsafe fs;
+static int64_t last_cmd_ms;
+static int64_t last_hb_ms = -1;         /* -1 = topside never sent one */
+static int pilot;                       /* one stick stands for all of them */
+
+#define CHECK(cond, ...)                                                   \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__);                    \
+            printf(__VA_ARGS__);                                           \
+            printf("\n");                                                  \
+            exit(1);                                                       \
+        }                                                                  \
+    } while (0)
+
+/* One control cycle; cmd < 0 means no command arrived */
+static void cycle(int64_t now, int cmd)
+{
+    if (cmd >= 0) {
+        last_cmd_ms = now;
+    }
+
+    int32_t hb_age = (last_hb_ms < 0) ? -1 : (int32_t)(now - last_hb_ms);
+    bool ok = failsafe_link_ok(now, last_cmd_ms, hb_age, HB_TIMEOUT);
+    enum failsafe_stage prev = failsafe_update(&fs, ok, now);
+
+    if (prev < FAILSAFE_ATTITUDE && fs.stage >= FAILSAFE_ATTITUDE) {
+        pilot = 0;
+    }
+    if (cmd >= 0 && failsafe_pilot_live(&fs)) {
+        pilot = cmd;
+    }
+}
+
+static void heartbeat_lost_commands_continue(void)
+{
+    int64_t t;
+
+    failsafe_init(&fs, HOLD_MS, ATTITUDE_MS, RAMP_MS);
+    last_cmd_ms = 0;
+    last_hb_ms = -1;
+    pilot = 0;
+
+    /* Link up, heartbeats at 50 Hz with the commands */
+    for (t = 1000; t < 3000; t += PERIOD_MS) {
+        last_hb_ms = t;
+        cycle(t, 40);
+        CHECK(fs.stage == FAILSAFE_NONE, "t=%lld stage %d with link up", (long long)t, fs.stage);
+        CHECK(pilot == 40, "t=%lld pilot %d with link up", (long long)t, pilot);
+    }
+
+    /* Heartbeats stop at lost; the pilot keeps pushing a different stick */
+    const int64_t lost = last_hb_ms;
+    const int64_t hold_at = lost + HB_TIMEOUT + PERIOD_MS;  /* first cycle past the timeout */
+    float prev_scale = 1.0f;
+
+    for (; t < hold_at + HOLD_MS + ATTITUDE_MS + RAMP_MS + 1000; t += PERIOD_MS) {
+        cycle(t, 100);
+
+        enum failsafe_stage want;
+        if (t < hold_at) {
+            want = FAILSAFE_NONE;
+        } else if (t < hold_at + HOLD_MS) {
+            want = FAILSAFE_HOLD;
+        } else if (t < hold_at + HOLD_MS + ATTITUDE_MS) {
+            want = FAILSAFE_ATTITUDE;
+        } else if (t < hold_at + HOLD_MS + ATTITUDE_MS + RAMP_MS) {
+            want = FAILSAFE_RAMP;
+        } else {
+            want = FAILSAFE_STOPPED;
+        }
+        CHECK(fs.stage == want, "t=%lld stage %d, want %d", (long long)t, fs.stage, want);
+
+        if (want == FAILSAFE_NONE) {
+            CHECK(pilot == 100, "t=%lld pilot %d before timeout", (long long)t, pilot);
+        } else if (want == FAILSAFE_HOLD) {
+            /* The setpoint from before the loss was detected is flown */
+            CHECK(pilot == 100, "t=%lld pilot %d in HOLD", (long long)t, pilot);
+        } else {
+            CHECK(pilot == 0, "t=%lld pilot %d in stage %d with commands arriving",
+                  (long long)t, pilot, fs.stage);
+        }
+
+        float scale = failsafe_output_scale(&fs, t);
+        if (want == FAILSAFE_RAMP) {
+            float expect = 1.0f - (float)(t - (hold_at + HOLD_MS + ATTITUDE_MS)) / RAMP_MS;
+            CHECK(fabsf(scale - expect) < 1e-4f, "t=%lld scale %f, want %f",
+                  (long long)t, scale, expect);
+            CHECK(scale <= prev_scale, "t=%lld scale rose to %f", (long long)t, scale);
+            prev_scale = scale;
+        } else if (want != FAILSAFE_STOPPED) {
+            CHECK(scale == 1.0f, "t=%lld scale %f outside the ramp", (long long)t, scale);
+        }
+    }
+
+    /* A heartbeat brings the link back; the next command steers again */
+    last_hb_ms = t;
+    cycle(t, 70);
+    CHECK(fs.stage == FAILSAFE_NONE, "stage %d after heartbeat restored", fs.stage);
+    CHECK(pilot == 70, "pilot %d after heartbeat restored", pilot);
+    printf("ok  heartbeat lost, commands continue: sticks zero from ATTITUDE to restore\n");
+}
+
+static void commands_stop(void)
+{
+    int64_t t;
+
+    failsafe_init(&fs, HOLD_MS, ATTITUDE_MS, RAMP_MS);
+    last_cmd_ms = 0;
+    last_hb_ms = -1;
+    pilot = 0;
+
+    CHECK(fs.stage == FAILSAFE_STOPPED, "stage %d at start", fs.stage);
+    for (t = 1000; t < 2000; t += PERIOD_MS) {
+        last_hb_ms = t;
+        cycle(t, 30);
+    }
+    const int64_t last = t - PERIOD_MS;
+
+    for (; t < last + FAILSAFE_COMMS_TIMEOUT_MS + HOLD_MS + 200; t += PERIOD_MS) {
+        last_hb_ms = t;
+        cycle(t, -1);
+        enum failsafe_stage want = (t - last <= FAILSAFE_COMMS_TIMEOUT_MS) ? FAILSAFE_NONE :
+                                   (t - last <= FAILSAFE_COMMS_TIMEOUT_MS + HOLD_MS) ?
+                                   FAILSAFE_HOLD : FAILSAFE_ATTITUDE;
+        CHECK(fs.stage == want, "t=%lld stage %d, want %d", (long long)t, fs.stage, want);
+    }
+    CHECK(pilot == 0, "pilot %d after ATTITUDE", pilot);
+    printf("ok  commands stop, heartbeat continues: failsafe after %d ms\n",
+           FAILSAFE_COMMS_TIMEOUT_MS);
+}
+
+int main(void)
+{
+    heartbeat_lost_commands_continue();
+    commands_stop();
+    return 0;
+}
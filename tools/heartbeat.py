@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+Topside heartbeat for the K2 link-loss failsafe (UDP 5014).
+
+Sends PINGs at a fixed rate (src/net/heartbeat.h) and prints the round
+trip and the ROV's failsafe stage from each PONG, plus every stage
+change.  Run it next to the pilot console; stop it (or pull the tether)
+to watch the failsafe step through hold, attitude, ramp and stop.
+
+    python3 tools/heartbeat.py [--target 10.77.0.2] [--rate 10] [--timeout 300]
+"""
+
+import argparse
+import binascii
+import socket
+import struct
+import sys
+import time
+
+PACKET = struct.Struct('<BBHIqqq')   # type, failsafe, timeout_ms, sequence, topside_us, mcu_us, since_us
+PING, PONG = 1, 2
+STAGES = ('none', 'hold', 'attitude', 'ramp', 'stopped')
+
+
+def now_us():
+    return time.time_ns() // 1000
+
+
+def pack_ping(seq, timeout_ms):
+    body = PACKET.pack(PING, 0, timeout_ms, seq, now_us(), 0, 0)
+    return body + struct.pack('<I', binascii.crc32(body))
+
+
+def unpack(data):
+    if len(data) != PACKET.size + 4:
+        raise ValueError(f'bad length {len(data)}')
+    (crc,) = struct.unpack_from('<I', data, PACKET.size)
+    if binascii.crc32(data[:PACKET.size]) != crc:
+        raise ValueError('CRC mismatch')
+    return PACKET.unpack_from(data)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument('--target', default='10.77.0.2')
+    ap.add_argument('--port', type=int, default=5014)
+    ap.add_argument('--rate', type=float, default=10.0, help='pings per second')
+    ap.add_argument('--timeout', type=int, default=0,
+                    help='link-loss timeout to request in ms (0 = ROV default)')
+    ap.add_argument('--quiet', action='store_true', help='only print stage changes')
+    args = ap.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    dest = (args.target, args.port)
+    period = 1.0 / args.rate
+    seq = 0
+    stage = None
+    next_send = time.monotonic()
+
+    try:
+        while True:
+            seq += 1
+            sock.sendto(pack_ping(seq, args.timeout), dest)
+            next_send += period
+
+            while True:
+                remaining = next_send - time.monotonic()
+                if remaining <= 0:
+                    break
+                sock.settimeout(remaining)
+                try:
+                    data, _ = sock.recvfrom(256)
+                except socket.timeout:
+                    break
+                try:
+                    (_, fs, timeout_ms, rseq, t_sent, mcu_us, since_us) = unpack(data)
+                except ValueError as e:
+                    print(f'bad pong: {e}', file=sys.stderr)
+                    continue
+
+                name = STAGES[fs] if fs < len(STAGES) else str(fs)
+                if fs != stage:
+                    print(f'failsafe -> {name} (entered at MCU {since_us / 1e6:.3f} s, '
+                          f'now {mcu_us / 1e6:.3f} s)')
+                    stage = fs
+                if not args.quiet:
+                    rtt = (now_us() - t_sent) / 1000
+                    print(f'#{rseq:<6d} rtt={rtt:6.2f} ms timeout={timeout_ms} ms stage={name}')
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,27 @@
+#pragma once
+
+/*
+ * Host stand-in for <zephyr/sys/atomic.h>: the calls the firmware's
+ * host-buildable units use, on GCC atomics.  Sequentially consistent
+ * like Zephyr's, so a unit behaves the same way under a host thread
+ * writing concurrently (or from a signal handler).  Host tools only,
+ * through -Itools/host.
+ */
+
+typedef long atomic_t;
+typedef long atomic_val_t;
+
+static inline atomic_val_t atomic_get(const atomic_t *target)
+{
+    return __atomic_load_n(target, __ATOMIC_SEQ_CST);
+}
+
+static inline atomic_val_t atomic_set(atomic_t *target, atomic_val_t value)
+{
+    return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST);
+}
+
+static inline atomic_val_t atomic_inc(atomic_t *target)
+{
+    return __atomic_fetch_add(target, 1, __ATOMIC_SEQ_CST);
+}
@@ -0,0 +1,90 @@
+/*
+ * Host benchmark of the IMU telemetry encoders: CPU time per sample and
+ * bytes on the wire for the legacy JSON text against the binary packet.
+ *
+ * Build and run on the host:
+ *
+ *   cc -O2 -Isrc -o imu_telem_bench tools/imu_telem_bench.c \
+ *      src/net/imu_telemetry.c src/net/crc32.c -lm
+ *   ./imu_telem_bench [iterations]
+ *
+ * Absolute times are for the host CPU; the ratio is what carries over to
+ * the M7.  Bytes include the 28-byte IPv4/UDP header per datagram.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "net/imu_telemetry.h"
+
+#define UDP_IP_OVERHEAD 28
+#define NUM_SAMPLES     1024
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void make_samples(imu_sample_t *s, int n)
+{
+    for (int i = 0; i < n; i++) {
+        float t = i * 0.2f;
+        s[i].yaw   = 179.9f * sinf(0.05f * t);
+        s[i].pitch = -12.5f * sinf(0.2f * t);
+        s[i].roll  = 25.0f * cosf(0.15f * t);
+        s[i].yr    = 45.0f * cosf(0.05f * t);
+        s[i].pr    = -8.0f * cosf(0.2f * t);
+        s[i].rr    = 6.0f * sinf(0.15f * t);
+        s[i].ax    = 0.25f * sinf(0.1f * t);
+        s[i].ay    = -0.05f * cosf(0.1f * t);
+        s[i].az    = 0.01f * sinf(t);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    long iters = (argc > 1) ? atol(argv[1]) : 200000;
+    static imu_sample_t samples[NUM_SAMPLES];
+    char json[IMU_TELEM_JSON_MAX];
+    imu_telem_packet_t pkt;
+    static const uint32_t rejects[IMU_REJ_COUNT] = { 0, 2, 0, 14, 9, 1 };
+    volatile size_t sink = 0;
+    size_t json_bytes = 0, bin_bytes = 0;
+
+    make_samples(samples, NUM_SAMPLES);
+
+    double t0 = now_s();
+    for (long i = 0; i < iters; i++) {
+        int len = imu_telem_encode_json(json, sizeof(json), &samples[i % NUM_SAMPLES]);
+        json_bytes += (size_t)len;
+        sink += (size_t)json[len - 1];
+    }
+    double t_json = now_s() - t0;
+
+    t0 = now_s();
+    for (long i = 0; i < iters; i++) {
+        bin_bytes += imu_telem_encode_binary(&pkt, &samples[i % NUM_SAMPLES], rejects,
+                                             (uint32_t)i, (uint32_t)i * 200u,
+                                             IMU_TELEM_FLAG_FRESH);
+        sink += pkt.crc32;
+    }
+    double t_bin = now_s() - t0;
+
+    double json_avg = (double)json_bytes / iters;
+    double bin_avg = (double)bin_bytes / iters;
+
+    printf("%ld samples\n", iters);
+    printf("%-8s %10s %12s %14s\n", "format", "ns/sample", "payload B", "on-wire B");
+    printf("%-8s %10.1f %12.1f %14.1f\n", "json",
+           t_json * 1e9 / iters, json_avg, json_avg + UDP_IP_OVERHEAD);
+    printf("%-8s %10.1f %12.1f %14.1f\n", "binary",
+           t_bin * 1e9 / iters, bin_avg, bin_avg + UDP_IP_OVERHEAD);
+    printf("binary is %.1fx faster and %.0f%% smaller on the wire\n",
+           t_json / t_bin,
+           100.0 * (1.0 - (bin_avg + UDP_IP_OVERHEAD) / (json_avg + UDP_IP_OVERHEAD)));
+    return (int)(sink & 0);
+}
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""
+Decode K2 IMU telemetry from UDP port 5002.
+
+Handles both the binary packet (src/net/imu_telemetry.h) and the legacy
+JSON text sent when CONFIG_K2_IMU_TELEM_JSON is enabled.  Reports CRC
+failures and sequence gaps; prints one line per sample or CSV with --csv.
+
+    python3 tools/imu_telem_decode.py [--port 5002] [--csv]
+"""
+
+import argparse
+import binascii
+import json
+import socket
+import struct
+import sys
+
+HEADER = struct.Struct('<BBHII')       # version, flags, length, sequence, sample_ms
+BODY_V1 = struct.Struct('<9f')         # ypr[3], rates[3], accel[3]
+V1_LEN = HEADER.size + BODY_V1.size + 4
+REJECTS_V2 = struct.Struct('<6I')      # per-check rejection counters, enum imu_reject order
+V2_LEN = V1_LEN + REJECTS_V2.size
+REJECT_NAMES = ('nonfinite', 'range', 'rate', 'rate_step', 'att_jump', 'accel')
+
+FLAG_FRESH = 0x01
+
+FIELDS = ('yaw', 'pitch', 'roll', 'yr', 'pr', 'rr', 'ax', 'ay', 'az')
+
+
+def decode_binary(data):
+    """Return (sequence, sample_ms, flags, values) or raise ValueError.
+
+    From v2, values['rejects'] maps each validation check to the samples
+    it has rejected since boot."""
+    if len(data) < V1_LEN:
+        raise ValueError(f'short packet ({len(data)} bytes)')
+    version, flags, length, sequence, sample_ms = HEADER.unpack_from(data)
+    if version < 1:
+        raise ValueError(f'unknown version {version}')
+    if length < V1_LEN or length > len(data):
+        raise ValueError(f'bad length field {length}')
+    (crc,) = struct.unpack_from('<I', data, length - 4)
+    if binascii.crc32(data[:length - 4]) != crc:
+        raise ValueError('CRC mismatch')
+    values = dict(zip(FIELDS, BODY_V1.unpack_from(data, HEADER.size)))
+    if version >= 2 and length >= V2_LEN:
+        rejects = REJECTS_V2.unpack_from(data, HEADER.size + BODY_V1.size)
+        values['rejects'] = dict(zip(REJECT_NAMES, rejects))
+    return sequence, sample_ms, flags, values
+
+
+def format_rejects(values):
+    """' rejects=name:n,...' for the non-zero counters, or ''."""
+    rejects = {k: n for k, n in values.get('rejects', {}).items() if n}
+    if not rejects:
+        return ''
+    return ' rejects=' + ','.join(f'{k}:{n}' for k, n in rejects.items())
+
+
+def decode_json(data):
+    return json.loads(data.decode())['imu']
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument('--port', type=int, default=5002)
+    ap.add_argument('--csv', action='store_true', help='print CSV rows')
+    args = ap.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.bind(('', args.port))
+
+    if args.csv:
+        print('sequence,sample_ms,fresh,' + ','.join(FIELDS))
+
+    last_seq = None
+    lost = bad = 0
+
+    try:
+        while True:
+            data, addr = sock.recvfrom(2048)
+
+            if data[:1] == b'{':
+                try:
+                    v = decode_json(data)
+                except (ValueError, KeyError) as e:
+                    bad += 1
+                    print(f'{addr[0]}: bad JSON: {e}', file=sys.stderr)
+                    continue
+                seq, ts, fresh = '', '', ''
+            else:
+                try:
+                    seq, ts, flags, v = decode_binary(data)
+                except ValueError as e:
+                    bad += 1
+                    print(f'{addr[0]}: {e}', file=sys.stderr)
+                    continue
+                if last_seq is not None and seq != (last_seq + 1) & 0xFFFFFFFF:
+                    lost += (seq - last_seq - 1) & 0xFFFFFFFF
+                last_seq = seq
+                fresh = int(bool(flags & FLAG_FRESH))
+
+            if args.csv:
+                print(f'{seq},{ts},{fresh},' + ','.join(f'{v[k]:.4f}' for k in FIELDS))
+            else:
+                print(f'#{seq} t={ts} ms fresh={fresh} '
+                      f'ypr=({v["yaw"]:7.2f} {v["pitch"]:6.2f} {v["roll"]:6.2f}) '
+                      f'rates=({v["yr"]:7.2f} {v["pr"]:7.2f} {v["rr"]:7.2f}) '
+                      f'accel=({v["ax"]:6.3f} {v["ay"]:6.3f} {v["az"]:6.3f})'
+                      + format_rejects(v))
+    except KeyboardInterrupt:
+        print(f'\nlost {lost}, rejected {bad}', file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
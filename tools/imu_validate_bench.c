@@ -0,0 +1,143 @@
+/*
+ * Host test and benchmark of the IMU sample validation stage,
+ * src/imu/imu_validate.c compiled in as is.
+ *
+ * Build and run on the host:
+ *
+ *   cc -O2 -Isrc -Itools/host -o imu_validate_bench tools/imu_validate_bench.c \
+ *      src/imu/imu_validate.c -lm
+ *   ./imu_validate_bench [samples]
+ *
+ * Feeds a 20 Hz stream, as vn100s_task() reads it: the vehicle yaws
+ * through ±180 at 30 deg/s while pitching and rolling, with the rates
+ * the attitude implies.  The clean run must accept every sample.  The
+ * corrupt run replaces one sample in ten with a bad frame, cycling
+ * through NaN, pitch out of range, a 900 deg/s rate, a 400 deg/s rate
+ * step, a 170 deg yaw jump and an 8 g acceleration.  Each must be
+ * rejected for the expected reason, and every clean sample accepted.
+ * Exits non-zero on the first wrong answer.
+ *
+ * Times are for the host CPU and include copying each sample, as the
+ * IMU task does.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "imu/imu_validate.h"
+
+#define PERIOD_MS  50                   /* vn100s_task() k_msleep(50) */
+#define KINDS      6
+
+static const enum imu_reject expect[KINDS] = {
+    IMU_REJ_NONFINITE, IMU_REJ_RANGE, IMU_REJ_RATE_LIMIT,
+    IMU_REJ_RATE_STEP, IMU_REJ_ATTITUDE_JUMP, IMU_REJ_ACCEL_LIMIT,
+};
+
+static imu_sample_t clean(long i)
+{
+    float t = (float)i * PERIOD_MS * 0.001f;
+    imu_sample_t s;
+
+    s.yaw   = fmodf(30.0f * t + 180.0f, 360.0f) - 180.0f;
+    s.pitch = 20.0f * sinf(0.5f * t);
+    s.roll  = 15.0f * sinf(0.7f * t);
+    s.yr    = 30.0f;
+    s.pr    = 10.0f * cosf(0.5f * t);
+    s.rr    = 10.5f * cosf(0.7f * t);
+    s.ax    = 0.3f * sinf(1.3f * t);
+    s.ay    = 0.2f * cosf(0.9f * t);
+    s.az    = 0.05f * sinf(2.1f * t);
+    return s;
+}
+
+static imu_sample_t corrupt(imu_sample_t s, int kind)
+{
+    switch (kind) {
+    case 0: s.ax = NAN; break;
+    case 1: s.pitch = 120.0f; break;
+    case 2: s.rr = 900.0f; break;
+    case 3: s.yr += 400.0f; break;
+    case 4: s.yaw = (s.yaw > 0.0f) ? s.yaw - 170.0f : s.yaw + 170.0f; break;
+    case 5: s.az = 80.0f; break;
+    }
+    return s;
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Validate n samples, timed, then again checking each answer; one in
+ * ten is corrupt if `bad` */
+static void run(const char *name, const imu_sample_t *stream, long n, int bad)
+{
+    enum imu_reject reason;
+    long accepted = 0;
+    double t0 = now_s();
+
+    imu_validate_reset();
+    for (long i = 0; i < n; i++) {
+        imu_sample_t s = stream[i];
+        if (imu_validate(&s, 1000 + i * PERIOD_MS, &reason)) {
+            accepted++;
+        }
+    }
+    double ns = (now_s() - t0) / n * 1e9;
+
+    /* Same stream again, untimed, checking every answer */
+    imu_validate_reset();
+    for (long i = 0; i < n; i++) {
+        imu_sample_t s = stream[i];
+        bool is_bad = bad && i % 10 == 9;
+        bool ok = imu_validate(&s, 1000 + i * PERIOD_MS, &reason);
+
+        if (!is_bad && !ok) {
+            printf("%s: clean sample %ld rejected (%s)\n", name, i,
+                   imu_validate_reason_str(reason));
+            exit(1);
+        }
+        if (is_bad && (ok || reason != expect[(i / 10) % KINDS])) {
+            printf("%s: bad sample %ld %s, want %s\n", name, i,
+                   ok ? "accepted" : imu_validate_reason_str(reason),
+                   imu_validate_reason_str(expect[(i / 10) % KINDS]));
+            exit(1);
+        }
+    }
+    printf("%-8s %8.1f ns/sample  %ld of %ld accepted\n", name, ns, accepted, n);
+}
+
+int main(int argc, char **argv)
+{
+    long n = (argc > 1) ? atol(argv[1]) : 1000000;
+    imu_sample_t *stream = malloc(sizeof(*stream) * (size_t)n);
+    uint32_t rejects[IMU_REJ_COUNT];
+
+    if (n < 10 || !stream) {
+        fprintf(stderr, "need at least 10 samples\n");
+        return 1;
+    }
+    for (long i = 0; i < n; i++) {
+        stream[i] = clean(i);
+    }
+    run("clean", stream, n, 0);
+
+    for (long i = 9; i < n; i += 10) {
+        stream[i] = corrupt(stream[i], (int)((i / 10) % KINDS));
+    }
+    run("corrupt", stream, n, 1);
+
+    imu_validate_get_stats(rejects);
+    printf("rejects (both runs, timed and checked):");
+    for (int r = 0; r < IMU_REJ_COUNT; r++) {
+        printf(" %s %u", imu_validate_reason_str((enum imu_reject)r), rejects[r]);
+    }
+    printf("\n");
+    free(stream);
+    return 0;
+}
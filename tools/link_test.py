@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+"""
+Tether link self-test client (UDP 5015, src/net/link_test.h).
+
+Enables the ROV's link test through system control (port 5008, "LNK1"),
+runs one measurement and disables it again:
+
+  echo    round-trip latency distribution and loss
+  sink    topside → MCU throughput and loss, counted by the MCU
+  source  MCU → topside throughput and loss, counted here
+
+Every datagram in a run has the same --size (header included, max 1024).
+The MCU serves the test from a thread below the control loop, so the
+control telemetry should not change while this runs; watch it with
+tools/telem_subscribe.py or tools/tc_latency.py to confirm.
+
+    python3 tools/link_test.py echo --count 1000 --rate 100
+    python3 tools/link_test.py sink --count 20000 --size 1024
+    python3 tools/link_test.py source --count 20000 --rate 2000
+"""
+
+import argparse
+import binascii
+import select
+import socket
+import struct
+import sys
+import time
+
+HEADER = struct.Struct('<BxHIqq')     # type, length, sequence, topside_us, mcu_us
+CRC = struct.Struct('<I')
+HEADER_LEN = HEADER.size + CRC.size
+STATS = struct.Struct('<IIIIqq')      # packets, bytes, lost, reordered, first_us, last_us
+SOURCE = struct.Struct('<II')         # count, rate_pps
+
+ECHO, ECHO_REPLY, SINK, REPORT_REQ, REPORT, SOURCE_REQ, SOURCE_DATA, RESET = range(1, 9)
+MAX_LEN = 1024
+
+
+def now_us():
+    return time.time_ns() // 1000
+
+
+def pack(ptype, length, seq=0, payload=b''):
+    head = HEADER.pack(ptype, length, seq, now_us(), 0)
+    body = payload.ljust(length - HEADER_LEN, b'\0')
+    return head + CRC.pack(binascii.crc32(head)) + body
+
+
+def unpack(data):
+    if len(data) < HEADER_LEN:
+        return None
+    ptype, length, seq, topside_us, mcu_us = HEADER.unpack_from(data)
+    (crc,) = CRC.unpack_from(data, HEADER.size)
+    if length != len(data) or binascii.crc32(data[:HEADER.size]) != crc:
+        return None
+    return ptype, seq, topside_us, mcu_us, data[HEADER_LEN:]
+
+
+def system_control(sock, target, magic, arg):
+    body = magic + struct.pack('>I', arg)
+    sock.sendto(body + struct.pack('>I', binascii.crc32(body)), (target, 5008))
+
+
+def percentile(values, pct):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * pct / 100))]
+
+
+def paced(count, rate):
+    """Yield 0..count-1, sleeping so they come out at `rate` per second."""
+    start = time.monotonic()
+    for seq in range(count):
+        if rate:
+            delay = start + seq / rate - time.monotonic()
+            if delay > 0:
+                time.sleep(delay)
+        yield seq
+
+
+def recv_all(sock, timeout):
+    """Yield datagrams until `timeout` seconds pass without one."""
+    while select.select([sock], [], [], timeout)[0]:
+        yield sock.recv(2048)
+
+
+def run_echo(sock, dest, args):
+    rtts = {}
+    sent = 0
+    for seq in paced(args.count, args.rate):
+        sock.sendto(pack(ECHO, args.size, seq), dest)
+        sent += 1
+        while select.select([sock], [], [], 0)[0]:
+            collect_echo(sock.recv(2048), rtts)
+    for data in recv_all(sock, args.timeout):
+        collect_echo(data, rtts)
+
+    lost = sent - len(rtts)
+    print(f'echo       {sent} sent, {len(rtts)} replies, '
+          f'{lost} lost ({100.0 * lost / max(sent, 1):.2f} %)')
+    if rtts:
+        r = list(rtts.values())
+        print(f'rtt ms     min {min(r):.3f} p50 {percentile(r, 50):.3f} '
+              f'p90 {percentile(r, 90):.3f} p99 {percentile(r, 99):.3f} max {max(r):.3f}')
+
+
+def collect_echo(data, rtts):
+    pkt = unpack(data)
+    if pkt and pkt[0] == ECHO_REPLY:
+        rtts[pkt[1]] = (now_us() - pkt[2]) / 1000
+
+
+def run_sink(sock, dest, args):
+    sock.sendto(pack(RESET, HEADER_LEN), dest)
+    time.sleep(0.1)
+    t0 = time.monotonic()
+    for seq in paced(args.count, args.rate):
+        sock.sendto(pack(SINK, args.size, seq), dest)
+    elapsed = time.monotonic() - t0
+
+    time.sleep(args.timeout)
+    stats = None
+    for _ in range(3):
+        sock.sendto(pack(REPORT_REQ, HEADER_LEN), dest)
+        for data in recv_all(sock, 1.0):
+            pkt = unpack(data)
+            if pkt and pkt[0] == REPORT and len(pkt[4]) >= STATS.size:
+                stats = STATS.unpack_from(pkt[4])
+                break
+        if stats:
+            break
+    if stats is None:
+        print('no report from the ROV', file=sys.stderr)
+        return 1
+
+    packets, nbytes, lost, reordered, first_us, last_us = stats
+    span = max(last_us - first_us, 1) / 1e6
+    missing = args.count - packets
+    print(f'sent       {args.count} x {args.size} B in {elapsed:.2f} s '
+          f'({args.count * args.size * 8 / elapsed / 1e6:.2f} Mbit/s offered)')
+    print(f'received   {packets} ({missing} missing, {100.0 * missing / args.count:.2f} %), '
+          f'{reordered} reordered, {lost} in sequence gaps')
+    print(f'throughput {nbytes * 8 / span / 1e6:.2f} Mbit/s over {span:.2f} s at the MCU')
+    return 0
+
+
+def run_source(sock, dest, args):
+    req = SOURCE.pack(args.count, int(args.rate))
+    sock.sendto(pack(SOURCE_REQ, max(args.size, HEADER_LEN + SOURCE.size), payload=req), dest)
+
+    seen = set()
+    reordered = 0
+    highest = -1
+    first = last = None
+    nbytes = 0
+    for data in recv_all(sock, args.timeout):
+        pkt = unpack(data)
+        if not pkt or pkt[0] != SOURCE_DATA:
+            continue
+        seq = pkt[1]
+        last = time.monotonic()
+        first = first or last
+        if seq < highest:
+            reordered += 1
+        highest = max(highest, seq)
+        seen.add(seq)
+        nbytes += len(data)
+        if len(seen) == args.count:
+            break
+
+    missing = args.count - len(seen)
+    print(f'received   {len(seen)} of {args.count} ({missing} missing, '
+          f'{100.0 * missing / args.count:.2f} %), {reordered} reordered')
+    if first and last > first:
+        span = last - first
+        print(f'throughput {nbytes * 8 / span / 1e6:.2f} Mbit/s over {span:.2f} s')
+    return 0
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument('mode', choices=('echo', 'sink', 'source'))
+    ap.add_argument('--target', default='10.77.0.2')
+    ap.add_argument('--port', type=int, default=5015)
+    ap.add_argument('--count', type=int, default=1000)
+    ap.add_argument('--rate', type=float, default=0.0,
+                    help='datagrams/s (0 = as fast as possible)')
+    ap.add_argument('--size', type=int, default=64,
+                    help=f'datagram size in bytes ({HEADER_LEN}..{MAX_LEN})')
+    ap.add_argument('--timeout', type=float, default=1.0,
+                    help='seconds to wait for stragglers')
+    ap.add_argument('--enable', type=int, default=120,
+                    help='seconds to enable the test for on the ROV')
+    args = ap.parse_args()
+
+    if not HEADER_LEN <= args.size <= MAX_LEN:
+        ap.error(f'--size must be {HEADER_LEN}..{MAX_LEN}')
+    if args.mode == 'echo' and args.rate == 0:
+        args.rate = 100.0
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 1 << 22)
+    dest = (args.target, args.port)
+
+    system_control(sock, args.target, b'LNK1', args.enable)
+    time.sleep(0.2)   # let the MCU open its socket
+    try:
+        run = {'echo': run_echo, 'sink': run_sink, 'source': run_source}[args.mode]
+        return run(sock, dest, args) or 0
+    except KeyboardInterrupt:
+        return 1
+    finally:
+        system_control(sock, args.target, b'LNK1', 0)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
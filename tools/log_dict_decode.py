@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""
+Decode K2 dictionary-based UDP logs (CONFIG_K2_LOG_UDP_DICT) from port 5006.
+
+Needs the log database from the same build and Zephyr's dictionary log
+parser, found through ZEPHYR_BASE:
+
+    python3 tools/log_dict_decode.py build/zephyr/log_dictionary.json
+
+Each datagram (src/net/log_backend_udp.h) is CRC-checked and its
+messages are passed to the parser.  Lost datagrams (sequence gaps) and
+growth of the firmware's dropped-message counter are reported inline.
+Text-mode datagrams are printed as-is, so the tool works with either build.
+"""
+
+import argparse
+import binascii
+import os
+import socket
+import struct
+import sys
+
+HEADER = struct.Struct('<BBHII')   # magic, version, count, sequence, dropped
+MAGIC = ord('D')
+
+
+def load_parser(db_path):
+    zephyr_base = os.environ.get('ZEPHYR_BASE')
+    if not zephyr_base:
+        sys.exit('ZEPHYR_BASE is not set (needed for the dictionary parser)')
+    sys.path.insert(0, os.path.join(zephyr_base, 'scripts', 'logging', 'dictionary'))
+
+    import dictionary_parser
+    from dictionary_parser.log_database import LogDatabase
+
+    database = LogDatabase.read_json_database(db_path)
+    if database is None:
+        sys.exit(f'cannot read log database {db_path}')
+    parser = dictionary_parser.get_parser(database)
+    if parser is None:
+        sys.exit('unsupported log database version')
+    return parser
+
+
+def split_datagram(data):
+    """Return (count, sequence, dropped, messages) or raise ValueError."""
+    if len(data) < HEADER.size + 4:
+        raise ValueError(f'short datagram ({len(data)} bytes)')
+    magic, version, count, sequence, dropped = HEADER.unpack_from(data)
+    if magic != MAGIC or version != 1:
+        raise ValueError(f'bad magic/version {magic:#x}/{version}')
+    (crc,) = struct.unpack_from('<I', data, len(data) - 4)
+    if binascii.crc32(data[:-4]) != crc:
+        raise ValueError('CRC mismatch')
+    return count, sequence, dropped, data[HEADER.size:-4]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument('dbfile', help='build/zephyr/log_dictionary.json')
+    ap.add_argument('--port', type=int, default=5006)
+    ap.add_argument('--debug', action='store_true', help='parser debug output')
+    args = ap.parse_args()
+
+    parser = load_parser(args.dbfile)
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.bind(('', args.port))
+
+    last_seq = None
+    last_dropped = None
+
+    try:
+        while True:
+            data, addr = sock.recvfrom(2048)
+
+            if data[:1] != bytes([MAGIC]):
+                sys.stdout.write(data.decode(errors='replace'))
+                sys.stdout.flush()
+                continue
+
+            try:
+                count, seq, dropped, messages = split_datagram(data)
+            except ValueError as e:
+                print(f'--- {addr[0]}: {e} ---', file=sys.stderr)
+                continue
+
+            if last_seq is not None and seq != (last_seq + 1) & 0xFFFFFFFF:
+                lost = (seq - last_seq - 1) & 0xFFFFFFFF
+                print(f'--- {lost} datagram(s) lost on the link ---')
+            if last_dropped is not None and dropped > last_dropped:
+                print(f'--- {dropped - last_dropped} message(s) dropped on target ---')
+            last_seq, last_dropped = seq, dropped
+
+            parser.parse_log_data(messages, debug=args.debug)
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,152 @@
+/*
+ * Host simulation of the UDP log backend's socket recovery after a link
+ * bounce: the re-open decision is src/net/sock_reopen.c, compiled in as
+ * is, driven the way log_backend_udp.c drives it.
+ *
+ * Build and run on the host:
+ *
+ *   cc -O2 -Isrc/net -o log_reopen_sim tools/log_reopen_sim.c \
+ *      src/net/sock_reopen.c
+ *   ./log_reopen_sim [open_fail_ms]
+ *
+ * One log message every 100 ms, each flushed on its own as when the log
+ * queue drains.  The link drops for 1 s, 20 times; a socket from before
+ * a link-down can no longer send, and socket() fails for open_fail_ms
+ * after each link-up, as it can while the stack is still settling.
+ * Prints how long after link-up the first datagram went out again.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sock_reopen.h"
+
+#define LOG_SOCK_RETRY_MS 250
+#define BOUNCES           20
+
+/* ---- simulated clock, link and sockets ---- */
+
+static int64_t now_ms;
+static uint32_t link_gen = 1;
+static bool network_ready;
+static int64_t open_fail_until;
+static int next_fd = 3;
+static uint32_t fd_gen[4096];
+static int64_t first_tx;
+
+static int64_t k_uptime_get(void) { return now_ms; }
+static uint32_t net_link_generation(void) { return link_gen; }
+
+static int sock_open(void)
+{
+    if (now_ms < open_fail_until || next_fd >= 4096) {
+        errno = ENOMEM;
+        return -1;
+    }
+    fd_gen[next_fd] = link_gen;
+    return next_fd++;
+}
+
+static void sock_close(int sock)
+{
+    (void)sock;
+}
+
+static int sock_send(int sock)
+{
+    if (!network_ready || sock < 0 || fd_gen[sock] != link_gen) {
+        errno = ENETDOWN;
+        return -1;
+    }
+    if (first_tx < 0) {
+        first_tx = now_ms;
+    }
+    return 0;
+}
+
+/* ---- log_sock_ready() in src/net/log_backend_udp.c ---- */
+
+static struct sock_reopen log_sock = SOCK_REOPEN_INIT;
+static long log_dropped, log_sent;
+
+static bool log_sock_ready(void)
+{
+    switch (sock_reopen_check(&log_sock, net_link_generation(), k_uptime_get(),
+                              LOG_SOCK_RETRY_MS)) {
+    case SOCK_REOPEN_READY:
+        return true;
+    case SOCK_REOPEN_WAIT:
+        return false;
+    case SOCK_REOPEN_OPEN:
+        break;
+    }
+
+    if (log_sock.sock >= 0) {
+        sock_close(log_sock.sock);
+        log_sock.sock = -1;
+    }
+    log_sock.sock = sock_open();
+    return log_sock.sock >= 0;
+}
+
+static void dgram_flush(void)
+{
+    if (!network_ready || !log_sock_ready()) {
+        log_dropped++;
+        return;
+    }
+    if (sock_send(log_sock.sock) < 0) {
+        log_dropped++;
+    } else {
+        log_sent++;
+    }
+}
+
+/* ---- simulation ---- */
+
+static void run_until(int64_t until)
+{
+    for (; now_ms < until; now_ms += 100) {
+        dgram_flush();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int64_t fail_ms = (argc > 1) ? atoll(argv[1]) : 0;
+    int64_t worst = 0, sum = 0;
+    int recovered = 0;
+
+    network_ready = true;
+    now_ms = 1000;
+    (void)log_sock_ready();                     /* log_backend_udp_topside_start() */
+    run_until(3000);
+
+    for (int b = 0; b < BOUNCES; b++) {
+        network_ready = false;
+        run_until(now_ms + 1000);
+
+        network_ready = true;
+        link_gen++;
+        int64_t up = now_ms;
+        open_fail_until = up + fail_ms;
+        first_tx = -1;
+        run_until(up + 10000);
+
+        if (first_tx >= 0) {
+            recovered++;
+            sum += first_tx - up;
+            worst = (first_tx - up > worst) ? first_tx - up : worst;
+        }
+    }
+
+    printf("socket() failing %lld ms after link-up: recovered %d/%d, "
+           "mean %.0f ms, worst %lld ms; %ld sent, %ld dropped\n",
+           (long long)fail_ms, recovered, BOUNCES,
+           recovered ? (double)sum / recovered : -1.0, (long long)worst,
+           log_sent, log_dropped);
+    return recovered == BOUNCES ? 0 : 1;
+}
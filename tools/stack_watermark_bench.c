@@ -0,0 +1,196 @@
+/*
+ * Host test and benchmark of the stack watermark query: the byte-by-byte
+ * scan k_thread_stack_space_get() does against the word-wise scan in
+ * src/net/stack_scan.c, which is compiled in as is.
+ *
+ * Build and run on the host:
+ *
+ *   cc -O2 -Isrc/net -o stack_watermark_bench tools/stack_watermark_bench.c \
+ *      src/net/stack_scan.c
+ *   ./stack_watermark_bench [ticks]
+ *
+ * Simulates the firmware's thread set (stack sizes from prj.conf and the
+ * K_THREAD_DEFINEs) at 1 Hz, each settling at 25-70 % of its stack as
+ * the firmware's do, with one scan per thread per tick (the resource
+ * monitor and thread telemetry share it, see stack_watermark.h).  Each
+ * tick some threads go deeper than
+ * before, writing whole frames of random bytes.  One deepening in ten
+ * leaves a large local untouched and writes only the bottom of the
+ * frame, and one tick in twenty a thread writes a single byte anywhere
+ * in its never-used region; both skip past the previous mark.  Every
+ * other stack starts 1-3 bytes off word alignment.
+ *
+ * Every answer is compared with the full scan; the run fails on the
+ * first mismatch.  Loads for the word scan are counted from its
+ * structure (bytes to alignment, words, bytes after), not instrumented.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "stack_scan.h"
+
+#define MIN(a, b)  ((a) < (b) ? (a) : (b))
+#define MAX(a, b)  ((a) > (b) ? (a) : (b))
+
+static const size_t stack_sizes[] = {
+    4096, 2048, 3072, 2048, 2048, 1024, 1536, 2048, 4096, 2048,
+    1024, 1024, 3072, 2048, 320, 1024, 2048, 1536, 1024, 2048,
+};
+#define THREADS (sizeof(stack_sizes) / sizeof(stack_sizes[0]))
+
+static uint8_t *stacks[THREADS];
+static size_t depth[THREADS];            /* bytes used from the top */
+static size_t peak[THREADS];             /* deepest the thread will go */
+static size_t loads;                     /* memory reads, any width */
+
+/* What k_thread_stack_space_get() does */
+static size_t full_scan(const uint8_t *base, size_t size)
+{
+    size_t unused = 0;
+
+    for (size_t i = 0; i < size; i++) {
+        if (base[i] == STACK_FILL_BYTE) {
+            unused++;
+        } else {
+            break;
+        }
+    }
+    loads += MIN(unused + 1, size);
+    return unused;
+}
+
+/* Memory reads stack_scan_unused() made to return `unused` */
+static size_t word_scan_loads(const uint8_t *base, size_t size, size_t unused)
+{
+    size_t head = MIN((4 - ((uintptr_t)base & 3U)) & 3U, size);
+
+    if (unused < head) {
+        return unused + 1;                       /* stopped before alignment */
+    }
+    size_t i = head + (unused - head) / 4 * 4;   /* end of the all-fill words */
+    size_t n = head + (unused - head) / 4;
+
+    if (i + 4 <= size) {
+        n++;                                     /* the word that was not all fill */
+    }
+    return n + (unused - i) + (unused < size);   /* bytes after it */
+}
+
+/* ---- simulation ---- */
+
+static uint8_t dirty_byte(void)
+{
+    uint8_t b = (uint8_t)rand();
+    return (b == STACK_FILL_BYTE) ? 0 : b;
+}
+
+static void deepen(size_t t)
+{
+    size_t size = stack_sizes[t];
+    size_t room = peak[t] - MIN(depth[t], peak[t]);
+    if (room < 16) {
+        return;
+    }
+    size_t grow = 8 + (size_t)rand() % MIN(room - 8, 256);
+    uint8_t *top = stacks[t] + size - depth[t];
+    uint8_t *frame = top - grow;
+
+    if (rand() % 10 == 0 && grow > 96) {
+        /* Big local left untouched: only the bottom of the frame is written */
+        for (size_t i = 0; i < 16; i++) {
+            frame[i] = dirty_byte();
+        }
+    } else {
+        for (size_t i = 0; i < grow; i++) {
+            frame[i] = dirty_byte();
+        }
+    }
+    depth[t] += grow;
+}
+
+/* One byte somewhere in the never-used region, far past the mark */
+static void stray_write(size_t t, size_t unused)
+{
+    if (unused > 1) {
+        stacks[t][(size_t)rand() % unused] = dirty_byte();
+    }
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+    long ticks = (argc > 1) ? atol(argv[1]) : 600;
+    size_t full_loads = 0, word_loads = 0;
+    double t_full = 0, t_word = 0;
+    long queries = 0, skips = 0;
+
+    srand(1);
+    for (size_t t = 0; t < THREADS; t++) {
+        uint8_t *mem = aligned_alloc(8, stack_sizes[t] + 8);
+
+        stacks[t] = mem + ((t % 2) ? 1 + t % 3 : 0);
+        memset(stacks[t], STACK_FILL_BYTE, stack_sizes[t]);
+        depth[t] = 64;                            /* initial frame */
+        peak[t] = MAX(stack_sizes[t] * (25 + (size_t)rand() % 46) / 100, 128);
+        memset(stacks[t] + stack_sizes[t] - 64, 0, 64);
+    }
+
+    for (long tick = 0; tick < ticks; tick++) {
+        for (size_t t = 0; t < THREADS; t++) {
+            /* Growth slows down as the threads reach their deepest paths */
+            if (rand() % (int)(2 + tick / 20) == 0) {
+                deepen(t);
+            }
+            if (rand() % 20 == 0) {
+                size_t before = full_scan(stacks[t], stack_sizes[t]);
+                stray_write(t, before);
+                skips++;
+            }
+        }
+
+        size_t full[THREADS], word[THREADS];
+
+        loads = 0;
+        double t0 = now_s();
+        for (size_t t = 0; t < THREADS; t++) {
+            full[t] = full_scan(stacks[t], stack_sizes[t]);
+        }
+        t_full += now_s() - t0;
+        full_loads += loads;
+
+        t0 = now_s();
+        for (size_t t = 0; t < THREADS; t++) {
+            word[t] = stack_scan_unused(stacks[t], stack_sizes[t]);
+        }
+        t_word += now_s() - t0;
+
+        for (size_t t = 0; t < THREADS; t++) {
+            if (word[t] != full[t]) {
+                printf("tick %ld thread %zu: %zu B unused, full scan %zu B\n",
+                       tick, t, word[t], full[t]);
+                return 1;
+            }
+            word_loads += word_scan_loads(stacks[t], stack_sizes[t], word[t]);
+        }
+        queries += THREADS;
+    }
+
+    printf("ticks            %ld x %zu threads\n", ticks, THREADS);
+    printf("full scan        %8.0f loads/tick %8.0f ns/tick\n",
+           (double)full_loads / ticks, t_full / ticks * 1e9);
+    printf("word scan        %8.0f loads/tick %8.0f ns/tick\n",
+           (double)word_loads / ticks, t_word / ticks * 1e9);
+    printf("matched          %ld of %ld queries, %ld writes past the mark\n",
+           queries, queries, skips);
+    return 0;
+}
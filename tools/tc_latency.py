@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""
+Measure control telemetry latency with and without log and telemetry floods.
+
+Listens for multiplexed telemetry (port 5009) and UDP logs (port 5006)
+at the same time.  For every datagram that carries a control record the
+one-way delay is estimated as host arrival time minus the MCU tick time;
+the unknown clock offset is removed by subtracting the smallest delay
+seen in a sliding window, so the numbers are queueing delay on top of
+the best case.
+
+The log flood comes from a native_sim build with
+CONFIG_K2_SIM_LOG_FLOOD=y, which alternates quiet and flood periods on
+its own.  With --telem-flood N the script also floods the telemetry
+class: it subscribes the listening socket to the control channel
+(src/net/telem_subscribe.h) and N further sockets to every other channel
+at the shortest interval the ROV grants, toggling those N subscriptions
+every --telem-period seconds.  Each sample is filed by the log and
+telemetry bytes received in the surrounding second, so one run gives
+quiet, log, telem and both.
+
+Compare a build with CONFIG_NET_TC_TX_COUNT=3 (the default) against one
+with 1.  With three classes control latency should not move under either
+flood; with one it rises under both.
+
+    python3 tools/tc_latency.py [--seconds 60] [--flood-bps 20000]
+    python3 tools/tc_latency.py --telem-flood 3 [--telem-period 7]
+"""
+
+import argparse
+import collections
+import select
+import socket
+import sys
+import time
+
+from telem_mux_decode import (CH_CONTROL, CH_IMU, CH_NET, CH_RESOURCE, CH_THREADS,
+                              decode_datagram)
+from telem_subscribe import SUBSCRIBE, UNSUBSCRIBE, pack, parse_ack
+
+WINDOW = 500          # samples in the offset-tracking window
+FLOOD_CHANNELS = (CH_IMU, CH_RESOURCE, CH_NET, CH_THREADS)
+FLOOD_PERIOD_MS = 20  # one base tick; the ROV clamps walk-heavy channels
+LEASE_S = 10
+BUCKETS = ('quiet', 'log', 'telem', 'both')
+
+
+def percentile(values, pct):
+    if not values:
+        return float('nan')
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * pct / 100))]
+
+
+def summary(name, values):
+    if not values:
+        return f'{name:6s} no samples'
+    return (f'{name:6s} n={len(values):6d} p50={percentile(values, 50):7.2f} '
+            f'p99={percentile(values, 99):7.2f} max={max(values):7.2f} ms')
+
+
+def bind(port):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.bind(('', port))
+    return sock
+
+
+def bytes_near(arrivals, t):
+    return sum(n for a, n in arrivals if t - 0.5 <= a <= t + 0.5)
+
+
+class TelemFlood:
+    """N subscriber sockets pulling every non-control channel, toggled on a period."""
+
+    def __init__(self, target, count, period_s):
+        self.dest = target
+        self.period_s = period_s
+        self.socks = [bind(0) for _ in range(count)]
+        self.on = False
+        self.toggle_at = time.monotonic() + period_s
+        self.renew_at = 0.0
+
+    def subscribe(self):
+        for sock in self.socks:
+            for channel in FLOOD_CHANNELS:
+                sock.sendto(pack(SUBSCRIBE, channel, FLOOD_PERIOD_MS, LEASE_S), self.dest)
+
+    def unsubscribe(self):
+        for sock in self.socks:
+            sock.sendto(pack(UNSUBSCRIBE, 0), self.dest)
+
+    def poll(self, now):
+        if now >= self.toggle_at:
+            self.on = not self.on
+            self.toggle_at = now + self.period_s
+            self.renew_at = now
+            if not self.on:
+                self.unsubscribe()
+        if self.on and now >= self.renew_at:
+            self.subscribe()
+            self.renew_at = now + LEASE_S / 3
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument('--telem-port', type=int, default=5009)
+    ap.add_argument('--log-port', type=int, default=5006)
+    ap.add_argument('--seconds', type=float, default=60.0)
+    ap.add_argument('--flood-bps', type=int, default=20000,
+                    help='log or telemetry bytes/s above which a sample counts as flooded')
+    ap.add_argument('--target', default='10.77.0.2', help='ROV address for subscriptions')
+    ap.add_argument('--sub-port', type=int, default=5013)
+    ap.add_argument('--telem-flood', type=int, default=0, metavar='N',
+                    help='flood the telemetry class from N subscriber sockets (1-3)')
+    ap.add_argument('--telem-period', type=float, default=7.0,
+                    help='telemetry flood on/off period in seconds')
+    args = ap.parse_args()
+    if not 0 <= args.telem_flood <= 3:
+        ap.error('--telem-flood must be 0..3 (the ROV takes 4 subscribers, one is ours)')
+
+    telem = bind(args.telem_port)
+    logs = bind(args.log_port)
+    dest = (args.target, args.sub_port)
+    flood = TelemFlood(dest, args.telem_flood, args.telem_period) if args.telem_flood else None
+    control_renew_at = 0.0
+
+    log_arrivals = collections.deque()   # (arrival_s, bytes)
+    telem_arrivals = collections.deque()
+    pending = []                         # (arrival_s, raw delay ms) awaiting flood context
+    offsets = collections.deque(maxlen=WINDOW)
+    results = {name: [] for name in BUCKETS}
+    end = time.monotonic() + args.seconds
+    inputs = [telem, logs] + (flood.socks if flood else [])
+
+    while time.monotonic() < end:
+        now = time.monotonic()
+        if flood:
+            # Any subscriber stops the broadcast, so the listener subscribes too
+            if now >= control_renew_at:
+                telem.sendto(pack(SUBSCRIBE, CH_CONTROL, 0, LEASE_S), dest)
+                control_renew_at = now + LEASE_S / 3
+            flood.poll(now)
+
+        ready, _, _ = select.select(inputs, [], [], 0.5)
+        for sock in ready:
+            data, _ = sock.recvfrom(2048)
+            now = time.monotonic()
+            if sock is logs:
+                log_arrivals.append((now, len(data)))
+                continue
+            if sock is not telem:
+                telem_arrivals.append((now, len(data)))
+                continue
+            if parse_ack(data):
+                continue
+            try:
+                _, tick_ms, _, records = decode_datagram(data)
+            except ValueError as e:
+                print(f'bad datagram: {e}', file=sys.stderr)
+                continue
+            if any(ch == CH_CONTROL for ch, _ in records):
+                raw = now * 1000 - tick_ms
+                offsets.append(raw)
+                pending.append((now, raw - min(offsets)))
+
+        # Classify samples once the second after them has been seen
+        now = time.monotonic()
+        for arrivals in (log_arrivals, telem_arrivals):
+            while arrivals and arrivals[0][0] < now - 2.0:
+                arrivals.popleft()
+        while pending and pending[0][0] < now - 0.5:
+            t, delay = pending.pop(0)
+            log_flood = bytes_near(log_arrivals, t) > args.flood_bps
+            telem_flood = bytes_near(telem_arrivals, t) > args.flood_bps
+            results[BUCKETS[log_flood + 2 * telem_flood]].append(delay)
+
+    if flood:
+        flood.unsubscribe()
+        telem.sendto(pack(UNSUBSCRIBE, 0), dest)
+
+    for name in BUCKETS:
+        print(summary(name, results[name]))
+
+
+if __name__ == '__main__':
+    main()
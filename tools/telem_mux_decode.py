@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+"""
+Decode K2 multiplexed telemetry from UDP port 5009.
+
+Each datagram carries the records sampled on one telemetry tick
+(src/net/telemetry.h).  The IMU, control, resource and per-thread
+records are decoded and printed with the tick time; CRC failures and sequence gaps
+are reported.
+
+    python3 tools/telem_mux_decode.py [--port 5009] [--channel imu ...]
+"""
+
+import argparse
+import binascii
+import socket
+import struct
+import sys
+import time
+
+from imu_telem_decode import decode_binary as decode_imu, format_rejects
+
+MUX_HEADER = struct.Struct('<BBHIIq')   # version, count, length, sequence, tick_ms, tick_topside_us
+RECORD_HEADER = struct.Struct('<BxH')   # channel, pad, len
+
+CH_IMU, CH_CONTROL, CH_RESOURCE, CH_STREAM, CH_NET, CH_THREADS = 1, 2, 3, 4, 5, 6
+CHANNEL_NAMES = {CH_IMU: 'imu', CH_CONTROL: 'control', CH_RESOURCE: 'resource',
+                 CH_STREAM: 'stream', CH_NET: 'net', CH_THREADS: 'threads'}
+
+CONTROL_ECHO = struct.Struct('>IQII')   # cmd_sequence, cmd_topside_us, queue_us, age_us
+CONTROL_FAILSAFE = struct.Struct('>BxQ')   # stage, since_us (MCU uptime)
+CONTROL_LEN = 4 + 19 * 4 + 2 + CONTROL_ECHO.size + CONTROL_FAILSAFE.size + 4
+FAILSAFE_STAGES = ('none', 'hold', 'attitude', 'ramp', 'stopped')
+RESOURCE = struct.Struct('>IIBBHHBBII')
+RESOURCE_NET = struct.Struct('>6I8H')    # net_stats counters, pool (min_free, total) x 4
+RESOURCE_LEN = RESOURCE.size + RESOURCE_NET.size + 4
+STREAM_HEADER = struct.Struct('<IIHBxI')   # first_cycle, first_ms, count, decimation, dropped
+STREAM_SAMPLE = struct.Struct('<18f')
+NET_HEADER = struct.Struct('<BBxx')       # ports, counters per port
+NET_COUNTER_NAMES = ('rx', 'rx_err', 'crc', 'size', 'type', 'rejected', 'tx', 'tx_err',
+                     'source')
+THREADS_HEADER = struct.Struct('<IBBBB')  # cycles_hz, threads, page, pages, count
+THREAD_ENTRY = struct.Struct('<16sbBxxIIII')   # name, prio, flags, cycles, window_us, stack
+THREAD_FIRST = 0x01
+AXES = ('surge', 'sway', 'heave', 'roll', 'pitch', 'yaw')
+
+
+def check_crc_be(payload):
+    (crc,) = struct.unpack_from('>I', payload, len(payload) - 4)
+    if binascii.crc32(payload[:-4]) != crc:
+        raise ValueError('record CRC mismatch')
+
+
+def format_imu(payload):
+    if payload[:1] == b'{':
+        return payload.decode()
+    _, sample_ms, flags, v = decode_imu(payload)
+    return (f'sample={sample_ms} ms fresh={flags & 1} '
+            f'ypr=({v["yaw"]:.2f} {v["pitch"]:.2f} {v["roll"]:.2f}) '
+            f'accel=({v["ax"]:.3f} {v["ay"]:.3f} {v["az"]:.3f})' + format_rejects(v))
+
+
+def format_control(payload):
+    if len(payload) != CONTROL_LEN:
+        raise ValueError(f'control record is {len(payload)} bytes')
+    check_crc_be(payload)
+    f = struct.unpack_from('<19f', payload, 4)
+    sp, out, err = f[0:6], f[6:12], f[12:18]
+    cmd_seq, topside_us, queue_us, age_us = CONTROL_ECHO.unpack_from(payload, 4 + 19 * 4 + 2)
+    stage, since_us = CONTROL_FAILSAFE.unpack_from(payload, 4 + 19 * 4 + 2 + CONTROL_ECHO.size)
+    text = ' '.join(f'{a}={s:.2f}/{o:+.2f}/{e:+.2f}'
+                    for a, s, o, e in zip(AXES, sp, out, err))
+    text += f' | cmd #{cmd_seq} queue={queue_us / 1000:.1f} ms'
+    if topside_us:
+        # Valid when the v2 sender stamps with this host's wall clock
+        rtt_us = time.time_ns() // 1000 - topside_us - queue_us - age_us
+        text += f' rtt={rtt_us / 1000:.1f} ms'
+    if stage:
+        name = FAILSAFE_STAGES[stage] if stage < len(FAILSAFE_STAGES) else stage
+        text += f' | FAILSAFE {name} since {since_us / 1e6:.3f} s'
+    return text
+
+
+def format_resource(payload):
+    if len(payload) != RESOURCE_LEN:
+        raise ValueError(f'resource record is {len(payload)} bytes')
+    check_crc_be(payload)
+    (_, uptime, cpu, ram_pct, ram_free, ram_total,
+     threads, _, rx, rx_err) = RESOURCE.unpack_from(payload)
+    (ip_drop, udp_drop, chksum, proc_err, eth_rx_err, eth_tx_err,
+     *pools) = RESOURCE_NET.unpack_from(payload, RESOURCE.size)
+    pool_text = ' '.join(f'{name}={free}/{total}' for name, free, total in
+                         zip(('pkt_rx', 'pkt_tx', 'buf_rx', 'buf_tx'), pools[0::2], pools[1::2]))
+    return (f'uptime={uptime} ms cpu={cpu}% ram={ram_pct}% '
+            f'({ram_free}/{ram_total} KB free) threads={threads} '
+            f'udp_rx={rx} err={rx_err} | drop ip={ip_drop} udp={udp_drop} '
+            f'chksum={chksum} proc={proc_err} eth_err={eth_rx_err}/{eth_tx_err} '
+            f'| min free {pool_text}')
+
+
+def format_stream(payload):
+    first, first_ms, count, decimation, dropped = STREAM_HEADER.unpack_from(payload)
+    if len(payload) != STREAM_HEADER.size + count * STREAM_SAMPLE.size:
+        raise ValueError(f'stream record is {len(payload)} bytes for {count} samples')
+    lines = [f'cycles {first}+{count}x{decimation} from {first_ms} ms, dropped {dropped}']
+    for n in range(count):
+        f = STREAM_SAMPLE.unpack_from(payload, STREAM_HEADER.size + n * STREAM_SAMPLE.size)
+        lines.append(f'    [{first + n * decimation}] ' +
+                     ' '.join(f'{a}={o:+.3f}/{e:+.3f}'
+                              for a, o, e in zip(AXES, f[6:12], f[12:18])))
+    return '\n'.join(lines)
+
+
+def format_net(payload):
+    ports, counters = NET_HEADER.unpack_from(payload)
+    entry = struct.Struct(f'<Hxx{counters}II')
+    if len(payload) != NET_HEADER.size + ports * entry.size:
+        raise ValueError(f'net record is {len(payload)} bytes for {ports} ports')
+    lines = []
+    for n in range(ports):
+        port, *counts, age_ms = entry.unpack_from(payload, NET_HEADER.size + n * entry.size)
+        # Older firmware may know fewer counters; name the ones we know
+        text = ' '.join(f'{name}={c}' for name, c in zip(NET_COUNTER_NAMES, counts) if c)
+        age = 'never' if age_ms == 0xFFFFFFFF else f'{age_ms} ms ago'
+        lines.append(f'    {port:5d}: last rx {age} {text}')
+    return '\n'.join(['ports'] + lines)
+
+
+def format_threads(payload):
+    cycles_hz, threads, page, pages, count = THREADS_HEADER.unpack_from(payload)
+    if len(payload) != THREADS_HEADER.size + count * THREAD_ENTRY.size:
+        raise ValueError(f'threads record is {len(payload)} bytes for {count} entries')
+    lines = [f'{threads} threads, page {page + 1}/{pages}']
+    for n in range(count):
+        (name, prio, flags, cycles, window_us,
+         size, used) = THREAD_ENTRY.unpack_from(payload, THREADS_HEADER.size + n * THREAD_ENTRY.size)
+        name = name.rstrip(b'\0').decode(errors='replace') or '?'
+        if flags & THREAD_FIRST or not window_us:
+            load = '    -'
+        else:
+            load = f'{100.0 * cycles / (cycles_hz * window_us / 1e6):5.1f}'
+        pct = f'{100.0 * used / size:3.0f}%' if size else '   -'
+        lines.append(f'    {name:16s} prio {prio:3d} cpu {load} % '
+                     f'stack {used:6d}/{size:<6d} {pct}')
+    return '\n'.join(lines)
+
+
+FORMATTERS = {CH_IMU: format_imu, CH_CONTROL: format_control,
+              CH_RESOURCE: format_resource, CH_STREAM: format_stream,
+              CH_NET: format_net, CH_THREADS: format_threads}
+
+
+def decode_datagram(data):
+    """Return (sequence, tick_ms, tick_topside_us, [(channel, payload), ...])
+    or raise ValueError.  tick_topside_us is 0 until time sync converges."""
+    if len(data) < MUX_HEADER.size + 4:
+        raise ValueError(f'short datagram ({len(data)} bytes)')
+    version, count, length, sequence, tick_ms, topside_us = MUX_HEADER.unpack_from(data)
+    if version != 2:
+        raise ValueError(f'unknown version {version}')
+    if length != len(data):
+        raise ValueError(f'length field {length} != {len(data)}')
+    (crc,) = struct.unpack_from('<I', data, length - 4)
+    if binascii.crc32(data[:length - 4]) != crc:
+        raise ValueError('CRC mismatch')
+
+    records = []
+    off = MUX_HEADER.size
+    for _ in range(count):
+        channel, rec_len = RECORD_HEADER.unpack_from(data, off)
+        off += RECORD_HEADER.size
+        if off + rec_len > length - 4:
+            raise ValueError('record overruns datagram')
+        records.append((channel, data[off:off + rec_len]))
+        off += rec_len
+    return sequence, tick_ms, topside_us, records
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument('--port', type=int, default=5009)
+    ap.add_argument('--channel', action='append', choices=CHANNEL_NAMES.values(),
+                    help='only print these channels (repeatable)')
+    args = ap.parse_args()
+    wanted = set(args.channel or CHANNEL_NAMES.values())
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.bind(('', args.port))
+
+    last_seq = None
+    bad = 0
+
+    try:
+        while True:
+            data, addr = sock.recvfrom(2048)
+            try:
+                seq, tick_ms, topside_us, records = decode_datagram(data)
+            except ValueError as e:
+                bad += 1
+                print(f'{addr[0]}: {e}', file=sys.stderr)
+                continue
+
+            if last_seq is not None and seq < last_seq:
+                print(f'sequence went back {last_seq} -> {seq} (reboot?)',
+                      file=sys.stderr)
+            last_seq = seq
+
+            for channel, payload in records:
+                name = CHANNEL_NAMES.get(channel, f'ch{channel}')
+                if name not in wanted:
+                    continue
+                fmt = FORMATTERS.get(channel)
+                try:
+                    text = fmt(payload) if fmt else payload.hex()
+                except ValueError as e:
+                    bad += 1
+                    text = f'<{e}>'
+                stamp = (time.strftime('%H:%M:%S', time.localtime(topside_us / 1e6)) +
+                         f'.{topside_us % 1000000:06d}') if topside_us else f'{tick_ms:15d}'
+                print(f'{stamp} #{seq:<8d} {name:8s} {text}')
+    except KeyboardInterrupt:
+        print(f'\nrejected {bad}', file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
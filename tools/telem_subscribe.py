@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""
+Subscribe to K2 telemetry and print it (UDP 5013 subscriptions).
+
+Sends SUBSCRIBE for each requested channel (src/net/telem_subscribe.h)
+from one local socket, renews the lease at a third of its length, and
+decodes the multiplexed datagrams the ROV then sends to that socket
+unicast.  Unsubscribes on Ctrl-C; if the tool dies instead the lease
+simply runs out.
+
+    python3 tools/telem_subscribe.py --channel imu:100 --channel resource
+    python3 tools/telem_subscribe.py --channel all
+"""
+
+import argparse
+import binascii
+import socket
+import struct
+import sys
+import time
+
+from telem_mux_decode import CHANNEL_NAMES, FORMATTERS, decode_datagram
+
+PACKET = struct.Struct('<BBHHH')   # type, channel, period_ms, port, lease_s
+SUBSCRIBE, UNSUBSCRIBE, ACK = 1, 2, 3
+CHANNEL_IDS = {name: cid for cid, name in CHANNEL_NAMES.items()}
+CHANNEL_IDS['all'] = 0
+
+
+def pack(ptype, channel, period_ms=0, lease_s=0):
+    body = PACKET.pack(ptype, channel, period_ms, 0, lease_s)
+    return body + struct.pack('<I', binascii.crc32(body))
+
+
+def parse_ack(data):
+    if len(data) != PACKET.size + 4:
+        return None
+    (crc,) = struct.unpack_from('<I', data, PACKET.size)
+    if binascii.crc32(data[:PACKET.size]) != crc:
+        return None
+    ptype, channel, period_ms, port, lease_s = PACKET.unpack_from(data)
+    return (channel, period_ms, port, lease_s) if ptype == ACK else None
+
+
+def parse_channel(text):
+    name, _, period = text.partition(':')
+    if name not in CHANNEL_IDS:
+        raise argparse.ArgumentTypeError(f'unknown channel {name!r}')
+    return CHANNEL_IDS[name], int(period or 0)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument('--target', default='10.77.0.2')
+    ap.add_argument('--port', type=int, default=5013)
+    ap.add_argument('--channel', type=parse_channel, action='append', required=True,
+                    metavar='NAME[:PERIOD_MS]',
+                    help='channel to subscribe to, or "all" (repeatable)')
+    ap.add_argument('--lease', type=int, default=10, help='lease in seconds')
+    args = ap.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(('', 0))
+    sock.settimeout(0.2)
+    dest = (args.target, args.port)
+
+    def subscribe_all():
+        for channel, period_ms in args.channel:
+            sock.sendto(pack(SUBSCRIBE, channel, period_ms, args.lease), dest)
+
+    print(f'listening on port {sock.getsockname()[1]}', file=sys.stderr)
+    subscribe_all()
+    renew_at = time.monotonic() + args.lease / 3
+
+    try:
+        while True:
+            if time.monotonic() >= renew_at:
+                subscribe_all()
+                renew_at = time.monotonic() + args.lease / 3
+            try:
+                data, _ = sock.recvfrom(2048)
+            except socket.timeout:
+                continue
+
+            ack = parse_ack(data)
+            if ack:
+                channel, period_ms, port, lease_s = ack
+                name = CHANNEL_NAMES.get(channel, 'all' if channel == 0 else f'ch{channel}')
+                state = f'{period_ms} ms, lease {lease_s} s' if lease_s else 'refused'
+                print(f'subscription {name}: {state}', file=sys.stderr)
+                continue
+
+            try:
+                seq, tick_ms, _, records = decode_datagram(data)
+            except ValueError as e:
+                print(f'bad datagram: {e}', file=sys.stderr)
+                continue
+            for channel, payload in records:
+                fmt = FORMATTERS.get(channel)
+                try:
+                    text = fmt(payload) if fmt else payload.hex()
+                except ValueError as e:
+                    text = f'<{e}>'
+                name = CHANNEL_NAMES.get(channel, f'ch{channel}')
+                print(f'{tick_ms:10d} #{seq:<8d} {name:8s} {text}')
+    except KeyboardInterrupt:
+        sock.sendto(pack(UNSUBSCRIBE, 0), dest)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""
+Reference time-sync client for the K2 time sync service (UDP 5011).
+
+Runs the REQUEST / RESPONSE / REPORT exchange described in
+src/net/time_sync.h against the ROV using this host's wall clock
+(Unix time, microseconds) as topside time.  Prints the offset, round
+trip and a least-squares drift estimate over the lowest-delay samples,
+so the MCU-side model can be checked against an independent one.
+
+    python3 tools/time_sync_client.py [--target 10.77.0.2] [--rate 1] [--count 0]
+"""
+
+import argparse
+import binascii
+import socket
+import struct
+import sys
+import time
+
+PACKET = struct.Struct('<BBxxIqqqq')   # type, flags, sequence, t1..t4
+REQUEST, RESPONSE, REPORT = 1, 2, 3
+FLAG_SYNCED = 0x01
+WINDOW = 8
+
+
+def now_us():
+    return time.time_ns() // 1000
+
+
+def pack(ptype, seq, t1=0, t2=0, t3=0, t4=0):
+    body = PACKET.pack(ptype, 0, seq, t1, t2, t3, t4)
+    return body + struct.pack('<I', binascii.crc32(body))
+
+
+def unpack(data):
+    if len(data) != PACKET.size + 4:
+        raise ValueError(f'bad length {len(data)}')
+    (crc,) = struct.unpack_from('<I', data, PACKET.size)
+    if binascii.crc32(data[:PACKET.size]) != crc:
+        raise ValueError('CRC mismatch')
+    return PACKET.unpack_from(data)
+
+
+def drift_ppm(points):
+    """Least-squares slope of offset against MCU time, in ppm."""
+    if len(points) < 3:
+        return None
+    n = len(points)
+    mx = sum(p[0] for p in points) / n
+    my = sum(p[1] for p in points) / n
+    sxx = sum((p[0] - mx) ** 2 for p in points)
+    if sxx == 0:
+        return None
+    sxy = sum((p[0] - mx) * (p[1] - my) for p in points)
+    return sxy / sxx * 1e6
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument('--target', default='10.77.0.2')
+    ap.add_argument('--port', type=int, default=5011)
+    ap.add_argument('--rate', type=float, default=1.0, help='exchanges per second')
+    ap.add_argument('--count', type=int, default=0, help='stop after N (0 = forever)')
+    args = ap.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.settimeout(0.5)
+    dest = (args.target, args.port)
+
+    window = []        # recent (mcu_mid, offset, delay)
+    filtered = []      # lowest-delay pick per exchange, for the drift fit
+    seq = 0
+
+    print(f'{"seq":>6} {"offset_us":>18} {"delay_us":>9} {"best_us":>9} '
+          f'{"drift_ppm":>10} mcu')
+    try:
+        while args.count == 0 or seq < args.count:
+            seq += 1
+            t1 = now_us()
+            sock.sendto(pack(REQUEST, seq, t1), dest)
+            try:
+                data = sock.recv(256)
+                t4 = now_us()
+            except socket.timeout:
+                print(f'{seq:6d} timeout', file=sys.stderr)
+                continue
+            try:
+                ptype, flags, rseq, rt1, t2, t3, _ = unpack(data)
+            except ValueError as e:
+                print(f'{seq:6d} {e}', file=sys.stderr)
+                continue
+            if ptype != RESPONSE or rseq != seq or rt1 != t1:
+                print(f'{seq:6d} stale response #{rseq}', file=sys.stderr)
+                continue
+
+            sock.sendto(pack(REPORT, seq, t1, t2, t3, t4), dest)
+
+            offset = ((t1 - t2) + (t4 - t3)) // 2
+            delay = (t4 - t1) - (t3 - t2)
+            window = (window + [(t2 + (t3 - t2) // 2, offset, delay)])[-WINDOW:]
+            best = min(window, key=lambda s: s[2])
+            if not filtered or filtered[-1] != best:
+                filtered = (filtered + [best])[-120:]
+            drift = drift_ppm([(p[0], p[1]) for p in filtered])
+
+            print(f'{seq:6d} {offset:18d} {delay:9d} {best[1]:9d} '
+                  f'{"" if drift is None else f"{drift:10.2f}":>10} '
+                  f'{"synced" if flags & FLAG_SYNCED else "unsynced"}')
+
+            time.sleep(max(0.0, 1.0 / args.rate - (now_us() - t1) / 1e6))
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
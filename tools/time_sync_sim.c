@@ -0,0 +1,83 @@
+/*
+ * Host simulation of the MCU time sync model, src/net/time_sync_model.c
+ * compiled in as is: lowest-delay clock filter over the last TS_WINDOW
+ * exchanges feeding a PI model of offset and frequency skew.
+ *
+ * Build and run on the host:
+ *
+ *   cc -O2 -Isrc/net -o time_sync_sim tools/time_sync_sim.c \
+ *      src/net/time_sync_model.c -lm
+ *   ./time_sync_sim [skew_ppm] [seconds] [seed]
+ *
+ * Topside polls at 1 Hz as tools/time_sync_client.py does.  The topside
+ * clock runs skew_ppm fast relative to the MCU; each direction of the
+ * link takes an independent 100-500 us, and one exchange in ten has a
+ * 5 ms queueing spike on the uplink.  After every REPORT the model
+ * converts "now" and the error against the true topside time is
+ * recorded.  Prints the worst error after the first minute, the skew
+ * estimate, and the error after 30 s of holdover with no exchanges.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "time_sync_model.h"
+
+static struct time_sync_model ts;
+static double skew;
+static const int64_t epoch_us = 1700000000000000LL;
+
+static int64_t true_topside(int64_t mcu_us)
+{
+    return epoch_us + (int64_t)llround((double)mcu_us * (1.0 + skew));
+}
+
+static int64_t link_us(void)
+{
+    return 100 + rand() % 401;
+}
+
+int main(int argc, char **argv)
+{
+    double skew_ppm = (argc > 1) ? atof(argv[1]) : 50.0;
+    long seconds = (argc > 2) ? atol(argv[2]) : 600;
+    srand((argc > 3) ? (unsigned)atoi(argv[3]) : 1);
+    skew = skew_ppm * 1e-6;
+
+    double max_err = 0.0, sum_err = 0.0;
+    long counted = 0;
+    int64_t mcu = 5000000;
+
+    for (long i = 0; i < seconds; i++) {
+        int64_t up = link_us() + ((rand() % 10 == 0) ? 5000 : 0);
+        int64_t down = link_us();
+
+        int64_t t1 = true_topside(mcu);
+        int64_t t2 = mcu + up;
+        int64_t t3 = t2 + 20;                     /* MCU turnaround */
+        int64_t t4 = true_topside(t3 + down);
+        if (time_sync_model_add(&ts, t1, t2, t3, t4) == TIME_SYNC_MODEL_STEPPED) {
+            printf("step at %ld s, re-seeding\n", i);
+        }
+
+        int64_t now = t3 + down + up;             /* REPORT arrives */
+        double err = fabs((double)(time_sync_model_to_topside(&ts, now) - true_topside(now)));
+        if (i >= 60) {
+            max_err = fmax(max_err, err);
+            sum_err += err;
+            counted++;
+        }
+        mcu += 1000000;
+    }
+
+    int64_t later = mcu + 30000000;
+    double holdover = (double)(time_sync_model_to_topside(&ts, later) - true_topside(later));
+
+    printf("skew             %.1f ppm true, %.1f ppm estimated\n", skew_ppm, ts.skew * 1e6);
+    printf("error after 60 s max %.0f us, mean %.0f us over %ld exchanges\n",
+           max_err, counted ? sum_err / counted : 0.0, counted);
+    printf("30 s holdover    %+.0f us\n", holdover);
+    return 0;
+}
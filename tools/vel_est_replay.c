@@ -0,0 +1,253 @@
+/*
+ * Offline check of src/nav/velocity_estimator.c against the old leaky
+ * accelerometer integrator.
+ *
+ * Build and run on the host:
+ *
+ *   cc -O2 -Isrc -o vel_est_replay tools/vel_est_replay.c \
+ *      src/nav/velocity_estimator.c -lm
+ *   ./vel_est_replay              # built-in synthetic plants
+ *   ./vel_est_replay log.csv      # replay a recording
+ *
+ * CSV columns (header line optional, '#' lines ignored):
+ *   t_s, accel_mps2, command [, v_true_mps [, v_aid_mps]]
+ * Empty or NaN fields mean "not available".  With v_true present the RMS
+ * and max error of both estimators are reported; otherwise the estimated
+ * speeds are printed per row.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nav/velocity_estimator.h"
+
+#define DT           0.02f
+#define SPEED_DECAY  0.995f    /* the integrator this estimator replaced */
+#define AID_SIGMA    0.02f
+
+struct err_acc {
+    double sum_sq;
+    double max_abs;
+    long n;
+};
+
+static void err_add(struct err_acc *a, float est, float truth)
+{
+    double e = fabs((double)est - (double)truth);
+    a->sum_sq += e * e;
+    if (e > a->max_abs) {
+        a->max_abs = e;
+    }
+    a->n++;
+}
+
+static void err_print(const char *name, const struct err_acc *a)
+{
+    printf("  %-8s rms %.3f m/s  max %.3f m/s\n", name,
+           a->n ? sqrt(a->sum_sq / a->n) : 0.0, a->max_abs);
+}
+
+/* Deterministic Gaussian noise so runs are repeatable */
+static float noise(float sigma)
+{
+    static unsigned long s = 12345;
+    double u1, u2;
+
+    s = s * 6364136223846793005UL + 1442695040888963407UL;
+    u1 = ((s >> 11) + 1.0) / 9007199254740993.0;
+    s = s * 6364136223846793005UL + 1442695040888963407UL;
+    u2 = (s >> 11) / 9007199254740992.0;
+    return (float)(sigma * sqrt(-2.0 * log(u1)) * cos(6.283185307 * u2));
+}
+
+/*
+ * The synthetic truth is not the estimator's model.  Each plant has its
+ * own thrust and drag (scales on the model's values), a first-order lag
+ * between command and thrust, a water current the drag acts against,
+ * and a constant accelerometer bias.  The IMU sees over-ground
+ * acceleration; the truth is over-ground velocity.
+ */
+struct plant {
+    float thrust_scale;    /* true thrust / modelled thrust */
+    float drag_scale;      /* true drag / modelled drag */
+    float lag_s;           /* thrust lag time constant, 0 = none */
+    float current_mps;     /* water current along the axis */
+    float accel_bias;      /* constant accelerometer bias */
+};
+
+struct scenario {
+    const char *name;
+    float duration_s;
+    struct plant plant;
+    float aid_period_s;    /* 0 = no velocity aid */
+    float (*command)(float t);
+};
+
+static float cmd_cruise(float t)
+{
+    return (t > 5.0f && t < 65.0f) ? 0.8f : 0.0f;
+}
+
+static float cmd_manoeuvre(float t)
+{
+    return 0.7f * sinf(0.4f * t) + 0.3f * sinf(1.3f * t);
+}
+
+static float cmd_steps(float t)
+{
+    static const float levels[] = { 0.0f, 0.5f, 1.0f, -0.4f, 0.0f, -1.0f, 0.3f };
+    return levels[(int)(t / 12.0f) % 7];
+}
+
+static void run_scenario(const struct scenario *sc)
+{
+    const vel_est_params_t params = VEL_EST_DEFAULT_PARAMS;
+    const struct plant *pl = &sc->plant;
+    vel_est_t est;
+    vel_est_init(&est, &params);
+
+    struct err_acc e_kf = {0}, e_leaky = {0};
+    float v_true = 0.0f, thrust = 0.0f, leaky = 0.0f, next_aid = 0.0f;
+
+    for (float t = 0.0f; t < sc->duration_s; t += DT) {
+        float u = sc->command(t);
+
+        thrust += (pl->lag_s > 0.0f) ? (u - thrust) * DT / pl->lag_s : u - thrust;
+        float v_water = v_true - pl->current_mps;
+        float a_true = params.thrust_accel * pl->thrust_scale * thrust -
+                       params.drag_coeff * pl->drag_scale * v_water * fabsf(v_water);
+        v_true += a_true * DT;
+
+        float a_meas = a_true + pl->accel_bias + noise(0.05f);
+
+        leaky = leaky * SPEED_DECAY + a_meas * DT;
+        vel_est_step(&est, a_meas, u, DT);
+
+        if (sc->aid_period_s > 0.0f && t >= next_aid) {
+            vel_est_update_velocity(&est, v_true + noise(AID_SIGMA), AID_SIGMA);
+            next_aid = t + sc->aid_period_s;
+        }
+
+        err_add(&e_kf, vel_est_get(&est), v_true);
+        err_add(&e_leaky, leaky, v_true);
+    }
+
+    printf("%s (thrust x%.2f, drag x%.2f, lag %.2f s, current %+.2f m/s, "
+           "bias %.2f m/s^2, aid %s)\n", sc->name,
+           (double)pl->thrust_scale, (double)pl->drag_scale, (double)pl->lag_s,
+           (double)pl->current_mps, (double)pl->accel_bias,
+           sc->aid_period_s > 0.0f ? "on" : "off");
+    err_print("leaky", &e_leaky);
+    err_print("kalman", &e_kf);
+    printf("  bias estimate %.3f m/s^2\n", (double)vel_est_get_bias(&est));
+}
+
+static int parse_field(char **p, float *out)
+{
+    char *end;
+
+    while (**p == ' ' || **p == '\t') {
+        (*p)++;
+    }
+    if (**p == '\0' || **p == '\n' || **p == '\r') {
+        return -1;
+    }
+    if (**p == ',') {
+        (*p)++;
+        *out = NAN;
+        return 0;
+    }
+    *out = strtof(*p, &end);
+    if (end == *p) {
+        return -1;
+    }
+    *p = end;
+    if (**p == ',') {
+        (*p)++;
+    }
+    return 0;
+}
+
+static int replay_csv(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+
+    const vel_est_params_t params = VEL_EST_DEFAULT_PARAMS;
+    vel_est_t est;
+    vel_est_init(&est, &params);
+
+    struct err_acc e_kf = {0}, e_leaky = {0};
+    float leaky = 0.0f, t_prev = NAN;
+    char line[256];
+
+    while (fgets(line, sizeof(line), f)) {
+        float col[5] = { NAN, NAN, NAN, NAN, NAN };
+        char *p = line;
+        int n = 0;
+
+        if (line[0] == '#') {
+            continue;
+        }
+        while (n < 5 && parse_field(&p, &col[n]) == 0) {
+            n++;
+        }
+        if (n < 3 || isnan(col[0]) || isnan(col[1])) {
+            continue;   /* header or malformed row */
+        }
+
+        float dt = isnan(t_prev) ? DT : col[0] - t_prev;
+        t_prev = col[0];
+        float u = isnan(col[2]) ? 0.0f : col[2];
+
+        leaky = leaky * SPEED_DECAY + col[1] * dt;
+        vel_est_step(&est, col[1], u, dt);
+        if (!isnan(col[4])) {
+            vel_est_update_velocity(&est, col[4], AID_SIGMA);
+        }
+
+        if (!isnan(col[3])) {
+            err_add(&e_kf, vel_est_get(&est), col[3]);
+            err_add(&e_leaky, leaky, col[3]);
+        } else {
+            printf("%.3f,%.4f,%.4f\n", (double)col[0], (double)leaky,
+                   (double)vel_est_get(&est));
+        }
+    }
+    fclose(f);
+
+    if (e_kf.n) {
+        printf("%s: %ld samples with ground truth\n", path, e_kf.n);
+        err_print("leaky", &e_leaky);
+        err_print("kalman", &e_kf);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1) {
+        return replay_csv(argv[1]);
+    }
+
+    /* The first plant is the estimator's own model, as a reference; the
+     * rest are mismatched in thrust, drag, lag and current together */
+    static const struct scenario scenarios[] = {
+        { "model cruise",      80.0f, { 1.00f, 1.00f, 0.00f,  0.00f, 0.05f }, 0.0f, cmd_cruise },
+        { "heavy cruise",      80.0f, { 0.80f, 1.50f, 0.30f,  0.00f, 0.05f }, 0.0f, cmd_cruise },
+        { "cruise in current", 80.0f, { 1.10f, 0.70f, 0.30f, -0.25f, 0.05f }, 0.0f, cmd_cruise },
+        { "manoeuvre",        120.0f, { 1.20f, 0.60f, 0.30f,  0.20f, 0.05f }, 0.0f, cmd_manoeuvre },
+        { "steps",             84.0f, { 0.70f, 1.40f, 0.50f, -0.15f, 0.03f }, 0.0f, cmd_steps },
+        { "steps+aid",         84.0f, { 0.70f, 1.40f, 0.50f, -0.15f, 0.03f }, 0.2f, cmd_steps },
+    };
+
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        run_scenario(&scenarios[i]);
+    }
+    return 0;
+}